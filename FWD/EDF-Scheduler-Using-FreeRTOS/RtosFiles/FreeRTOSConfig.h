@@ -56,7 +56,24 @@
 #define configIDLE_SHOULD_YIELD		1
 #define configUSE_TIME_SLICING    1
 #define configUSE_EDF_SCHEDULER		1
+#define configEDF_MAX_READY_TASKS	16
+#define configEDF_UTILISATION_BOUND_PERCENT	100
 #define configSUPPORT_DYNAMIC_ALLOCATION 1
+
+/* Set to 1 to create the tasks and the idle task from the static buffers in
+main.c, a build that never allocates a TCB or stack from the heap can then set
+configSUPPORT_DYNAMIC_ALLOCATION to 0. */
+#define configSUPPORT_STATIC_ALLOCATION	0
+#define configUSE_MUTEXES			1
+
+/* Set to 1 to schedule with the Stack Resource Policy, resources are then locked
+with xTaskSrpLock() rather than a mutex.  main.c shares no resource between its
+tasks. */
+#define configUSE_EDF_SRP			0
+
+/* Set to 1 to let the tick apply the overrun policy of a job that runs past its
+deadline, see vTaskSetOverrunPolicy().  main.c leaves every task to run on. */
+#define configUSE_EDF_OVERRUN_POLICY	0
 #define configUSE_QUEUE_SETS  1
 
 #define configUSE_APPLICATION_TASK_TAG 1
@@ -78,84 +95,84 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
 
-extern int task_1_in_time , task_1_out_time , task_1_total_time;
-extern int task_2_in_time , task_2_out_time , task_2_total_time;
-extern int task_3_in_time , task_3_out_time , task_3_total_time;
-extern int task_4_in_time , task_4_out_time , task_4_total_time;
-extern int task_5_in_time , task_5_out_time , task_5_total_time;
-extern int task_6_in_time , task_6_out_time , task_6_total_time;
-extern int system_time ;
+/* Trace record of one task.  A traced task sets its application task tag to
+point at its record, so the switch hooks reach it straight from the TCB with
+no search, for any number of tasks.  xPin is driven high while the task runs. */
+typedef struct TASK_TRACE
+{
+	pinX_t xPin;
+	unsigned long ulInTime;
+	unsigned long ulOutTime;
+	unsigned long ulTotalTime;
+} TaskTrace_t;
+
 extern int cpu_load ;
 
+/* Binary scheduler event trace, see edf_trace.h.  The buffer is kept small as
+the LPC2129 only has 16 KB of RAM, the host simulator keeps a longer history.
+Timestamps come from T1TC, which main.c runs at the peripheral clock divided
+by T1PR + 1 = 1001. */
+#define configUSE_EDF_TRACE				1
+#ifdef POSIX_SIMULATOR
+	#define configEDF_TRACE_BUFFER_LENGTH	4096
+#else
+	#define configEDF_TRACE_BUFFER_LENGTH	64
+#endif
+#define configEDF_TRACE_TIMESTAMP_HZ	( configCPU_CLOCK_HZ / 1001UL )
+#include "edf_trace.h"
+
+/* The host simulator measures the time from the release of each job to its
+start from the same hooks, see vPortSimulationJobReleased() in
+portable/GCC/Posix/port.c. */
+#ifdef POSIX_SIMULATOR
+	#define traceSIMULATED_RELEASE( pxTCB )			vPortSimulationJobReleased( ( pxTCB )->uxTCBNumber, ( pxTCB )->pcTaskName, ( pxTCB )->xTaskReleaseTime, ( ( pxTCB ) == pxCurrentTCB ) ? pdTRUE : pdFALSE )
+	#define traceSIMULATED_SWITCHED_IN()			vPortSimulationTaskSwitchedIn( pxCurrentTCB->uxTCBNumber )
+	#define traceSIMULATED_DEADLINE_MISSED( pxTCB )	vPortSimulationDeadlineMissed( ( pxTCB )->uxTCBNumber )
+#else
+	#define traceSIMULATED_RELEASE( pxTCB )
+	#define traceSIMULATED_SWITCHED_IN()
+	#define traceSIMULATED_DEADLINE_MISSED( pxTCB )
+#endif
+
 /* Trace Hooks */
 #define traceTASK_SWITCHED_OUT() 	do\
-																		{\
-																			if((int)pxCurrentTCB->pxTaskTag == 1)	\
-																			{\
-																				GPIO_write(PORT_0, PIN2, PIN_IS_LOW);\
-																				task_1_out_time = T1TC;\
-																				task_1_total_time += task_1_out_time - task_1_in_time;\
-																			}else if((int)pxCurrentTCB->pxTaskTag == 2)	\
-																			{\
-																				GPIO_write(PORT_0, PIN3, PIN_IS_LOW);\
-																				task_2_out_time = T1TC;\
-																				task_2_total_time += task_2_out_time - task_2_in_time;\
-																			}else if((int)pxCurrentTCB->pxTaskTag == 3)	\
-																			{\
-																				GPIO_write(PORT_0, PIN4, PIN_IS_LOW);\
-																				task_3_out_time = T1TC;\
-																				task_3_total_time += task_3_out_time - task_3_in_time;\
-																			}else if((int)pxCurrentTCB->pxTaskTag == 4)	\
-																			{\
-																				GPIO_write(PORT_0, PIN5, PIN_IS_LOW);\
-																				task_4_out_time = T1TC;\
-																				task_4_total_time += task_4_out_time - task_4_in_time;\
-																			}else if((int)pxCurrentTCB->pxTaskTag == 5)	\
-																			{\
-																				GPIO_write(PORT_0, PIN6, PIN_IS_LOW);\
-																				task_5_out_time = T1TC;\
-																				task_5_total_time += task_5_out_time - task_5_in_time;\
-																			}else if((int)pxCurrentTCB->pxTaskTag == 6)	\
-																			{\
-																				GPIO_write(PORT_0, PIN7, PIN_IS_LOW);\
-																				task_6_out_time = T1TC;\
-																				task_6_total_time += task_6_out_time - task_6_in_time;\
-																			}\
-																			system_time = T1TC;\
-																			cpu_load = ((task_2_total_time + task_1_total_time + task_3_total_time + task_4_total_time + task_5_total_time + task_6_total_time) / (float)system_time)*100;\
-																		}while(0)
-
-//																			GPIO_write(PORT_0, PIN1, PIN_IS_LOW); /*Idle pin*/\
-
-#define traceTASK_SWITCHED_IN() do\
-																		{\
-																			if((int)pxCurrentTCB->pxTaskTag == 1)	\
-																			{\
-																				GPIO_write(PORT_0, PIN2, PIN_IS_HIGH);\
-																				task_1_in_time = T1TC;\
-																			}else if((int)pxCurrentTCB->pxTaskTag == 2)	\
-																			{\
-																				GPIO_write(PORT_0, PIN3, PIN_IS_HIGH);\
-																				task_2_in_time = T1TC;\
-																			}else if((int)pxCurrentTCB->pxTaskTag == 3)	\
-																			{\
-																				GPIO_write(PORT_0, PIN4, PIN_IS_HIGH);\
-																				task_3_in_time = T1TC;\
-																			}else if((int)pxCurrentTCB->pxTaskTag == 4)	\
-																			{\
-																				GPIO_write(PORT_0, PIN5, PIN_IS_HIGH);\
-																				task_4_in_time = T1TC;\
-																			}else if((int)pxCurrentTCB->pxTaskTag == 5)	\
-																			{\
-																				GPIO_write(PORT_0, PIN6, PIN_IS_HIGH);\
-																				task_5_in_time = T1TC;\
-																			}else if((int)pxCurrentTCB->pxTaskTag == 6)	\
-																			{\
-																				GPIO_write(PORT_0, PIN7, PIN_IS_HIGH);\
-																				task_6_in_time = T1TC;\
-																			}\
-																		}while(0)
-//																					GPIO_write(PORT_0, PIN1, PIN_IS_LOW); /*Idle pin*/ \
+									{\
+										TaskTrace_t *pxTrace = ( TaskTrace_t * ) pxCurrentTCB->pxTaskTag;\
+										if( pxTrace != NULL )\
+										{\
+											GPIO_write(PORT_0, pxTrace->xPin, PIN_IS_LOW);\
+											pxTrace->ulOutTime = T1TC;\
+											pxTrace->ulTotalTime += pxTrace->ulOutTime - pxTrace->ulInTime;\
+										}\
+										edftraceRECORD( edftraceEVENT_SWITCHED_OUT, pxCurrentTCB->uxTCBNumber, 0U );\
+									}while(0)
+
+#define traceTASK_SWITCHED_IN() 	do\
+									{\
+										TaskTrace_t *pxTrace = ( TaskTrace_t * ) pxCurrentTCB->pxTaskTag;\
+										if( pxTrace != NULL )\
+										{\
+											GPIO_write(PORT_0, pxTrace->xPin, PIN_IS_HIGH);\
+											pxTrace->ulInTime = T1TC;\
+										}\
+										edftraceRECORD( edftraceEVENT_SWITCHED_IN, pxCurrentTCB->uxTCBNumber, 0U );\
+										traceSIMULATED_SWITCHED_IN();\
+									}while(0)
+
+/* Record the release of a job and its absolute deadline, the deadline of the
+job itself rather than one inherited through a mutex */
+#define tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB ) 	do\
+									{\
+										edftraceRECORD( edftraceEVENT_RELEASE, ( pxTCB )->uxTCBNumber, edftraceCLAMP( xTickCount - ( pxTCB )->xTaskReleaseTime ) );\
+										edftraceRECORD( edftraceEVENT_DEADLINE, ( pxTCB )->uxTCBNumber, edftraceCLAMP( taskEDF_ABSOLUTE_DEADLINE( pxTCB ) - xTickCount ) );\
+										traceSIMULATED_RELEASE( pxTCB );\
+									}while(0)
+
+#define traceTASK_DEADLINE_MISSED( pxTCB, xLateness ) 	do\
+									{\
+										edftraceRECORD( edftraceEVENT_MISS, ( pxTCB )->uxTCBNumber, edftraceCLAMP( xLateness ) );\
+										traceSIMULATED_DEADLINE_MISSED( pxTCB );\
+									}while(0)
 
 /* Configure rin-time stats */
 
@@ -165,4 +182,51 @@ extern int cpu_load ;
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #define portGET_RUN_TIME_COUNTER_VALUE()  (T1TC)
 
+/* Set to 1 to charge each job for its run time and move it to the background
+once it has used its WCET, so an overrunning load task cannot starve the others.
+T1TC counts configCPU_CLOCK_HZ / 1001 per second, rounded up to whole counts per
+tick so rounding never cuts a budget short. */
+#define configUSE_EDF_BUDGETS			1
+#define configEDF_RUN_TIME_COUNTS_PER_TICK	( ( ( configCPU_CLOCK_HZ / 1001UL ) + configTICK_RATE_HZ - 1UL ) / configTICK_RATE_HZ )
+
+/* Set to 1 to serve aperiodic jobs from Constant Bandwidth Servers, see
+xTaskCbsCreate().  main.c does not use them. */
+#define configUSE_EDF_CBS				0
+
+/* Set to 1 to create sporadic tasks, released by an interrupt rather than a
+timer.  main.c needs them for the button monitors, see xTaskSporadicCreate(). */
+#define configUSE_EDF_SPORADIC			1
+
+/* Set to 1 to run periodic jobs to completion on the stack of a single job
+server task, rather than give each a task and a stack.  main.c runs the
+transmitter that way, see xTaskJobCreate(). */
+#define configUSE_EDF_JOBS				1
+
+/* Set to 1 to keep blocked tasks in a timing wheel of configTIMING_WHEEL_LEVELS
+levels of 2 ^ configTIMING_WHEEL_BITS lists, rather than the sorted delayed lists.
+It pays off with hundreds of periodic tasks, and costs a list per slot of RAM, so
+it is left off for the six tasks of main.c. */
+#define configUSE_TIMING_WHEEL			0
+#define configTIMING_WHEEL_BITS			4
+#define configTIMING_WHEEL_LEVELS		3
+
+/* Host simulator build, see portable/GCC/Posix/port.c.  The idle hook is what
+moves virtual time on while nothing else is ready, so it must be enabled. */
+#ifdef POSIX_SIMULATOR
+	#include <assert.h>
+
+	#undef configUSE_IDLE_HOOK
+	#define configUSE_IDLE_HOOK			1
+	#define configASSERT( x )			assert( x )
+
+	/* The simulator port can suppress the tick while the idle task runs. */
+	#define configUSE_TICKLESS_IDLE		1
+
+	/* A scenario of Simulator/run_scenarios.sh changes the options above from
+	a header of its own, named on the command line. */
+	#ifdef configSCENARIO_CONFIG
+		#include configSCENARIO_CONFIG
+	#endif
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,124 @@
+#!/bin/sh
+#
+# Regression scenarios for the EDF kernel, run on the host simulator of
+# portable/GCC/Posix/port.c.
+#
+#   Simulator/run_scenarios.sh <kernel> [scenario ...]
+#
+# <kernel> is the FreeRTOS/Source directory of FreeRTOS V10.3.1, for include/,
+# list.c, queue.c, event_groups.c and portable/MemMang/heap_3.c.  With no
+# scenario named every scenario_*.c in this directory is run, then main.
+#
+# A scenario is built from its .c file in place of main.c.  If a header of the
+# same name is next to it, FreeRTOSConfig.h includes it last so the scenario can
+# change kernel options.  A scenario ends the run itself with a PASS or FAIL
+# record in its trace.  A run that ends without a PASS record fails.  If a
+# file of the same name ending in .expected is next to it, the binary event
+# trace of the run is decoded with Tools/edf_trace_decode.c and the event, task
+# and data of every record, oldest first, must match it.
+#
+# main is the jitter test of the six tasks of main.c itself.  It runs for
+# 10000 hyperperiods of 100 ticks and prints the release to start time of the
+# jobs of every task, see the end of run summary in port.c.  It fails if any
+# deadline was missed.
+#
+# Set CC or CFLAGS to change the compiler, and KEEP to a directory to keep the
+# binaries and traces there.
+
+KERNEL="$1"
+if [ -z "$KERNEL" ] || [ ! -f "$KERNEL/include/list.h" ]; then
+	echo "usage: $0 <FreeRTOS/Source> [scenario ...]" >&2
+	exit 2
+fi
+shift
+
+SIMULATOR=$(cd "$(dirname "$0")" && pwd)
+RTOS=$(dirname "$SIMULATOR")
+PORT="$RTOS/portable/GCC/Posix"
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:-"-O2 -g -Wall"}
+OUT=${KEEP:-$(mktemp -d)}
+mkdir -p "$OUT"
+
+if [ $# -eq 0 ]; then
+	set -- $(cd "$SIMULATOR" && ls scenario_*.c | sed 's/\.c$//') main
+fi
+
+# Hyperperiod of the main.c task set in ticks, and hyperperiods to run.
+HYPERPERIOD=100
+HYPERPERIODS=10000
+
+# Records of a decoded event trace, without their timestamps.
+decode_records() {
+	"$OUT/edf_trace_decode" -l "$1" | sed -n '/^ *time us/,/^$/p' | awk 'NF == 4 && $1 != "time" { print $2, $3, $4 }'
+}
+
+FAILED=0
+for SCENARIO in "$@"; do
+	SCENARIO=$(basename "$SCENARIO" .c)
+	SOURCE="$SIMULATOR/$SCENARIO.c"
+	# The run length is only a limit, each scenario ends its own run.
+	TICKS=${EDF_SIM_TICKS:-2000000}
+	if [ "$SCENARIO" = main ]; then
+		SOURCE="$RTOS/main.c"
+		TICKS=$((HYPERPERIOD * HYPERPERIODS))
+	fi
+
+	CONFIG=
+	if [ -f "$SIMULATOR/$SCENARIO.h" ]; then
+		CONFIG="-DconfigSCENARIO_CONFIG=\"$SCENARIO.h\""
+	fi
+
+	if ! $CC -std=gnu99 $CFLAGS -DPOSIX_SIMULATOR $CONFIG \
+			-I"$SIMULATOR" -I"$PORT" -I"$RTOS" -I"$KERNEL/include" \
+			"$SOURCE" "$RTOS/tasks.c" "$RTOS/edf_trace.c" \
+			"$PORT/port.c" "$PORT/peripherals.c" \
+			"$KERNEL/list.c" "$KERNEL/queue.c" "$KERNEL/event_groups.c" \
+			"$KERNEL/portable/MemMang/heap_3.c" \
+			-o "$OUT/$SCENARIO" -lpthread; then
+		echo "FAIL $SCENARIO: does not build"
+		FAILED=1
+		continue
+	fi
+
+	EDF_SIM_TICKS=$TICKS EDF_SIM_TRACE="$OUT/$SCENARIO.trace" EDF_SIM_EVENTS="$OUT/$SCENARIO.events" "$OUT/$SCENARIO"
+
+	# Every record of the trace starts with the virtual time.
+	if [ "$SCENARIO" = main ]; then
+		grep -E '^ *[0-9]+ JITTER' "$OUT/$SCENARIO.trace" | sed 's/^ *[0-9]* //'
+		if grep -qE '^ *[0-9]+ JITTER .* missed [1-9]' "$OUT/$SCENARIO.trace" || ! grep -qE '^ *[0-9]+ JITTER' "$OUT/$SCENARIO.trace"; then
+			echo "FAIL $SCENARIO"
+			FAILED=1
+		else
+			echo "PASS $SCENARIO"
+		fi
+		continue
+	fi
+
+	grep -E '^ *[0-9]+ (FAIL|RESULT)' "$OUT/$SCENARIO.trace" | sed 's/^ *[0-9]* //'
+
+	EVENTS_MATCH=1
+	if [ -f "$SIMULATOR/$SCENARIO.expected" ]; then
+		if [ ! -x "$OUT/edf_trace_decode" ]; then
+			$CC $CFLAGS -o "$OUT/edf_trace_decode" "$RTOS/Tools/edf_trace_decode.c"
+		fi
+		decode_records "$OUT/$SCENARIO.events" > "$OUT/$SCENARIO.records"
+		if ! diff -u "$SIMULATOR/$SCENARIO.expected" "$OUT/$SCENARIO.records"; then
+			echo "event trace differs from $SCENARIO.expected"
+			EVENTS_MATCH=0
+		fi
+	fi
+
+	if [ $EVENTS_MATCH -eq 0 ] || grep -qE '^ *[0-9]+ FAIL' "$OUT/$SCENARIO.trace" || ! grep -qE '^ *[0-9]+ PASS' "$OUT/$SCENARIO.trace"; then
+		echo "FAIL $SCENARIO"
+		FAILED=1
+	else
+		echo "PASS $SCENARIO"
+	fi
+done
+
+if [ -z "$KEEP" ]; then
+	rm -rf "$OUT"
+fi
+
+exit $FAILED
@@ -0,0 +1,197 @@
+/*
+ * Admission control scenario, see xTaskPeriodicCreateWithDeadline() and
+ * ulTaskGetTotalUtilisation().
+ *
+ * A controller task with no WCET of its own creates and deletes periodic tasks
+ * while the ones already admitted run.  The periods are powers of two, so the
+ * utilisations add up exactly in units of 1 / 65536:
+ *   A and B take 0.375 and 0.5, and D the last 0.125, which is admitted as the
+ *   bound of configEDF_UTILISATION_BOUND_PERCENT is 100.
+ *   C would take the total past 1.0, and is refused until D is deleted.
+ *   E and F have deadlines shorter than their periods.  Both fit by
+ *   utilisation, but F is refused by the processor demand test as the two
+ *   would need 3 ticks in the first 2.
+ * Every refusal must return errTASK_SET_NOT_SCHEDULABLE and leave the total
+ * utilisation as it was.  The scenario passes if every creation returned what
+ * was expected, the total was right after each step, and no admitted task
+ * missed a deadline.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Timing of the tasks, in ticks. */
+#define adA_PERIOD				( ( TickType_t ) 8 )
+#define adA_WCET				( ( TickType_t ) 3 )
+#define adB_PERIOD				( ( TickType_t ) 16 )
+#define adB_WCET				( ( TickType_t ) 8 )
+#define adC_PERIOD				( ( TickType_t ) 8 )
+#define adC_WCET				( ( TickType_t ) 1 )
+#define adD_PERIOD				( ( TickType_t ) 64 )
+#define adD_WCET				( ( TickType_t ) 8 )
+#define adEF_PERIOD				( ( TickType_t ) 64 )
+#define adEF_DEADLINE			( ( TickType_t ) 2 )
+#define adE_WCET				( ( TickType_t ) 2 )
+#define adF_WCET				( ( TickType_t ) 1 )
+#define adCONTROLLER_PERIOD		( ( TickType_t ) 1000 )
+
+/* Utilisations in units of 1 / 65536. */
+#define adUTILISATION( wcet, period )	( ( uint32_t ) ( ( 0x10000UL * ( uint32_t ) ( wcet ) ) / ( uint32_t ) ( period ) ) )
+
+/* Execution time of every job in microseconds of virtual time, within the WCET
+of each task. */
+#define adJOB_US				( 800UL )
+
+#define adSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvControllerTask( void *pvParameters );
+static void prvLoadTask( void *pvParameters );
+static void prvCheck( const char *pcStep, BaseType_t xReturn, BaseType_t xExpected, uint32_t ulExpectedUtilisation );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xTaskA = NULL, xTaskB = NULL, xTaskC = NULL, xTaskD = NULL, xTaskE = NULL;
+static BaseType_t xAllChecked = pdTRUE;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+TaskHandle_t xController = NULL;
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvControllerTask, "Control", adSTACK_SIZE, NULL, 0, &xController, adCONTROLLER_PERIOD, adCONTROLLER_PERIOD, 0 );
+	configASSERT( xController != NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControllerTask( void *pvParameters )
+{
+TaskHandle_t xRefused = NULL;
+uint32_t ulExpected = 0UL;
+BaseType_t xReturn;
+
+	( void ) pvParameters;
+
+	prvCheck( "no task", pdPASS, pdPASS, ulExpected );
+
+	xReturn = xTaskPeriodicCreateWithDeadline( prvLoadTask, "A", adSTACK_SIZE, NULL, 0, &xTaskA, adA_PERIOD, adA_PERIOD, adA_WCET );
+	ulExpected += adUTILISATION( adA_WCET, adA_PERIOD );
+	prvCheck( "A admitted", xReturn, pdPASS, ulExpected );
+
+	xReturn = xTaskPeriodicCreateWithDeadline( prvLoadTask, "B", adSTACK_SIZE, NULL, 0, &xTaskB, adB_PERIOD, adB_PERIOD, adB_WCET );
+	ulExpected += adUTILISATION( adB_WCET, adB_PERIOD );
+	prvCheck( "B admitted", xReturn, pdPASS, ulExpected );
+
+	xReturn = xTaskPeriodicCreateWithDeadline( prvLoadTask, "D", adSTACK_SIZE, NULL, 0, &xTaskD, adD_PERIOD, adD_PERIOD, adD_WCET );
+	ulExpected += adUTILISATION( adD_WCET, adD_PERIOD );
+	prvCheck( "D admitted to the bound", xReturn, pdPASS, ulExpected );
+
+	xReturn = xTaskPeriodicCreateWithDeadline( prvLoadTask, "C", adSTACK_SIZE, NULL, 0, &xRefused, adC_PERIOD, adC_PERIOD, adC_WCET );
+	prvCheck( "C refused past the bound", xReturn, errTASK_SET_NOT_SCHEDULABLE, ulExpected );
+
+	/* Let the full set run for a while before D makes room for C. */
+	vTaskDelay( adD_PERIOD );
+
+	vTaskDelete( xTaskD );
+	xTaskD = NULL;
+	ulExpected -= adUTILISATION( adD_WCET, adD_PERIOD );
+	prvCheck( "D deleted", pdPASS, pdPASS, ulExpected );
+
+	xReturn = xTaskPeriodicCreateWithDeadline( prvLoadTask, "C", adSTACK_SIZE, NULL, 0, &xTaskC, adC_PERIOD, adC_PERIOD, adC_WCET );
+	ulExpected += adUTILISATION( adC_WCET, adC_PERIOD );
+	prvCheck( "C admitted in the room of D", xReturn, pdPASS, ulExpected );
+
+	vTaskDelete( xTaskC );
+	xTaskC = NULL;
+	ulExpected -= adUTILISATION( adC_WCET, adC_PERIOD );
+
+	xReturn = xTaskPeriodicCreateWithDeadline( prvLoadTask, "E", adSTACK_SIZE, NULL, 0, &xTaskE, adEF_PERIOD, adEF_DEADLINE, adE_WCET );
+	ulExpected += adUTILISATION( adE_WCET, adEF_PERIOD );
+	prvCheck( "E admitted by demand", xReturn, pdPASS, ulExpected );
+
+	xReturn = xTaskPeriodicCreateWithDeadline( prvLoadTask, "F", adSTACK_SIZE, NULL, 0, &xRefused, adEF_PERIOD, adEF_DEADLINE, adF_WCET );
+	prvCheck( "F refused by demand", xReturn, errTASK_SET_NOT_SCHEDULABLE, ulExpected );
+
+	/* Run the admitted set for a period of the controller. */
+	( void ) xTaskWaitForNextPeriod();
+
+	prvEndScenario();
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoadTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vPortSimulateExecution( adJOB_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheck( const char *pcStep, BaseType_t xReturn, BaseType_t xExpected, uint32_t ulExpectedUtilisation )
+{
+const uint32_t ulUtilisation = ulTaskGetTotalUtilisation();
+
+	vPortSimulationTrace( "RESULT %s, returned %ld, utilisation %lu / 65536\n", pcStep, ( long ) xReturn, ( unsigned long ) ulUtilisation );
+
+	if( ( xReturn != xExpected ) || ( ulUtilisation != ulExpectedUtilisation ) )
+	{
+		vPortSimulationTrace( "FAIL %s, expected %ld and %lu / 65536\n", pcStep, ( long ) xExpected, ( unsigned long ) ulExpectedUtilisation );
+		xAllChecked = pdFALSE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+TaskHandle_t xTasks[ 3 ];
+UBaseType_t uxMisses, uxTotalMisses = 0U, ux;
+
+	xTasks[ 0 ] = xTaskA;
+	xTasks[ 1 ] = xTaskB;
+	xTasks[ 2 ] = xTaskE;
+
+	for( ux = 0U; ux < 3U; ux++ )
+	{
+		vTaskGetDeadlineMissInfo( xTasks[ ux ], &uxMisses, NULL, NULL );
+		uxTotalMisses += uxMisses;
+	}
+
+	vPortSimulationTrace( "RESULT %lu deadlines missed\n", ( unsigned long ) uxTotalMisses );
+
+	if( xAllChecked == pdFALSE )
+	{
+		vPortSimulationTrace( "FAIL admission did not match the expected utilisation\n" );
+	}
+	else if( uxTotalMisses != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
@@ -0,0 +1,149 @@
+/*
+ * Context switch benchmark for releases that do not preempt, see
+ * taskEDF_PREEMPTS_CURRENT() in xTaskIncrementTick().
+ *
+ * A long task runs for most of each of its periods with the earliest deadline.
+ * Four short tasks with later deadlines and periods prime to it are released
+ * while it runs.  Before the check every one of those releases ran the
+ * scheduler, which on the LPC2000 port saves and restores a full task context
+ * only to select the long task again.  Now the tick counts them in
+ * uxTaskGetAvoidedContextSwitches() instead.  The scheduler runs per second
+ * before the check are therefore the runs now plus the avoided runs.
+ *
+ * The scenario reports the scheduler runs per second before and after, and the
+ * context switches between tasks, which the check does not change.  It passes
+ * if releases were avoided and no deadline was missed.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Timing of the tasks, in ticks.  The periods of the short tasks are prime
+to that of the long task, so their releases fall at every point of its job. */
+#define avLONG_PERIOD			( ( TickType_t ) 10 )
+#define avLONG_WCET				( ( TickType_t ) 7 )
+#define avSHORT_TASKS			( 4U )
+#define avSHORT_WCET			( ( TickType_t ) 1 )
+
+/* Execution times in microseconds of virtual time. */
+#define avLONG_US				( 6500UL )
+#define avSHORT_US				( 200UL )
+
+/* Jobs of the long task before the result is checked, 10000 ticks. */
+#define avLONG_JOBS				( 1000UL )
+
+#define avSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvLongTask( void *pvParameters );
+static void prvShortTask( void *pvParameters );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+static const TickType_t xShortPeriods[ avSHORT_TASKS ] = { 11, 13, 17, 19 };
+
+static TaskHandle_t xLong = NULL;
+static TaskHandle_t xShort[ avSHORT_TASKS ];
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvLongTask, "Long", avSTACK_SIZE, NULL, 0, &xLong, avLONG_PERIOD, avLONG_PERIOD, avLONG_WCET );
+	configASSERT( xLong != NULL );
+
+	for( ux = 0U; ux < avSHORT_TASKS; ux++ )
+	{
+		xShort[ ux ] = NULL;
+		( void ) xTaskPeriodicCreateWithDeadline( prvShortTask, "Short", avSTACK_SIZE, NULL, 0, &( xShort[ ux ] ), xShortPeriods[ ux ], xShortPeriods[ ux ], avSHORT_WCET );
+		configASSERT( xShort[ ux ] != NULL );
+	}
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLongTask( void *pvParameters )
+{
+uint32_t ulJobs;
+
+	( void ) pvParameters;
+
+	for( ulJobs = 0UL; ulJobs < avLONG_JOBS; ulJobs++ )
+	{
+		vPortSimulateExecution( avLONG_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+
+	prvEndScenario();
+}
+/*-----------------------------------------------------------*/
+
+static void prvShortTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vPortSimulateExecution( avSHORT_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+const uint64_t ullSeconds = ( ullPortSimulatedTime() >= 1000000ULL ) ? ( ullPortSimulatedTime() / 1000000ULL ) : 1ULL;
+UBaseType_t uxMisses, uxTotalMisses = 0U, ux, uxAvoided;
+uint32_t ulRuns, ulSwitches;
+
+	vPortSimulatedSchedulerRuns( &ulRuns, &ulSwitches );
+	uxAvoided = uxTaskGetAvoidedContextSwitches();
+
+	vTaskGetDeadlineMissInfo( xLong, &uxTotalMisses, NULL, NULL );
+	for( ux = 0U; ux < avSHORT_TASKS; ux++ )
+	{
+		vTaskGetDeadlineMissInfo( xShort[ ux ], &uxMisses, NULL, NULL );
+		uxTotalMisses += uxMisses;
+	}
+
+	/* On the target every scheduler run saves and restores a task context. */
+	vPortSimulationTrace( "RESULT before %lu runs/s, after %lu runs/s, %lu switches/s between tasks, %lu avoided\n",
+						  ( unsigned long ) ( ( ( uint64_t ) ulRuns + ( uint64_t ) uxAvoided ) / ullSeconds ),
+						  ( unsigned long ) ( ( uint64_t ) ulRuns / ullSeconds ),
+						  ( unsigned long ) ( ( uint64_t ) ulSwitches / ullSeconds ),
+						  ( unsigned long ) uxAvoided );
+	vPortSimulationTrace( "RESULT %lu deadlines missed\n", ( unsigned long ) uxTotalMisses );
+
+	if( uxAvoided == 0U )
+	{
+		vPortSimulationTrace( "FAIL no release was avoided\n" );
+	}
+	else if( uxTotalMisses != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
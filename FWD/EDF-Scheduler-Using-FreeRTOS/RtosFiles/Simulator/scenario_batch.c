@@ -0,0 +1,268 @@
+/*
+ * Batched ready scenario for xTaskResumeAll(), see prvReadyHeapAppend() and
+ * prvReadyHeapRebuild().
+ *
+ * baWORKERS workers each wait for a task notification.  In each round a
+ * controller suspends the scheduler for longer than a tick, as
+ * vTaskGetRunTimeStats() does, and the tick interrupt notifies every worker in
+ * an order that changes from round to round.  The workers are all left in the
+ * pending ready list and xTaskResumeAll() readies them as one batch.  Every
+ * task has the same release and the relative deadlines all differ, so the
+ * workers must then start in the order of their deadlines.  The controller's
+ * deadline falls in the middle of theirs, so the single switch decision of the
+ * batch has to let the earlier half preempt it and hold the later half back.
+ *
+ * scenario_batch_list.c builds the same scenario with configUSE_EDF_READY_HEAP
+ * set to 0, where the batch is inserted into the sorted list.
+ *
+ * The scenario passes if in every round each worker ran once, the workers and
+ * the controller ran in deadline order, and no deadline was missed.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define baWORKERS				( 64U )
+
+/* Timing of the tasks, in ticks.  Worker n has a deadline of
+baFIRST_DEADLINE + n * baDEADLINE_STEP, and the controller's deadline is
+between two of those.  The controller suspends the scheduler baGIVE_DELAY ticks
+into each period, by when every worker waits for its notification. */
+#define baPERIOD				( ( TickType_t ) 1000 )
+#define baFIRST_DEADLINE		( ( TickType_t ) 105 )
+#define baDEADLINE_STEP			( ( TickType_t ) 10 )
+#define baCONTROLLER_DEADLINE	( ( TickType_t ) 400 )
+#define baGIVE_DELAY			( ( TickType_t ) 50 )
+#define baROUNDS				( 10U )
+
+/* The order the workers are notified in is n * baSTRIDE + round, modulo
+baWORKERS, which visits every worker as the stride is odd. */
+#define baSTRIDE				( 37U )
+
+/* Execution times in microseconds of virtual time.  The controller keeps the
+scheduler suspended over at least one tick. */
+#define baJOB_US				( 20UL )
+#define baSUSPENDED_US			( 1500UL )
+
+/* Recorded in place of a worker when the controller runs. */
+#define baCONTROLLER			( baWORKERS )
+
+#define baSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvControllerTask( void *pvParameters );
+static void prvWorkerTask( void *pvParameters );
+static TickType_t prvDeadline( UBaseType_t uxRecord );
+static BaseType_t prvCheckRound( void );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xWorkers[ baWORKERS ];
+static TaskHandle_t xController = NULL;
+
+/* The workers and the controller in the order they ran in this round. */
+static UBaseType_t uxRecords[ baWORKERS + 1U ];
+static UBaseType_t uxRecorded = 0U;
+
+/* Set by the controller for the tick interrupt to notify the workers, and the
+round that gives the order.  xSuspended is set while the controller has the
+scheduler suspended. */
+static volatile BaseType_t xNotifyPending = pdFALSE, xSuspended = pdFALSE;
+static volatile UBaseType_t uxNotifyRound = 0U;
+
+static uint32_t ulBadRounds = 0UL, ulNotifiedWhileRunning = 0UL;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0U; ux < baWORKERS; ux++ )
+	{
+		xWorkers[ ux ] = NULL;
+		( void ) xTaskPeriodicCreateWithDeadline( prvWorkerTask, "Worker", baSTACK_SIZE, ( void * ) ux, 0, &( xWorkers[ ux ] ), baPERIOD, prvDeadline( ux ), 0 );
+		configASSERT( xWorkers[ ux ] != NULL );
+	}
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvControllerTask, "Control", baSTACK_SIZE, NULL, 0, &xController, baPERIOD, baCONTROLLER_DEADLINE, 0 );
+	configASSERT( xController != NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControllerTask( void *pvParameters )
+{
+UBaseType_t uxRound;
+
+	( void ) pvParameters;
+
+	for( uxRound = 0U; uxRound < baROUNDS; uxRound++ )
+	{
+		vTaskDelay( baGIVE_DELAY );
+
+		/* The workers of the last round have all run by now. */
+		if( ( uxRound > 0U ) && ( prvCheckRound() == pdFAIL ) )
+		{
+			ulBadRounds++;
+		}
+
+		uxRecorded = 0U;
+
+		uxNotifyRound = uxRound;
+		xNotifyPending = pdTRUE;
+
+		vTaskSuspendAll();
+		{
+			xSuspended = pdTRUE;
+			vPortSimulateExecution( baSUSPENDED_US );
+			xSuspended = pdFALSE;
+		}
+		( void ) xTaskResumeAll();
+
+		uxRecords[ uxRecorded ] = baCONTROLLER;
+		uxRecorded++;
+
+		( void ) xTaskWaitForNextPeriod();
+	}
+
+	vTaskDelay( baGIVE_DELAY );
+
+	if( prvCheckRound() == pdFAIL )
+	{
+		ulBadRounds++;
+	}
+
+	prvEndScenario();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+const UBaseType_t uxWorker = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		uxRecords[ uxRecorded ] = uxWorker;
+		uxRecorded++;
+
+		vPortSimulateExecution( baJOB_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvDeadline( UBaseType_t uxRecord )
+{
+TickType_t xDeadline;
+
+	if( uxRecord == baCONTROLLER )
+	{
+		xDeadline = baCONTROLLER_DEADLINE;
+	}
+	else
+	{
+		xDeadline = baFIRST_DEADLINE + ( ( TickType_t ) uxRecord * baDEADLINE_STEP );
+	}
+
+	return xDeadline;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckRound( void )
+{
+BaseType_t xReturn = pdPASS;
+UBaseType_t ux;
+
+	if( uxRecorded != ( baWORKERS + 1U ) )
+	{
+		vPortSimulationTrace( "ROUND %lu of %lu tasks ran\n", ( unsigned long ) uxRecorded, ( unsigned long ) ( baWORKERS + 1U ) );
+		xReturn = pdFAIL;
+	}
+	else
+	{
+		for( ux = 1U; ux < uxRecorded; ux++ )
+		{
+			if( prvDeadline( uxRecords[ ux ] ) < prvDeadline( uxRecords[ ux - 1U ] ) )
+			{
+				vPortSimulationTrace( "ROUND deadline %lu ran after deadline %lu\n",
+									  ( unsigned long ) prvDeadline( uxRecords[ ux ] ), ( unsigned long ) prvDeadline( uxRecords[ ux - 1U ] ) );
+				xReturn = pdFAIL;
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+UBaseType_t uxMisses, uxTotalMisses = 0U, ux;
+
+	for( ux = 0U; ux < baWORKERS; ux++ )
+	{
+		vTaskGetDeadlineMissInfo( xWorkers[ ux ], &uxMisses, NULL, NULL );
+		uxTotalMisses += uxMisses;
+	}
+
+	vTaskGetDeadlineMissInfo( xController, &uxMisses, NULL, NULL );
+	uxTotalMisses += uxMisses;
+
+	vPortSimulationTrace( "RESULT %lu rounds of %lu workers readied in one batch, %lu out of deadline order, %lu deadlines missed\n",
+						  ( unsigned long ) baROUNDS, ( unsigned long ) baWORKERS,
+						  ( unsigned long ) ulBadRounds, ( unsigned long ) uxTotalMisses );
+
+	if( ulNotifiedWhileRunning != 0UL )
+	{
+		vPortSimulationTrace( "FAIL the workers were notified with the scheduler running\n" );
+	}
+	else if( ulBadRounds != 0UL )
+	{
+		vPortSimulationTrace( "FAIL the batch was not run in deadline order\n" );
+	}
+	else if( uxTotalMisses != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+UBaseType_t ux;
+
+	if( xNotifyPending != pdFALSE )
+	{
+		xNotifyPending = pdFALSE;
+
+		if( xSuspended == pdFALSE )
+		{
+			ulNotifiedWhileRunning++;
+		}
+
+		for( ux = 0U; ux < baWORKERS; ux++ )
+		{
+			vTaskNotifyGiveFromISR( xWorkers[ ( ( ux * baSTRIDE ) + uxNotifyRound ) % baWORKERS ], NULL );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
@@ -0,0 +1,4 @@
+/* Room in the ready heap for the workers and the controller of
+scenario_batch.c. */
+#undef configEDF_MAX_READY_TASKS
+#define configEDF_MAX_READY_TASKS	( 72 )
@@ -0,0 +1,7 @@
+/*
+ * The batched ready scenario of scenario_batch.c, built with the ready tasks
+ * kept in the list sorted by deadline rather than in the ready heap, see
+ * scenario_batch_list.h.
+ */
+
+#include "scenario_batch.c"
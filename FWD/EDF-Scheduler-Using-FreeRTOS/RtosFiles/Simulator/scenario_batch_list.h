@@ -0,0 +1,2 @@
+/* Keep the ready tasks in the list sorted by deadline. */
+#define configUSE_EDF_READY_HEAP	0
@@ -0,0 +1,188 @@
+/*
+ * Blocking time scenario for deadline inheritance through a mutex, see
+ * xTaskPriorityInherit().
+ *
+ * A short deadline task and a long job share a resource guarded by a mutex.
+ * The long job holds it for the last blkHOLD_US of each job, and a task with a
+ * deadline between the two is released while it does.  Without inheritance the
+ * short deadline task waits for that task as well as for the holder.  With
+ * inheritance the holder runs with the deadline of the waiter, so the wait is
+ * at most the rest of one critical section.
+ *
+ * The short deadline task measures every wait in virtual time.  The scenario
+ * passes if no wait was longer than the critical section and no deadline was
+ * missed.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Timing of the three tasks, in ticks.  The waiter has the shortest deadline,
+the holder the longest, and the middle task is released at every tick the
+holder can be in its critical section. */
+#define blkWAITER_PERIOD		( ( TickType_t ) 20 )
+#define blkWAITER_DEADLINE		( ( TickType_t ) 5 )
+#define blkWAITER_WCET			( ( TickType_t ) 1 )
+#define blkMIDDLE_PERIOD		( ( TickType_t ) 10 )
+#define blkMIDDLE_WCET			( ( TickType_t ) 6 )
+#define blkHOLDER_PERIOD		( ( TickType_t ) 100 )
+#define blkHOLDER_WCET			( ( TickType_t ) 13 )
+
+/* Execution times in microseconds of virtual time. */
+#define blkWAITER_US			( 100UL )
+#define blkMIDDLE_US			( 5000UL )
+#define blkHOLDER_US			( 9000UL )
+#define blkHOLD_US				( 3000UL )
+
+/* Jobs of the waiter before the result is checked, 20000 ticks. */
+#define blkWAITER_JOBS			( 1000UL )
+
+#define blkSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvWaiterTask( void *pvParameters );
+static void prvMiddleTask( void *pvParameters );
+static void prvHolderTask( void *pvParameters );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+static SemaphoreHandle_t xResource = NULL;
+static TaskHandle_t xWaiter = NULL, xMiddle = NULL, xHolder = NULL;
+
+/* Longest time the waiter waited for the mutex, in microseconds. */
+static uint64_t ullMaxBlocking = 0ULL;
+static uint32_t ulBlockedJobs = 0UL;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xResource = xSemaphoreCreateMutex();
+	configASSERT( xResource != NULL );
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvWaiterTask, "Waiter", blkSTACK_SIZE, NULL, 0, &xWaiter, blkWAITER_PERIOD, blkWAITER_DEADLINE, blkWAITER_WCET );
+	( void ) xTaskPeriodicCreateWithDeadline( prvMiddleTask, "Middle", blkSTACK_SIZE, NULL, 0, &xMiddle, blkMIDDLE_PERIOD, blkMIDDLE_PERIOD, blkMIDDLE_WCET );
+	( void ) xTaskPeriodicCreateWithDeadline( prvHolderTask, "Holder", blkSTACK_SIZE, NULL, 0, &xHolder, blkHOLDER_PERIOD, blkHOLDER_PERIOD, blkHOLDER_WCET );
+	configASSERT( ( xWaiter != NULL ) && ( xMiddle != NULL ) && ( xHolder != NULL ) );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+uint32_t ulJobs;
+uint64_t ullWaitStart, ullBlocked;
+
+	( void ) pvParameters;
+
+	for( ulJobs = 0UL; ulJobs < blkWAITER_JOBS; ulJobs++ )
+	{
+		ullWaitStart = ullPortSimulatedTime();
+		( void ) xSemaphoreTake( xResource, portMAX_DELAY );
+		ullBlocked = ullPortSimulatedTime() - ullWaitStart;
+
+		if( ullBlocked > 0ULL )
+		{
+			ulBlockedJobs++;
+			vPortSimulationTrace( "BLOCKED %lu us\n", ( unsigned long ) ullBlocked );
+
+			if( ullBlocked > ullMaxBlocking )
+			{
+				ullMaxBlocking = ullBlocked;
+			}
+		}
+
+		vPortSimulateExecution( blkWAITER_US );
+		( void ) xSemaphoreGive( xResource );
+
+		( void ) xTaskWaitForNextPeriod();
+	}
+
+	prvEndScenario();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMiddleTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vPortSimulateExecution( blkMIDDLE_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHolderTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vPortSimulateExecution( blkHOLDER_US );
+
+		( void ) xSemaphoreTake( xResource, portMAX_DELAY );
+		vPortSimulateExecution( blkHOLD_US );
+		( void ) xSemaphoreGive( xResource );
+
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+TaskHandle_t xTasks[ 3 ];
+UBaseType_t uxMisses, uxTotalMisses = 0U, ux;
+
+	xTasks[ 0 ] = xWaiter;
+	xTasks[ 1 ] = xMiddle;
+	xTasks[ 2 ] = xHolder;
+
+	for( ux = 0U; ux < 3U; ux++ )
+	{
+		vTaskGetDeadlineMissInfo( xTasks[ ux ], &uxMisses, NULL, NULL );
+		uxTotalMisses += uxMisses;
+	}
+
+	vPortSimulationTrace( "RESULT blocked %lu of %lu jobs, max %lu us, %lu deadlines missed\n",
+						  ( unsigned long ) ulBlockedJobs, ( unsigned long ) blkWAITER_JOBS,
+						  ( unsigned long ) ullMaxBlocking, ( unsigned long ) uxTotalMisses );
+
+	if( ulBlockedJobs == 0UL )
+	{
+		vPortSimulationTrace( "FAIL the waiter never found the mutex held\n" );
+	}
+	else if( ullMaxBlocking > ( uint64_t ) blkHOLD_US )
+	{
+		vPortSimulationTrace( "FAIL blocked for longer than one critical section\n" );
+	}
+	else if( uxTotalMisses != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
@@ -0,0 +1,218 @@
+/*
+ * Aperiodic event scenario for the Constant Bandwidth Server, see
+ * xTaskCbsCreate() and xTaskCbsSubmitFromISR().
+ *
+ * Two periodic tasks load the processor, and events arrive from the tick
+ * interrupt as they would from a button or a UART interrupt, one at a time and
+ * in bursts of cbsBURST.  Each event is submitted to a server with a budget of
+ * cbsBUDGET ticks every cbsSERVER_PERIOD ticks, rather than waiting for a task
+ * that polls for it every cbsPOLL_PERIOD ticks.  A burst uses more than the
+ * budget, so the server has to move its deadline on to finish it.
+ *
+ * The scenario reports the latency of the events from their submission to the
+ * start of their job.  It passes if every event was served, the mean latency
+ * is below the polling period, and no periodic task missed a deadline however
+ * much work the events brought.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Timing of the periodic tasks and of the server, in ticks. */
+#define cbsFAST_PERIOD			( ( TickType_t ) 10 )
+#define cbsFAST_WCET			( ( TickType_t ) 3 )
+#define cbsSLOW_PERIOD			( ( TickType_t ) 20 )
+#define cbsSLOW_WCET			( ( TickType_t ) 6 )
+#define cbsBUDGET				( ( TickType_t ) 2 )
+#define cbsSERVER_PERIOD		( ( TickType_t ) 10 )
+#define cbsQUEUE_LENGTH			( ( UBaseType_t ) 8 )
+
+/* Period of the polling task the server replaces, 20 ms. */
+#define cbsPOLL_PERIOD			( ( TickType_t ) 20 )
+
+/* Events arrive alone every cbsSINGLE_TICKS ticks, and cbsBURST at a time
+every cbsBURST_TICKS ticks. */
+#define cbsSINGLE_TICKS			( 37UL )
+#define cbsBURST_TICKS			( 101UL )
+#define cbsBURST				( 3U )
+
+/* Execution times in microseconds of virtual time. */
+#define cbsFAST_US				( 2500UL )
+#define cbsSLOW_US				( 5000UL )
+#define cbsEVENT_US				( 800UL )
+
+/* Jobs of the fast task before the result is checked, 10000 ticks. */
+#define cbsFAST_JOBS			( 1000UL )
+
+#define cbsSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvFastTask( void *pvParameters );
+static void prvSlowTask( void *pvParameters );
+static void prvEventJob( void *pvParameters );
+static void prvSubmitEvent( void );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xFast = NULL, xSlow = NULL, xServer = NULL;
+
+/* Written from the tick interrupt, read by the server. */
+static volatile uint32_t ulEventsSubmitted = 0UL, ulEventsRefused = 0UL;
+static volatile uint64_t ullSubmitTime[ cbsQUEUE_LENGTH ];
+static volatile uint32_t ulNextSlot = 0UL;
+
+static uint32_t ulEventsServed = 0UL;
+static uint64_t ullTotalLatency = 0ULL, ullMaxLatency = 0ULL;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	/* Budgets are charged in T1TC counts, which run at the peripheral clock
+	divided by T1PR + 1 as in main.c. */
+	T1PR = 1000;
+	T1TCR |= 0x1;
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvFastTask, "Fast", cbsSTACK_SIZE, NULL, 0, &xFast, cbsFAST_PERIOD, cbsFAST_PERIOD, cbsFAST_WCET );
+	( void ) xTaskPeriodicCreateWithDeadline( prvSlowTask, "Slow", cbsSTACK_SIZE, NULL, 0, &xSlow, cbsSLOW_PERIOD, cbsSLOW_PERIOD, cbsSLOW_WCET );
+	( void ) xTaskCbsCreate( "Events", cbsSTACK_SIZE, 0, cbsQUEUE_LENGTH, cbsBUDGET, cbsSERVER_PERIOD, &xServer );
+	configASSERT( ( xFast != NULL ) && ( xSlow != NULL ) && ( xServer != NULL ) );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFastTask( void *pvParameters )
+{
+uint32_t ulJobs;
+
+	( void ) pvParameters;
+
+	for( ulJobs = 0UL; ulJobs < cbsFAST_JOBS; ulJobs++ )
+	{
+		vPortSimulateExecution( cbsFAST_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+
+	prvEndScenario();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSlowTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vPortSimulateExecution( cbsSLOW_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventJob( void *pvParameters )
+{
+const uint32_t ulSlot = ( uint32_t ) ( uintptr_t ) pvParameters;
+uint64_t ullLatency;
+
+	/* Jobs are served in the order they were submitted, so the slot is not
+	reused before this job has read it. */
+	ullLatency = ullPortSimulatedTime() - ullSubmitTime[ ulSlot ];
+	ullTotalLatency += ullLatency;
+
+	if( ullLatency > ullMaxLatency )
+	{
+		ullMaxLatency = ullLatency;
+	}
+
+	ulEventsServed++;
+	vPortSimulateExecution( cbsEVENT_US );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSubmitEvent( void )
+{
+const uint32_t ulSlot = ulNextSlot;
+
+	ullSubmitTime[ ulSlot ] = ullPortSimulatedTime();
+
+	if( xTaskCbsSubmitFromISR( xServer, prvEventJob, ( void * ) ( uintptr_t ) ulSlot, NULL ) == pdPASS )
+	{
+		ulNextSlot = ( ulSlot + 1UL ) % ( uint32_t ) cbsQUEUE_LENGTH;
+		ulEventsSubmitted++;
+	}
+	else
+	{
+		ulEventsRefused++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+UBaseType_t uxFastMisses, uxSlowMisses;
+uint64_t ullMeanLatency;
+
+	vTaskGetDeadlineMissInfo( xFast, &uxFastMisses, NULL, NULL );
+	vTaskGetDeadlineMissInfo( xSlow, &uxSlowMisses, NULL, NULL );
+	ullMeanLatency = ullTotalLatency / ( ( ulEventsServed > 0UL ) ? ulEventsServed : 1UL );
+
+	vPortSimulationTrace( "RESULT %lu of %lu events served, %lu refused, latency mean %lu us max %lu us, polling every %lu us\n",
+						  ( unsigned long ) ulEventsServed, ( unsigned long ) ulEventsSubmitted, ( unsigned long ) ulEventsRefused,
+						  ( unsigned long ) ullMeanLatency, ( unsigned long ) ullMaxLatency,
+						  ( unsigned long ) ( cbsPOLL_PERIOD * ( 1000000UL / configTICK_RATE_HZ ) ) );
+	vPortSimulationTrace( "RESULT %lu deadlines missed\n", ( unsigned long ) ( uxFastMisses + uxSlowMisses ) );
+
+	/* The last event can still be queued or running. */
+	if( ( ulEventsRefused != 0UL ) || ( ( ulEventsServed + cbsQUEUE_LENGTH ) < ulEventsSubmitted ) )
+	{
+		vPortSimulationTrace( "FAIL events were not served\n" );
+	}
+	else if( ullMeanLatency >= ( uint64_t ) ( cbsPOLL_PERIOD * ( 1000000UL / configTICK_RATE_HZ ) ) )
+	{
+		vPortSimulationTrace( "FAIL events waited longer than a polling period\n" );
+	}
+	else if( ( uxFastMisses + uxSlowMisses ) != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+const uint32_t ulTicks = ( uint32_t ) xTaskGetTickCountFromISR();
+UBaseType_t ux;
+
+	/* Called from the tick interrupt, so the events arrive as they would from
+	a peripheral. */
+	if( ( ulTicks % cbsSINGLE_TICKS ) == 0UL )
+	{
+		prvSubmitEvent();
+	}
+
+	if( ( ulTicks % cbsBURST_TICKS ) == 0UL )
+	{
+		for( ux = 0U; ux < cbsBURST; ux++ )
+		{
+			prvSubmitEvent();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
@@ -0,0 +1,4 @@
+/* scenario_cbs.c serves its events from a Constant Bandwidth Server, which
+main.c does not use. */
+#undef configUSE_EDF_CBS
+#define configUSE_EDF_CBS			1
@@ -0,0 +1,207 @@
+/*
+ * Run-to-completion job scenario for the job server, see xTaskJobCreate() and
+ * prvJobServerTask().
+ *
+ * Three periodic jobs run on the stack of one job server, next to a periodic
+ * task with a short deadline.  Each job works out its own releases and
+ * deadlines from its count of jobs, in ticks from the start of the run, and
+ * checks when it starts that:
+ *   it did not start before its release,
+ *   no other job is part way through, as jobs run to completion,
+ *   no other job released and not started has an earlier deadline.
+ * The task preempts the server part way through its jobs.  A fourth job fits
+ * by utilisation, but its WCET would delay the first job past its deadline if
+ * it had started just before, so it must be refused.
+ *
+ * The scenario passes if every check held, the task preempted the server, the
+ * fourth job was refused with errTASK_SET_NOT_SCHEDULABLE, and no deadline was
+ * missed.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define jbJOBS					( 3U )
+
+/* Timing of the task and of the refused job, in ticks. */
+#define jbTASK_PERIOD			( ( TickType_t ) 25 )
+#define jbTASK_DEADLINE			( ( TickType_t ) 5 )
+#define jbTASK_WCET				( ( TickType_t ) 1 )
+#define jbREFUSED_PERIOD		( ( TickType_t ) 100 )
+#define jbREFUSED_WCET			( ( TickType_t ) 9 )
+
+/* Execution time of the task in microseconds of virtual time. */
+#define jbTASK_US				( 800UL )
+
+/* Jobs of the first job before the result is checked, 5000 ticks. */
+#define jbFIRST_JOBS			( 500UL )
+
+#define jbSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvJob( void *pvParameters );
+static void prvRefusedJob( void *pvParameters );
+static void prvShortTask( void *pvParameters );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+/* Timing of the jobs, in ticks, and their execution times in microseconds of
+virtual time.  Each has the same relative deadline as period. */
+static const TickType_t xPeriods[ jbJOBS ] = { 10, 20, 50 };
+static const TickType_t xWCETs[ jbJOBS ] = { 2, 4, 6 };
+static const uint32_t ulJobUs[ jbJOBS ] = { 1500UL, 3500UL, 5500UL };
+
+static TaskHandle_t xServer = NULL, xTask = NULL;
+static TickType_t xStartTick;
+
+/* The jobs of each job started so far, and whether one is part way through. */
+static uint32_t ulStarted[ jbJOBS ];
+static volatile BaseType_t xInJob = pdFALSE;
+
+static uint32_t ulEarly = 0UL, ulNested = 0UL, ulOutOfOrder = 0UL, ulServerPreempted = 0UL;
+static BaseType_t xRefusedReturn = pdPASS;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+BaseType_t xReturn;
+
+	xStartTick = xTaskGetTickCount();
+
+	( void ) xTaskJobServerCreate( "Server", jbSTACK_SIZE, 0, 0, &xServer );
+	configASSERT( xServer != NULL );
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvShortTask, "Short", jbSTACK_SIZE, NULL, 0, &xTask, jbTASK_PERIOD, jbTASK_DEADLINE, jbTASK_WCET );
+	configASSERT( xTask != NULL );
+
+	for( ux = 0U; ux < jbJOBS; ux++ )
+	{
+		xReturn = xTaskJobCreate( prvJob, ( void * ) ux, xPeriods[ ux ], xPeriods[ ux ], xWCETs[ ux ] );
+		configASSERT( xReturn == pdPASS );
+	}
+
+	xRefusedReturn = xTaskJobCreate( prvRefusedJob, NULL, jbREFUSED_PERIOD, jbREFUSED_PERIOD, jbREFUSED_WCET );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvJob( void *pvParameters )
+{
+const UBaseType_t uxJob = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+const TickType_t xNow = xTaskGetTickCount() - xStartTick;
+const uint64_t ullRelease = ( uint64_t ) ulStarted[ uxJob ] * ( uint64_t ) xPeriods[ uxJob ];
+uint64_t ullOtherRelease;
+UBaseType_t ux;
+
+	if( ( uint64_t ) xNow < ullRelease )
+	{
+		ulEarly++;
+	}
+
+	if( xInJob != pdFALSE )
+	{
+		ulNested++;
+	}
+
+	for( ux = 0U; ux < jbJOBS; ux++ )
+	{
+		ullOtherRelease = ( uint64_t ) ulStarted[ ux ] * ( uint64_t ) xPeriods[ ux ];
+
+		if( ( ux != uxJob ) && ( ullOtherRelease <= ( uint64_t ) xNow ) &&
+			( ( ullOtherRelease + xPeriods[ ux ] ) < ( ullRelease + xPeriods[ uxJob ] ) ) )
+		{
+			ulOutOfOrder++;
+		}
+	}
+
+	ulStarted[ uxJob ]++;
+
+	xInJob = pdTRUE;
+	vPortSimulateExecution( ulJobUs[ uxJob ] );
+	xInJob = pdFALSE;
+
+	if( ( uxJob == 0U ) && ( ulStarted[ 0 ] == jbFIRST_JOBS ) )
+	{
+		prvEndScenario();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRefusedJob( void *pvParameters )
+{
+	( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static void prvShortTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xInJob != pdFALSE )
+		{
+			ulServerPreempted++;
+		}
+
+		vPortSimulateExecution( jbTASK_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+UBaseType_t uxServerMisses, uxTaskMisses;
+
+	vTaskGetDeadlineMissInfo( xServer, &uxServerMisses, NULL, NULL );
+	vTaskGetDeadlineMissInfo( xTask, &uxTaskMisses, NULL, NULL );
+
+	vPortSimulationTrace( "RESULT %u jobs on 1 stack, jobs %lu/%lu/%lu\n", ( unsigned ) jbJOBS,
+						  ( unsigned long ) ulStarted[ 0 ], ( unsigned long ) ulStarted[ 1 ], ( unsigned long ) ulStarted[ 2 ] );
+	vPortSimulationTrace( "RESULT %lu early, %lu nested, %lu out of deadline order, server preempted %lu times\n",
+						  ( unsigned long ) ulEarly, ( unsigned long ) ulNested, ( unsigned long ) ulOutOfOrder, ( unsigned long ) ulServerPreempted );
+	vPortSimulationTrace( "RESULT blocking job returned %ld, %lu deadlines missed\n",
+						  ( long ) xRefusedReturn, ( unsigned long ) ( uxServerMisses + uxTaskMisses ) );
+
+	if( ( ulEarly != 0UL ) || ( ulNested != 0UL ) || ( ulOutOfOrder != 0UL ) )
+	{
+		vPortSimulationTrace( "FAIL jobs did not run to completion in deadline order\n" );
+	}
+	else if( ulServerPreempted == 0UL )
+	{
+		vPortSimulationTrace( "FAIL the task never preempted the server\n" );
+	}
+	else if( xRefusedReturn != errTASK_SET_NOT_SCHEDULABLE )
+	{
+		vPortSimulationTrace( "FAIL the blocking job was not refused\n" );
+	}
+	else if( ( uxServerMisses + uxTaskMisses ) != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
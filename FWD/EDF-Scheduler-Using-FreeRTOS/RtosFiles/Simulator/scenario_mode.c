@@ -0,0 +1,243 @@
+/*
+ * Mode change scenario, see xTaskModeChange(), xTaskSetPeriod() and
+ * xTaskSetDeadline().
+ *
+ * A controller task with no WCET of its own changes the timing of two periodic
+ * tasks while they run.  The periods are powers of two, so the utilisations add
+ * up exactly in units of 1 / 65536:
+ *   A and B start at 0.25 each, and move to twice their rate in one mode
+ *   change, which takes the total to the bound of 1.0.
+ *   Doubling the rate of A again would take it past the bound, so
+ *   xTaskSetPeriod() is refused and A keeps its rate.
+ *   A second mode change takes both back to their first rate.
+ *   xTaskSetDeadline() can shorten the deadline of A to 3 ticks, but not that
+ *   of B as well, as the two would then need 6 ticks in the first 3.
+ *   A task with a change still pending cannot be changed again, and a deadline
+ *   past the period is not valid.
+ * The tasks end their jobs with xTaskWaitForNextPeriod(), which takes the new
+ * period from the task.  The controller counts their jobs over mdWINDOW ticks
+ * after each change, which must match the period the task should then have.
+ *
+ * The scenario passes if every change returned what was expected, the total
+ * utilisation was right after each step, each task ran at its expected rate,
+ * and no deadline was missed.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define mdTASKS					( 2U )
+#define mdA						( 0U )
+#define mdB						( 1U )
+
+/* Timing of the tasks, in ticks. */
+#define mdA_PERIOD				( ( TickType_t ) 8 )
+#define mdA_WCET				( ( TickType_t ) 2 )
+#define mdB_PERIOD				( ( TickType_t ) 16 )
+#define mdB_WCET				( ( TickType_t ) 4 )
+#define mdSHORT_DEADLINE		( ( TickType_t ) 3 )
+#define mdCONTROLLER_PERIOD		( ( TickType_t ) 2000 )
+
+/* Ticks the controller waits for a change to apply, and then counts the jobs
+of each task over. */
+#define mdSETTLE				( ( TickType_t ) 64 )
+#define mdWINDOW				( ( TickType_t ) 128 )
+
+/* Utilisations in units of 1 / 65536. */
+#define mdUTILISATION( wcet, period )	( ( uint32_t ) ( ( 0x10000UL * ( uint32_t ) ( wcet ) ) / ( uint32_t ) ( period ) ) )
+
+/* Execution times in microseconds of virtual time, within the WCET of each
+task. */
+#define mdA_US					( 1500UL )
+#define mdB_US					( 3500UL )
+
+#define mdSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvControllerTask( void *pvParameters );
+static void prvModeTask( void *pvParameters );
+static void prvCheck( const char *pcStep, BaseType_t xReturn, BaseType_t xExpected, uint32_t ulExpectedUtilisation );
+static void prvCheckRates( const char *pcStep, TickType_t xPeriodA, TickType_t xPeriodB );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xTasks[ mdTASKS ];
+static const uint32_t ulUs[ mdTASKS ] = { mdA_US, mdB_US };
+
+/* Jobs of each task started so far. */
+static volatile uint32_t ulJobs[ mdTASKS ];
+
+static BaseType_t xAllChecked = pdTRUE;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+TaskHandle_t xController = NULL;
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvModeTask, "A", mdSTACK_SIZE, ( void * ) mdA, 0, &( xTasks[ mdA ] ), mdA_PERIOD, mdA_PERIOD, mdA_WCET );
+	( void ) xTaskPeriodicCreateWithDeadline( prvModeTask, "B", mdSTACK_SIZE, ( void * ) mdB, 0, &( xTasks[ mdB ] ), mdB_PERIOD, mdB_PERIOD, mdB_WCET );
+	( void ) xTaskPeriodicCreateWithDeadline( prvControllerTask, "Control", mdSTACK_SIZE, NULL, 0, &xController, mdCONTROLLER_PERIOD, mdCONTROLLER_PERIOD, 0 );
+	configASSERT( ( xTasks[ mdA ] != NULL ) && ( xTasks[ mdB ] != NULL ) && ( xController != NULL ) );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControllerTask( void *pvParameters )
+{
+const uint32_t ulFirst = mdUTILISATION( mdA_WCET, mdA_PERIOD ) + mdUTILISATION( mdB_WCET, mdB_PERIOD );
+const uint32_t ulDouble = mdUTILISATION( mdA_WCET, mdA_PERIOD / 2U ) + mdUTILISATION( mdB_WCET, mdB_PERIOD / 2U );
+TickType_t xPeriods[ mdTASKS ];
+BaseType_t xReturn;
+
+	( void ) pvParameters;
+
+	prvCheckRates( "first rate", mdA_PERIOD, mdB_PERIOD );
+	prvCheck( "first rate", pdPASS, pdPASS, ulFirst );
+
+	xPeriods[ mdA ] = mdA_PERIOD / 2U;
+	xPeriods[ mdB ] = mdB_PERIOD / 2U;
+	xReturn = xTaskModeChange( xTasks, xPeriods, NULL, mdTASKS );
+	prvCheck( "double rate admitted to the bound", xReturn, pdPASS, ulDouble );
+	prvCheckRates( "double rate", mdA_PERIOD / 2U, mdB_PERIOD / 2U );
+
+	xReturn = xTaskSetPeriod( xTasks[ mdA ], mdA_PERIOD / 4U );
+	prvCheck( "A refused past the bound", xReturn, errTASK_SET_NOT_SCHEDULABLE, ulDouble );
+	prvCheckRates( "A kept its rate", mdA_PERIOD / 2U, mdB_PERIOD / 2U );
+
+	/* The tasks are admitted with their shorter periods until both have
+	moved back. */
+	xPeriods[ mdA ] = mdA_PERIOD;
+	xPeriods[ mdB ] = mdB_PERIOD;
+	xReturn = xTaskModeChange( xTasks, xPeriods, NULL, mdTASKS );
+	prvCheck( "first rate while the change is pending", xReturn, pdPASS, ulDouble );
+	prvCheckRates( "first rate again", mdA_PERIOD, mdB_PERIOD );
+	prvCheck( "first rate applied", pdPASS, pdPASS, ulFirst );
+
+	xReturn = xTaskSetDeadline( xTasks[ mdA ], mdSHORT_DEADLINE );
+	prvCheck( "A short deadline admitted by demand", xReturn, pdPASS, ulFirst );
+
+	xReturn = xTaskSetDeadline( xTasks[ mdB ], mdSHORT_DEADLINE );
+	prvCheck( "B short deadline refused by demand", xReturn, errTASK_SET_NOT_SCHEDULABLE, ulFirst );
+	prvCheckRates( "short deadline", mdA_PERIOD, mdB_PERIOD );
+
+	/* The change of period is pending until the next release of B. */
+	xReturn = xTaskSetPeriod( xTasks[ mdB ], mdB_PERIOD * 2U );
+	prvCheck( "B half rate admitted", xReturn, pdPASS, ulFirst );
+
+	xReturn = xTaskSetPeriod( xTasks[ mdB ], mdB_PERIOD * 4U );
+	prvCheck( "B refused with a change pending", xReturn, pdFAIL, ulFirst );
+	prvCheckRates( "B half rate", mdA_PERIOD, mdB_PERIOD * 2U );
+
+	xReturn = xTaskSetDeadline( xTasks[ mdA ], mdA_PERIOD + 1U );
+	prvCheck( "A deadline past its period refused", xReturn, pdFAIL,
+			  mdUTILISATION( mdA_WCET, mdA_PERIOD ) + mdUTILISATION( mdB_WCET, mdB_PERIOD * 2U ) );
+
+	prvEndScenario();
+}
+/*-----------------------------------------------------------*/
+
+static void prvModeTask( void *pvParameters )
+{
+const UBaseType_t uxTask = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+
+	for( ;; )
+	{
+		ulJobs[ uxTask ]++;
+		vPortSimulateExecution( ulUs[ uxTask ] );
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheck( const char *pcStep, BaseType_t xReturn, BaseType_t xExpected, uint32_t ulExpectedUtilisation )
+{
+const uint32_t ulUtilisation = ulTaskGetTotalUtilisation();
+
+	vPortSimulationTrace( "RESULT %s, returned %ld, utilisation %lu / 65536\n", pcStep, ( long ) xReturn, ( unsigned long ) ulUtilisation );
+
+	if( ( xReturn != xExpected ) || ( ulUtilisation != ulExpectedUtilisation ) )
+	{
+		vPortSimulationTrace( "FAIL %s, expected %ld and %lu / 65536\n", pcStep, ( long ) xExpected, ( unsigned long ) ulExpectedUtilisation );
+		xAllChecked = pdFALSE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckRates( const char *pcStep, TickType_t xPeriodA, TickType_t xPeriodB )
+{
+const TickType_t xPeriods[ mdTASKS ] = { xPeriodA, xPeriodB };
+uint32_t ulFirstJobs[ mdTASKS ], ulRan;
+UBaseType_t ux;
+
+	/* Wait for the change to apply at the next release of each task, then
+	count the jobs over a whole number of both periods. */
+	vTaskDelay( mdSETTLE );
+
+	for( ux = 0U; ux < mdTASKS; ux++ )
+	{
+		ulFirstJobs[ ux ] = ulJobs[ ux ];
+	}
+
+	vTaskDelay( mdWINDOW );
+
+	for( ux = 0U; ux < mdTASKS; ux++ )
+	{
+		ulRan = ulJobs[ ux ] - ulFirstJobs[ ux ];
+
+		vPortSimulationTrace( "RESULT %s, task %c ran %lu jobs in %lu ticks\n", pcStep, ( char ) ( 'A' + ux ),
+							  ( unsigned long ) ulRan, ( unsigned long ) mdWINDOW );
+
+		if( ulRan != ( uint32_t ) ( mdWINDOW / xPeriods[ ux ] ) )
+		{
+			vPortSimulationTrace( "FAIL %s, task %c expected %lu jobs\n", pcStep, ( char ) ( 'A' + ux ),
+								  ( unsigned long ) ( mdWINDOW / xPeriods[ ux ] ) );
+			xAllChecked = pdFALSE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+UBaseType_t uxMisses, uxTotalMisses = 0U, ux;
+
+	for( ux = 0U; ux < mdTASKS; ux++ )
+	{
+		vTaskGetDeadlineMissInfo( xTasks[ ux ], &uxMisses, NULL, NULL );
+		uxTotalMisses += uxMisses;
+	}
+
+	vPortSimulationTrace( "RESULT %lu deadlines missed\n", ( unsigned long ) uxTotalMisses );
+
+	if( xAllChecked == pdFALSE )
+	{
+		vPortSimulationTrace( "FAIL the mode changes did not match the expected timing\n" );
+	}
+	else if( uxTotalMisses != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
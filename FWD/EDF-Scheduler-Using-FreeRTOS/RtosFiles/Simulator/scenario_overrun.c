@@ -0,0 +1,253 @@
+/*
+ * Overrun policy scenario, see vTaskSetOverrunPolicy() and
+ * prvEnforceOverrunPolicy().
+ *
+ * Four periodic tasks share a period of ovPERIOD ticks but have deadlines of
+ * 10, 20, 30 and 40 ticks, so the one that overruns has the processor until
+ * its deadline and the others still meet theirs after it.  Each runs one job
+ * for ovOVERRUN_US, longer than its deadline, at a release of its own:
+ *   Abort, under taskOVERRUN_ABORT, must be abandoned at its deadline and
+ *   start its task function again at its next release.
+ *   Skip, under taskOVERRUN_SKIP_NEXT, must run on in place of its next job,
+ *   and start its next job at the release after that.
+ *   Degrade, under taskOVERRUN_DEGRADE, must be abandoned as Abort is, and run
+ *   its fallback function from its next release on.
+ *   Mutex is set to taskOVERRUN_ABORT, but overruns while it holds a mutex, so
+ *   it must be treated as Skip is and give the mutex back.
+ * Each task counts the times its task function was entered and the jobs it
+ * started, and records the tick the job after its overrun started on.  A
+ * checker task with a period of ovCHECK_TICKS checks them on its second job.
+ *
+ * The scenario passes if each task missed exactly one deadline, started the
+ * job after its overrun on the expected release, started the expected number
+ * of jobs and entered its task function the expected number of times, the
+ * fallback function ran from the release after the overrun of Degrade, and
+ * the mutex was free at the end.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#define ovTASKS					( 4U )
+#define ovABORT					( 0U )
+#define ovSKIP					( 1U )
+#define ovDEGRADE				( 2U )
+#define ovMUTEX					( 3U )
+
+/* Timing of the tasks, in ticks.  The checker ends the run on its second
+job. */
+#define ovPERIOD				( ( TickType_t ) 100 )
+#define ovWCET					( ( TickType_t ) 3 )
+#define ovCHECK_TICKS			( ( TickType_t ) 1000 )
+
+/* The job of each task that overruns, so no two overrun at the same
+release. */
+#define ovOVERRUN_JOB( task )	( ( uint32_t ) ( ( 2U * ( task ) ) + 1U ) )
+
+/* Execution times in microseconds of virtual time.  All the jobs of one
+release fit in its first tick, an overrun runs past every deadline. */
+#define ovJOB_US				( 200UL )
+#define ovOVERRUN_US			( 60000UL )
+
+#define ovSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvOverrunTask( void *pvParameters );
+static void prvFallbackTask( void *pvParameters );
+static void prvCheckTask( void *pvParameters );
+static BaseType_t prvStartJob( UBaseType_t uxTask );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+static const char * const pcNames[ ovTASKS ] = { "Abort", "Skip", "Degrade", "Mutex" };
+static const TickType_t xDeadlines[ ovTASKS ] = { 10, 20, 30, 40 };
+static const UBaseType_t uxPolicies[ ovTASKS ] = { taskOVERRUN_ABORT, taskOVERRUN_SKIP_NEXT, taskOVERRUN_DEGRADE, taskOVERRUN_ABORT };
+
+/* Releases after the overrun the next job starts on.  Under skip next the
+release straight after it has no job of its own. */
+static const uint32_t ulNextReleases[ ovTASKS ] = { 1UL, 2UL, 1UL, 2UL };
+
+/* Times each task function is entered, a restarted job enters it again. */
+static const uint32_t ulExpectedEntries[ ovTASKS ] = { 2UL, 1UL, 1UL, 1UL };
+
+static TaskHandle_t xTasks[ ovTASKS ];
+static SemaphoreHandle_t xMutex = NULL;
+static TickType_t xStartTick;
+
+/* Entries to the task function, jobs started, jobs of the fallback function,
+and the tick the job after the overrun started on. */
+static uint32_t ulEntries[ ovTASKS ], ulStarted[ ovTASKS ], ulFallbackJobs[ ovTASKS ];
+static TickType_t xNextStarts[ ovTASKS ];
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+TaskHandle_t xChecker = NULL;
+UBaseType_t ux;
+
+	xStartTick = xTaskGetTickCount();
+
+	xMutex = xSemaphoreCreateMutex();
+	configASSERT( xMutex != NULL );
+
+	for( ux = 0U; ux < ovTASKS; ux++ )
+	{
+		xTasks[ ux ] = NULL;
+		( void ) xTaskPeriodicCreateWithDeadline( prvOverrunTask, pcNames[ ux ], ovSTACK_SIZE, ( void * ) ux, 0, &( xTasks[ ux ] ), ovPERIOD, xDeadlines[ ux ], ovWCET );
+		configASSERT( xTasks[ ux ] != NULL );
+
+		vTaskSetOverrunPolicy( xTasks[ ux ], uxPolicies[ ux ], ( ux == ovDEGRADE ) ? prvFallbackTask : NULL );
+	}
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvCheckTask, "Check", ovSTACK_SIZE, NULL, 0, &xChecker, ovCHECK_TICKS, ovCHECK_TICKS, 0 );
+	configASSERT( xChecker != NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvOverrunTask( void *pvParameters )
+{
+const UBaseType_t uxTask = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+BaseType_t xOverrun;
+
+	ulEntries[ uxTask ]++;
+
+	for( ;; )
+	{
+		xOverrun = prvStartJob( uxTask );
+
+		if( uxTask == ovMUTEX )
+		{
+			( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+		}
+
+		vPortSimulateExecution( ( xOverrun != pdFALSE ) ? ovOVERRUN_US : ovJOB_US );
+
+		if( uxTask == ovMUTEX )
+		{
+			( void ) xSemaphoreGive( xMutex );
+		}
+
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFallbackTask( void *pvParameters )
+{
+const UBaseType_t uxTask = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) prvStartJob( uxTask );
+		ulFallbackJobs[ uxTask ]++;
+
+		vPortSimulateExecution( ovJOB_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvStartJob( UBaseType_t uxTask )
+{
+BaseType_t xOverrun = pdFALSE;
+
+	if( ulStarted[ uxTask ] == ovOVERRUN_JOB( uxTask ) )
+	{
+		xOverrun = pdTRUE;
+	}
+	else if( ulStarted[ uxTask ] == ( ovOVERRUN_JOB( uxTask ) + 1UL ) )
+	{
+		xNextStarts[ uxTask ] = xTaskGetTickCount() - xStartTick;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	ulStarted[ uxTask ]++;
+
+	return xOverrun;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	/* The first job is released with the tasks, the second once every overrun
+	has been dealt with. */
+	( void ) xTaskWaitForNextPeriod();
+
+	prvEndScenario();
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+const uint32_t ulReleases = ( uint32_t ) ( ovCHECK_TICKS / ovPERIOD ) + 1UL;
+UBaseType_t uxMisses, ux;
+TickType_t xExpectedStart;
+uint32_t ulExpectedStarted, ulExpectedFallback;
+BaseType_t xPassed = pdTRUE, xMutexFree;
+
+	for( ux = 0U; ux < ovTASKS; ux++ )
+	{
+		vTaskGetDeadlineMissInfo( xTasks[ ux ], &uxMisses, NULL, NULL );
+
+		/* Every release has a job, but for the one skipped. */
+		xExpectedStart = ( TickType_t ) ( ovOVERRUN_JOB( ux ) + ulNextReleases[ ux ] ) * ovPERIOD;
+		ulExpectedStarted = ulReleases - ( ulNextReleases[ ux ] - 1UL );
+		ulExpectedFallback = ( ux == ovDEGRADE ) ? ( ulReleases - ( ovOVERRUN_JOB( ux ) + 1UL ) ) : 0UL;
+
+		vPortSimulationTrace( "RESULT %s overran at tick %lu, %lu deadlines missed, next job at tick %lu, %lu jobs, %lu of the fallback, %lu entries\n",
+							  pcNames[ ux ], ( unsigned long ) ( ovOVERRUN_JOB( ux ) * ovPERIOD ), ( unsigned long ) uxMisses,
+							  ( unsigned long ) xNextStarts[ ux ], ( unsigned long ) ulStarted[ ux ],
+							  ( unsigned long ) ulFallbackJobs[ ux ], ( unsigned long ) ulEntries[ ux ] );
+
+		if( ( uxMisses != 1U ) || ( xNextStarts[ ux ] != xExpectedStart ) || ( ulStarted[ ux ] != ulExpectedStarted ) ||
+			( ulFallbackJobs[ ux ] != ulExpectedFallback ) || ( ulEntries[ ux ] != ulExpectedEntries[ ux ] ) )
+		{
+			vPortSimulationTrace( "FAIL %s expected 1 deadline missed, next job at tick %lu, %lu jobs, %lu of the fallback, %lu entries\n",
+								  pcNames[ ux ], ( unsigned long ) xExpectedStart, ( unsigned long ) ulExpectedStarted,
+								  ( unsigned long ) ulExpectedFallback, ( unsigned long ) ulExpectedEntries[ ux ] );
+			xPassed = pdFALSE;
+		}
+	}
+
+	xMutexFree = xSemaphoreTake( xMutex, 0 );
+	vPortSimulationTrace( "RESULT mutex %s at the end\n", ( xMutexFree != pdFALSE ) ? "free" : "held" );
+
+	if( xPassed == pdFALSE )
+	{
+		vPortSimulationTrace( "FAIL the overruns were not handled by their policies\n" );
+	}
+	else if( xMutexFree == pdFALSE )
+	{
+		vPortSimulationTrace( "FAIL the mutex was not given back\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
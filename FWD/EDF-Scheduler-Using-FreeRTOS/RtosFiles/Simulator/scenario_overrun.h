@@ -0,0 +1,4 @@
+/* scenario_overrun.c sets an overrun policy on each of its tasks, which main.c
+does not use. */
+#undef configUSE_EDF_OVERRUN_POLICY
+#define configUSE_EDF_OVERRUN_POLICY	1
@@ -0,0 +1,184 @@
+/*
+ * Shared stack scenario for job servers under the Stack Resource Policy, see
+ * xTaskJobServerCreate() and xTaskSrpLock().
+ *
+ * Jobs with the same relative deadline have the same preemption level, so
+ * none of them can preempt another and they can all run on one stack.  Two
+ * servers are created, one for the jobs with a deadline of srpSHORT_DEADLINE
+ * and one for those with a deadline of srpLONG_DEADLINE, and each runs two
+ * jobs.  The short jobs preempt the long jobs, which run on the other stack.
+ * For the last srpLOCK_US of each job the long jobs lock a resource that the
+ * short jobs also use, so while it is locked no short job may start.
+ *
+ * The scenario reports the stacks used for the jobs against a stack each, and
+ * how often a short job started while a long job was running.  It passes if
+ * short jobs did preempt long jobs, never while the resource was locked, the
+ * servers refused a job and a server they have no stack for, and no deadline
+ * was missed.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Timing of the jobs, in ticks.  The periods are prime to each other so the
+short releases fall at every point of the long jobs. */
+#define srpSHORT_DEADLINE		( ( TickType_t ) 10 )
+#define srpSHORT_WCET			( ( TickType_t ) 2 )
+#define srpLONG_DEADLINE		( ( TickType_t ) 40 )
+#define srpLONG_WCET			( ( TickType_t ) 8 )
+#define srpJOBS_PER_SERVER		( 2U )
+
+/* Execution times in microseconds of virtual time. */
+#define srpSHORT_US				( 1500UL )
+#define srpLONG_US				( 5000UL )
+#define srpLOCK_US				( 1000UL )
+
+/* Jobs of the first long job before the result is checked, 8000 ticks. */
+#define srpLONG_JOBS			( 200UL )
+
+#define srpSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvShortJob( void *pvParameters );
+static void prvLongJob( void *pvParameters );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+static const TickType_t xShortPeriods[ srpJOBS_PER_SERVER ] = { 19, 23 };
+static const TickType_t xLongPeriods[ srpJOBS_PER_SERVER ] = { 40, 53 };
+
+static TaskHandle_t xShortServer = NULL, xLongServer = NULL;
+
+/* Set while a long job runs, and while it holds the resource. */
+static volatile BaseType_t xLongRunning = pdFALSE, xLocked = pdFALSE;
+
+static uint32_t ulPreemptions = 0UL, ulStartsAboveCeiling = 0UL, ulLongJobs = 0UL;
+static BaseType_t xCreationChecked = pdTRUE;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+TaskHandle_t xExtra = NULL;
+UBaseType_t ux;
+BaseType_t xReturn;
+
+	( void ) xTaskJobServerCreate( "Short", srpSTACK_SIZE, 0, srpSHORT_DEADLINE, &xShortServer );
+	( void ) xTaskJobServerCreate( "Long", srpSTACK_SIZE, 0, srpLONG_DEADLINE, &xLongServer );
+	configASSERT( ( xShortServer != NULL ) && ( xLongServer != NULL ) );
+
+	for( ux = 0U; ux < srpJOBS_PER_SERVER; ux++ )
+	{
+		xReturn = xTaskJobCreate( prvShortJob, NULL, xShortPeriods[ ux ], srpSHORT_DEADLINE, srpSHORT_WCET );
+		configASSERT( xReturn == pdPASS );
+		xReturn = xTaskJobCreate( prvLongJob, ( void * ) ux, xLongPeriods[ ux ], srpLONG_DEADLINE, srpLONG_WCET );
+		configASSERT( xReturn == pdPASS );
+	}
+
+	/* configEDF_JOB_SERVERS is 2, and there is neither a server for this
+	deadline nor one for every other deadline. */
+	if( ( xTaskJobServerCreate( "Extra", srpSTACK_SIZE, 0, ( TickType_t ) 0, &xExtra ) != pdFAIL ) ||
+		( xTaskJobCreate( prvShortJob, NULL, srpLONG_DEADLINE, srpSHORT_DEADLINE + 1, 1 ) != pdFAIL ) )
+	{
+		xCreationChecked = pdFALSE;
+	}
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvShortJob( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	if( xLocked != pdFALSE )
+	{
+		ulStartsAboveCeiling++;
+	}
+	else if( xLongRunning != pdFALSE )
+	{
+		ulPreemptions++;
+	}
+
+	vPortSimulateExecution( srpSHORT_US );
+}
+/*-----------------------------------------------------------*/
+
+static void prvLongJob( void *pvParameters )
+{
+TickType_t xPreviousCeiling;
+
+	xLongRunning = pdTRUE;
+	vPortSimulateExecution( srpLONG_US - srpLOCK_US );
+
+	xPreviousCeiling = xTaskSrpLock( srpSHORT_DEADLINE );
+	xLocked = pdTRUE;
+	vPortSimulateExecution( srpLOCK_US );
+	xLocked = pdFALSE;
+	xLongRunning = pdFALSE;
+	vTaskSrpUnlock( xPreviousCeiling );
+
+	if( pvParameters == NULL )
+	{
+		ulLongJobs++;
+
+		if( ulLongJobs == srpLONG_JOBS )
+		{
+			prvEndScenario();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+UBaseType_t uxShortMisses, uxLongMisses;
+
+	vTaskGetDeadlineMissInfo( xShortServer, &uxShortMisses, NULL, NULL );
+	vTaskGetDeadlineMissInfo( xLongServer, &uxLongMisses, NULL, NULL );
+
+	vPortSimulationTrace( "RESULT %u jobs on 2 stacks of %u words, %u words saved\n",
+						  ( unsigned ) ( 2U * srpJOBS_PER_SERVER ), ( unsigned ) srpSTACK_SIZE,
+						  ( unsigned ) ( ( ( 2U * srpJOBS_PER_SERVER ) - 2U ) * srpSTACK_SIZE ) );
+	vPortSimulationTrace( "RESULT %lu short jobs preempted a long job, %lu started above the ceiling\n",
+						  ( unsigned long ) ulPreemptions, ( unsigned long ) ulStartsAboveCeiling );
+	vPortSimulationTrace( "RESULT %lu deadlines missed\n", ( unsigned long ) ( uxShortMisses + uxLongMisses ) );
+
+	if( xCreationChecked == pdFALSE )
+	{
+		vPortSimulationTrace( "FAIL a server or a job was created with no stack for it\n" );
+	}
+	else if( ulPreemptions == 0UL )
+	{
+		vPortSimulationTrace( "FAIL no short job preempted a long job\n" );
+	}
+	else if( ulStartsAboveCeiling != 0UL )
+	{
+		vPortSimulationTrace( "FAIL a short job started while the resource was locked\n" );
+	}
+	else if( ( uxShortMisses + uxLongMisses ) != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
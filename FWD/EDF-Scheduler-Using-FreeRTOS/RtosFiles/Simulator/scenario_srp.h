@@ -0,0 +1,8 @@
+/* scenario_srp.c locks its resource under the Stack Resource Policy, and runs
+its jobs on a job server for each of its two preemption levels. */
+#undef configUSE_EDF_SRP
+#define configUSE_EDF_SRP			1
+#undef configUSE_EDF_JOBS
+#define configUSE_EDF_JOBS			1
+#undef configEDF_JOB_SERVERS
+#define configEDF_JOB_SERVERS		2
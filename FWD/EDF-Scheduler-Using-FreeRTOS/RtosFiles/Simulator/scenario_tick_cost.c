@@ -0,0 +1,194 @@
+/*
+ * Tick cost scenario for the ready heap, see prvReadyHeapInsert().
+ *
+ * A controller task adds short periodic tasks in steps, 8, 16, 32, 64, 128 and
+ * then 256 of them.  All of them have the same period, so every job is
+ * released by the same tick, and their deadlines are mixed so the releases do
+ * not arrive in deadline order.  Over one period of the controller for each
+ * step it reports the mean host time of the tick, as measured by the port
+ * around xTaskIncrementTick().  scenario_tick_cost.h turns tickless idle off so
+ * that every tick is measured.
+ *
+ * scenario_tick_cost_list.c builds the same scenario with
+ * configUSE_EDF_READY_HEAP set to 0, for the sorted list the heap replaced.
+ *
+ * With the heap the controller then creates tasks until the heap is full.  The
+ * scenario passes if exactly configEDF_MAX_READY_TASKS tasks were created, the
+ * next one failed with errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY, and no deadline
+ * was missed.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Timing of the tasks, in ticks.  The controller measures one step of the task
+set over each of its periods. */
+#define tcPERIOD				( ( TickType_t ) 8 )
+#define tcCONTROLLER_PERIOD		( ( TickType_t ) 400 )
+
+/* Execution time of a job in microseconds of virtual time, short enough for
+every job of the largest step to complete within one tick. */
+#define tcJOB_US				( 2UL )
+
+#define tcFIRST_STEP			( 8UL )
+#define tcLAST_STEP				( 256UL )
+
+#define tcSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvControllerTask( void *pvParameters );
+static void prvShortTask( void *pvParameters );
+static BaseType_t prvAddTasks( uint32_t ulNewTasks );
+static void prvEndScenario( BaseType_t xCapacityChecked );
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xTasks[ tcLAST_STEP ];
+static uint32_t ulTasks = 0UL;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+TaskHandle_t xController = NULL;
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvControllerTask, "Control", tcSTACK_SIZE, NULL, 0, &xController, tcCONTROLLER_PERIOD, tcCONTROLLER_PERIOD, 0 );
+	configASSERT( xController != NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControllerTask( void *pvParameters )
+{
+uint64_t ullHostTime, ullLastHostTime;
+uint32_t ulTicks, ulLastTicks, ulStep;
+BaseType_t xReturn, xCapacityChecked = pdTRUE;
+
+	( void ) pvParameters;
+
+	for( ulStep = tcFIRST_STEP; ulStep <= tcLAST_STEP; ulStep *= 2UL )
+	{
+		xReturn = prvAddTasks( ulStep - ulTasks );
+		configASSERT( xReturn == pdPASS );
+
+		/* Measure the tick over the next period, during which the task set
+		does not change. */
+		ullLastHostTime = ullPortSimulatedTickHostTime( &ulLastTicks );
+		( void ) xTaskWaitForNextPeriod();
+		ullHostTime = ullPortSimulatedTickHostTime( &ulTicks );
+
+		vPortSimulationTrace( "RESULT %lu tasks, tick %lu ns mean over %lu ticks\n",
+							  ( unsigned long ) ulTasks,
+							  ( unsigned long ) ( ( ullHostTime - ullLastHostTime ) / ( ( ulTicks > ulLastTicks ) ? ( ulTicks - ulLastTicks ) : 1UL ) ),
+							  ( unsigned long ) ( ulTicks - ulLastTicks ) );
+	}
+
+	#if ( configUSE_EDF_READY_HEAP == 1 )
+	{
+	UBaseType_t uxCreated = ( UBaseType_t ) ulTasks + ( UBaseType_t ) 1U;
+	TaskHandle_t xExtra;
+
+		/* Every task but the idle task, the controller included, has a place
+		in the heap.  Fill the rest of it. */
+		do
+		{
+			xReturn = xTaskPeriodicCreateWithDeadline( prvShortTask, "Extra", tcSTACK_SIZE, NULL, 0, &xExtra, tcPERIOD, tcPERIOD, 0 );
+
+			if( xReturn == pdPASS )
+			{
+				uxCreated++;
+			}
+		} while( xReturn == pdPASS );
+
+		vPortSimulationTrace( "RESULT %lu tasks created of a heap of %lu\n", ( unsigned long ) uxCreated, ( unsigned long ) configEDF_MAX_READY_TASKS );
+
+		if( ( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY ) || ( uxCreated != ( UBaseType_t ) configEDF_MAX_READY_TASKS ) )
+		{
+			xCapacityChecked = pdFALSE;
+		}
+	}
+	#endif
+
+	prvEndScenario( xCapacityChecked );
+}
+/*-----------------------------------------------------------*/
+
+static void prvShortTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vPortSimulateExecution( tcJOB_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAddTasks( uint32_t ulNewTasks )
+{
+BaseType_t xReturn = pdPASS;
+TickType_t xDeadline;
+
+	while( ( ulNewTasks > 0UL ) && ( xReturn == pdPASS ) )
+	{
+		/* Deadlines of 1 to tcPERIOD ticks, in an order that is neither
+		rising nor falling. */
+		xDeadline = ( TickType_t ) 1 + ( ( ( TickType_t ) ulTasks * ( TickType_t ) 5 ) % tcPERIOD );
+
+		xReturn = xTaskPeriodicCreateWithDeadline( prvShortTask, "Short", tcSTACK_SIZE, NULL, 0, &( xTasks[ ulTasks ] ), tcPERIOD, xDeadline, 0 );
+
+		if( xReturn == pdPASS )
+		{
+			ulTasks++;
+			ulNewTasks--;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( BaseType_t xCapacityChecked )
+{
+UBaseType_t uxMisses, uxTotalMisses = 0U;
+uint32_t ul;
+
+	for( ul = 0UL; ul < ulTasks; ul++ )
+	{
+		vTaskGetDeadlineMissInfo( xTasks[ ul ], &uxMisses, NULL, NULL );
+		uxTotalMisses += uxMisses;
+	}
+
+	vPortSimulationTrace( "RESULT %lu deadlines missed\n", ( unsigned long ) uxTotalMisses );
+
+	if( xCapacityChecked == pdFALSE )
+	{
+		vPortSimulationTrace( "FAIL the heap did not take exactly configEDF_MAX_READY_TASKS tasks\n" );
+	}
+	else if( uxTotalMisses != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
@@ -0,0 +1,10 @@
+/* Room in the ready heap for the controller and the largest step of
+scenario_tick_cost.c. */
+#undef configEDF_MAX_READY_TASKS
+#define configEDF_MAX_READY_TASKS	( 264 )
+
+/* Without tickless idle every tick runs xTaskIncrementTick() from the tick
+interrupt, where the port measures it.  With it the tick that releases the jobs
+is the one that ends the sleep, and that is processed by the idle task. */
+#undef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE		0
@@ -0,0 +1,8 @@
+/*
+ * The tick cost scenario of scenario_tick_cost.c, built with the ready tasks
+ * kept in the list sorted by deadline rather than in the ready heap, see
+ * scenario_tick_cost_list.h.  Only the tick times are reported, the list has
+ * no capacity to check.
+ */
+
+#include "scenario_tick_cost.c"
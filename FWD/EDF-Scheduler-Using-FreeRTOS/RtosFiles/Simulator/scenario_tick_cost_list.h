@@ -0,0 +1,6 @@
+/* Keep the ready tasks in the list sorted by deadline, and measure every tick
+as scenario_tick_cost.h does. */
+#define configUSE_EDF_READY_HEAP	0
+
+#undef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE		0
@@ -0,0 +1,124 @@
+/*
+ * Event trace scenario for the binary trace of edf_trace.h and its decoder,
+ * Tools/edf_trace_decode.c.
+ *
+ * Two periodic tasks run with a schedule that is easy to work out by hand:
+ *   tick 0   A and B are released.  A has the earlier deadline, tick 4, and
+ *            runs for 0.8 ms, then B starts its 5 ms job.
+ *   tick 4   A is released with deadline 8 and preempts B, whose deadline is
+ *            12.  B completes at 6.6 ms and the idle task runs.
+ *   tick 8   A is released with deadline 12 and runs its third job.
+ *   tick 12  A and B are released again and the run ends.
+ * run_scenarios.sh dumps the event buffer at the end of the run, decodes it
+ * and compares the order of the records, their tasks and their data with
+ * scenario_trace.expected.  The scenario itself passes if no deadline was
+ * missed.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Timing of the tasks, in ticks. */
+#define trA_PERIOD				( ( TickType_t ) 4 )
+#define trA_WCET				( ( TickType_t ) 1 )
+#define trB_PERIOD				( ( TickType_t ) 12 )
+#define trB_WCET				( ( TickType_t ) 6 )
+
+/* Execution times in microseconds of virtual time. */
+#define trA_US					( 800UL )
+#define trB_US					( 5000UL )
+
+/* Jobs of A before the run ends. */
+#define trA_JOBS				( 3UL )
+
+#define trSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvTaskA( void *pvParameters );
+static void prvTaskB( void *pvParameters );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xTaskA = NULL, xTaskB = NULL;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	/* Timestamps come from T1TC, which counts at the peripheral clock divided
+	by T1PR + 1 as in main.c. */
+	T1PR = 1000;
+	T1TCR |= 0x1;
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvTaskA, "A", trSTACK_SIZE, NULL, 0, &xTaskA, trA_PERIOD, trA_PERIOD, trA_WCET );
+	( void ) xTaskPeriodicCreateWithDeadline( prvTaskB, "B", trSTACK_SIZE, NULL, 0, &xTaskB, trB_PERIOD, trB_PERIOD, trB_WCET );
+	configASSERT( ( xTaskA != NULL ) && ( xTaskB != NULL ) );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskA( void *pvParameters )
+{
+uint32_t ulJobs;
+
+	( void ) pvParameters;
+
+	for( ulJobs = 0UL; ulJobs < trA_JOBS; ulJobs++ )
+	{
+		vPortSimulateExecution( trA_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+
+	prvEndScenario();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskB( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vPortSimulateExecution( trB_US );
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+UBaseType_t uxMissesA, uxMissesB;
+
+	vTaskGetDeadlineMissInfo( xTaskA, &uxMissesA, NULL, NULL );
+	vTaskGetDeadlineMissInfo( xTaskB, &uxMissesB, NULL, NULL );
+
+	vPortSimulationTrace( "RESULT %lu deadlines missed\n", ( unsigned long ) ( uxMissesA + uxMissesB ) );
+
+	if( ( uxMissesA + uxMissesB ) != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
@@ -0,0 +1,316 @@
+/*
+ * Timing wheel scenario for the blocked tasks, see prvTimingWheelInsert() and
+ * prvTimingWheelAdvance().
+ *
+ * scenario_wheel.h turns the timing wheel on, and starts the tick count 10000
+ * ticks before it overflows.  whTASKS short periodic tasks, with periods spread
+ * over 20 to 1019 ticks, keep hundreds of tasks blocked in the lower levels of
+ * the wheel, and whFAR_TASKS more have periods beyond the reach of the wheel, so
+ * they wait in the far list.  Each works out its releases from its own count
+ * of jobs, in ticks from the start of the run, and checks that no job started
+ * before its release or after its deadline.
+ *
+ * A sleeper task blocks for each of the delays either side of the span of a
+ * list of every level, and for several turns of the whole wheel, and checks
+ * that it woke on the tick it asked for.  One of those delays crosses the
+ * overflow of the tick count.
+ *
+ * scenario_wheel_jobs.c builds the same scenario with whJOBS set to 1, where
+ * the periodic tasks are jobs of one job server, so only the server and the
+ * sleeper block in the wheel.
+ *
+ * The scenario reports the mean host time of the tick.  It passes if every
+ * delay ended on time, every task was released as often as its period
+ * requires, no job ran early or late, and no deadline was missed.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Set to 1 to run the periodic tasks as jobs of the job server. */
+#ifndef whJOBS
+	#define whJOBS					0
+#endif
+
+#define whTASKS					( 300U )
+#define whFAR_TASKS				( 4U )
+#define whALL_TASKS				( whTASKS + whFAR_TASKS )
+
+/* Ticks one list of each level spans, and the reach of the whole wheel. */
+#define whSLOT_TICKS( level )	( ( TickType_t ) 1U << ( configTIMING_WHEEL_BITS * ( level ) ) )
+#define whRANGE					whSLOT_TICKS( configTIMING_WHEEL_LEVELS )
+
+/* Periods of the tasks, in ticks.  The far tasks have periods beyond the reach
+of the wheel that are prime to each other. */
+#define whPERIOD( n )			( ( TickType_t ) ( 20U + ( ( ( n ) * 37U ) % 1000U ) ) )
+#define whFAR_PERIOD( n )		( whRANGE + ( TickType_t ) 3U + ( ( TickType_t ) ( n ) * ( TickType_t ) 2011U ) )
+
+/* The sleeper is a periodic task with no WCET and a period longer than all of
+its delays, so its own deadline never comes up. */
+#define whSLEEPER_PERIOD		( ( TickType_t ) 100000 )
+
+/* Execution time of a job in microseconds of virtual time. */
+#define whJOB_US				( 10UL )
+
+#define whSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+#if ( whJOBS == 1 )
+	static void prvWheelJob( void *pvParameters );
+#else
+	static void prvWheelTask( void *pvParameters );
+#endif
+static void prvSleeperTask( void *pvParameters );
+static void prvCheckJob( UBaseType_t uxTask );
+static TickType_t prvPeriod( UBaseType_t uxTask );
+static BaseType_t prvDelayFor( TickType_t xTicks );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+#if ( whJOBS == 1 )
+	static TaskHandle_t xServer = NULL;
+#else
+	static TaskHandle_t xTasks[ whALL_TASKS ];
+#endif
+static TickType_t xStartTick;
+
+/* Jobs of each task started so far. */
+static uint32_t ulStarted[ whALL_TASKS ];
+
+static uint32_t ulEarly = 0UL, ulLate = 0UL, ulBadDelays = 0UL, ulDelays = 0UL;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+TaskHandle_t xSleeper = NULL;
+UBaseType_t ux;
+
+	xStartTick = xTaskGetTickCount();
+
+	#if ( whJOBS == 1 )
+	{
+	BaseType_t xReturn;
+
+		( void ) xTaskJobServerCreate( "Jobs", whSTACK_SIZE, 0, 0, &xServer );
+		configASSERT( xServer != NULL );
+
+		for( ux = 0U; ux < whALL_TASKS; ux++ )
+		{
+			xReturn = xTaskJobCreate( prvWheelJob, ( void * ) ux, prvPeriod( ux ), prvPeriod( ux ), 0 );
+			configASSERT( xReturn == pdPASS );
+		}
+	}
+	#else
+	{
+		for( ux = 0U; ux < whALL_TASKS; ux++ )
+		{
+			xTasks[ ux ] = NULL;
+			( void ) xTaskPeriodicCreateWithDeadline( prvWheelTask, "Wheel", whSTACK_SIZE, ( void * ) ux, 0, &( xTasks[ ux ] ), prvPeriod( ux ), prvPeriod( ux ), 0 );
+			configASSERT( xTasks[ ux ] != NULL );
+		}
+	}
+	#endif
+
+	( void ) xTaskPeriodicCreateWithDeadline( prvSleeperTask, "Sleeper", whSTACK_SIZE, NULL, 0, &xSleeper, whSLEEPER_PERIOD, whSLEEPER_PERIOD, 0 );
+	configASSERT( xSleeper != NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+#if ( whJOBS == 1 )
+
+	static void prvWheelJob( void *pvParameters )
+	{
+		prvCheckJob( ( UBaseType_t ) ( uintptr_t ) pvParameters );
+	}
+
+#else
+
+	static void prvWheelTask( void *pvParameters )
+	{
+	const UBaseType_t uxTask = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+
+		for( ;; )
+		{
+			prvCheckJob( uxTask );
+			( void ) xTaskWaitForNextPeriod();
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvCheckJob( UBaseType_t uxTask )
+{
+const TickType_t xNow = xTaskGetTickCount() - xStartTick;
+const uint64_t ullRelease = ( uint64_t ) ulStarted[ uxTask ] * ( uint64_t ) prvPeriod( uxTask );
+
+	if( ( uint64_t ) xNow < ullRelease )
+	{
+		ulEarly++;
+	}
+	else if( ( uint64_t ) xNow >= ( ullRelease + prvPeriod( uxTask ) ) )
+	{
+		ulLate++;
+	}
+
+	ulStarted[ uxTask ]++;
+	vPortSimulateExecution( whJOB_US );
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvPeriod( UBaseType_t uxTask )
+{
+TickType_t xPeriod;
+
+	if( uxTask < whTASKS )
+	{
+		xPeriod = whPERIOD( uxTask );
+	}
+	else
+	{
+		xPeriod = whFAR_PERIOD( uxTask - whTASKS );
+	}
+
+	return xPeriod;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvDelayFor( TickType_t xTicks )
+{
+const TickType_t xBefore = xTaskGetTickCount();
+TickType_t xSlept;
+BaseType_t xReturn = pdPASS;
+
+	vTaskDelay( xTicks );
+	xSlept = xTaskGetTickCount() - xBefore;
+	ulDelays++;
+
+	if( xSlept != xTicks )
+	{
+		vPortSimulationTrace( "DELAY of %lu ticks from tick %lu woke after %lu\n",
+							  ( unsigned long ) xTicks, ( unsigned long ) xBefore, ( unsigned long ) xSlept );
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSleeperTask( void *pvParameters )
+{
+uint64_t ullHostTime, ullFirstHostTime;
+uint32_t ulTicks, ulFirstTicks;
+UBaseType_t uxLevel;
+TickType_t xSpan, xTicks;
+
+	( void ) pvParameters;
+
+	ullFirstHostTime = ullPortSimulatedTickHostTime( &ulFirstTicks );
+
+	/* Either side of the span of a list of each level, so the delays start in
+	every level and move down through the ones below. */
+	for( uxLevel = 0U; uxLevel <= ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+	{
+		xSpan = whSLOT_TICKS( uxLevel );
+
+		for( xTicks = xSpan - ( TickType_t ) 1U; xTicks <= ( xSpan + ( TickType_t ) 1U ); xTicks++ )
+		{
+			if( ( xTicks != ( TickType_t ) 0U ) && ( prvDelayFor( xTicks ) == pdFAIL ) )
+			{
+				ulBadDelays++;
+			}
+		}
+	}
+
+	/* Several turns of the wheel in the far list. */
+	if( prvDelayFor( ( whRANGE * ( TickType_t ) 3U ) + ( TickType_t ) 5U ) == pdFAIL )
+	{
+		ulBadDelays++;
+	}
+
+	ullHostTime = ullPortSimulatedTickHostTime( &ulTicks );
+
+	vPortSimulationTrace( "RESULT %lu periodic %s and the sleeper on a wheel of %lu levels of %lu lists, tick %lu ns mean over %lu ticks\n",
+						  ( unsigned long ) whALL_TASKS, ( whJOBS == 1 ) ? "jobs" : "tasks", ( unsigned long ) configTIMING_WHEEL_LEVELS, ( unsigned long ) whSLOT_TICKS( 1 ),
+						  ( unsigned long ) ( ( ullHostTime - ullFirstHostTime ) / ( ( ulTicks > ulFirstTicks ) ? ( ulTicks - ulFirstTicks ) : 1UL ) ),
+						  ( unsigned long ) ( ulTicks - ulFirstTicks ) );
+
+	prvEndScenario();
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+const TickType_t xElapsed = xTaskGetTickCount() - xStartTick;
+UBaseType_t uxMisses, uxTotalMisses = 0U, uxLost = 0U, ux;
+
+	#if ( whJOBS == 1 )
+	{
+		vTaskGetDeadlineMissInfo( xServer, &uxMisses, NULL, NULL );
+		uxTotalMisses += uxMisses;
+	}
+	#endif
+
+	for( ux = 0U; ux < whALL_TASKS; ux++ )
+	{
+		#if ( whJOBS == 0 )
+		{
+			vTaskGetDeadlineMissInfo( xTasks[ ux ], &uxMisses, NULL, NULL );
+			uxTotalMisses += uxMisses;
+		}
+		#endif
+
+		/* The job of the last release may not have started yet. */
+		if( ulStarted[ ux ] < ( uint32_t ) ( xElapsed / prvPeriod( ux ) ) )
+		{
+			uxLost++;
+		}
+	}
+
+	vPortSimulationTrace( "RESULT started at tick %lu, now %lu, %lu of %lu delays late or early\n",
+						  ( unsigned long ) configINITIAL_TICK_COUNT, ( unsigned long ) xTaskGetTickCount(),
+						  ( unsigned long ) ulBadDelays, ( unsigned long ) ulDelays );
+	vPortSimulationTrace( "RESULT %lu tasks short of releases, %lu jobs early, %lu late, %lu deadlines missed\n",
+						  ( unsigned long ) uxLost, ( unsigned long ) ulEarly, ( unsigned long ) ulLate, ( unsigned long ) uxTotalMisses );
+
+	if( xTaskGetTickCount() >= ( TickType_t ) configINITIAL_TICK_COUNT )
+	{
+		vPortSimulationTrace( "FAIL the tick count did not overflow\n" );
+	}
+	else if( ulBadDelays != 0UL )
+	{
+		vPortSimulationTrace( "FAIL delays did not end on the tick they asked for\n" );
+	}
+	else if( ( uxLost != 0U ) || ( ulEarly != 0UL ) || ( ulLate != 0UL ) )
+	{
+		vPortSimulationTrace( "FAIL jobs were not released on time\n" );
+	}
+	else if( uxTotalMisses != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
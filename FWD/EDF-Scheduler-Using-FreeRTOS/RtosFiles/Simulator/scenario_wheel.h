@@ -0,0 +1,11 @@
+/* scenario_wheel.c blocks its tasks in the timing wheel, and runs across the
+overflow of the tick count, so it starts 10000 ticks before it. */
+#undef configUSE_TIMING_WHEEL
+#define configUSE_TIMING_WHEEL		1
+
+#undef configINITIAL_TICK_COUNT
+#define configINITIAL_TICK_COUNT	( ( TickType_t ) 0xFFFFD8F0UL )
+
+/* Room in the ready heap for the tasks of scenario_wheel.c and the sleeper. */
+#undef configEDF_MAX_READY_TASKS
+#define configEDF_MAX_READY_TASKS	( 320 )
@@ -0,0 +1,9 @@
+/*
+ * The timing wheel scenario of scenario_wheel.c, with the periodic tasks run as
+ * jobs of one job server rather than as tasks with a stack each.  The kernel
+ * options are those of scenario_wheel.h, see scenario_wheel_jobs.h.
+ */
+
+#define whJOBS	1
+
+#include "scenario_wheel.c"
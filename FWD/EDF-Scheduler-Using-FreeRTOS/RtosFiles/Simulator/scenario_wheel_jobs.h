@@ -0,0 +1,2 @@
+/* The timing wheel and the start before the overflow of scenario_wheel.h. */
+#include "scenario_wheel.h"
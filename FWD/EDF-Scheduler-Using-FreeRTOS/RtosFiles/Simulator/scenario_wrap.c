@@ -0,0 +1,165 @@
+/*
+ * Tick overflow scenario for the deadline keys, see taskEDF_DEADLINE_KEY() and
+ * taskEDF_TIME_BEFORE().
+ *
+ * scenario_wrap.h starts the tick count wrPRE_WRAP_TICKS before it overflows,
+ * and three periodic tasks with periods prime to each other run across the
+ * overflow.  Their jobs keep being released with deadlines on both sides of it,
+ * so a key compared as a plain number would put a job with a deadline after the
+ * overflow ahead of every job with a deadline before it.
+ *
+ * Each task works out the deadline of its jobs from its own count of jobs, in
+ * 64 bits that do not overflow.  A job that starts while a job of another task
+ * with an earlier deadline has not completed was run out of deadline order.
+ * The scenario passes if the tick count overflowed, no job ran out of order and
+ * no deadline was missed.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define wrTASKS					( 3U )
+
+/* Execution times in microseconds of virtual time. */
+#define wrJOB_US( wcet )		( ( ( uint32_t ) ( wcet ) * 1000UL ) - 200UL )
+
+/* Ticks run after the overflow before the result is checked. */
+#define wrPOST_WRAP_TICKS		( ( TickType_t ) 2000 )
+
+#define wrSTACK_SIZE			( ( configSTACK_DEPTH_TYPE ) 100 )
+
+static void prvWrapTask( void *pvParameters );
+static void prvEndScenario( void );
+/*-----------------------------------------------------------*/
+
+/* Timing of the tasks, in ticks. */
+static const TickType_t xPeriods[ wrTASKS ] = { 7, 11, 13 };
+static const TickType_t xWCETs[ wrTASKS ] = { 2, 3, 4 };
+
+static TaskHandle_t xTasks[ wrTASKS ];
+
+/* The deadline of the job each task is running, in ticks from the first
+release, and whether it has not yet completed. */
+static uint64_t ullRunningDeadline[ wrTASKS ];
+static BaseType_t xRunning[ wrTASKS ];
+
+static uint32_t ulOutOfOrder = 0UL, ulJobsAfterWrap = 0UL;
+static BaseType_t xWrapped = pdFALSE;
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0U; ux < wrTASKS; ux++ )
+	{
+		xTasks[ ux ] = NULL;
+		( void ) xTaskPeriodicCreateWithDeadline( prvWrapTask, "Wrap", wrSTACK_SIZE, ( void * ) ux, 0, &( xTasks[ ux ] ), xPeriods[ ux ], xPeriods[ ux ], xWCETs[ ux ] );
+		configASSERT( xTasks[ ux ] != NULL );
+	}
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWrapTask( void *pvParameters )
+{
+const UBaseType_t uxTask = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+uint64_t ullDeadline = ( uint64_t ) xPeriods[ uxTask ];
+UBaseType_t ux;
+
+	for( ;; )
+	{
+		/* Every task is in the middle of a job while it is in this loop, so
+		the others are checked with the scheduler suspended. */
+		vTaskSuspendAll();
+		{
+			for( ux = 0U; ux < wrTASKS; ux++ )
+			{
+				if( ( ux != uxTask ) && ( xRunning[ ux ] != pdFALSE ) && ( ullRunningDeadline[ ux ] < ullDeadline ) )
+				{
+					ulOutOfOrder++;
+					vPortSimulationTrace( "ORDER job with deadline %lu ran before one with deadline %lu\n",
+										  ( unsigned long ) ullDeadline, ( unsigned long ) ullRunningDeadline[ ux ] );
+				}
+			}
+
+			ullRunningDeadline[ uxTask ] = ullDeadline;
+			xRunning[ uxTask ] = pdTRUE;
+		}
+		( void ) xTaskResumeAll();
+
+		vPortSimulateExecution( wrJOB_US( xWCETs[ uxTask ] ) );
+
+		xRunning[ uxTask ] = pdFALSE;
+		ullDeadline += ( uint64_t ) xPeriods[ uxTask ];
+
+		if( uxTask == 0U )
+		{
+			if( xTaskGetTickCount() < ( TickType_t ) configINITIAL_TICK_COUNT )
+			{
+				xWrapped = pdTRUE;
+				ulJobsAfterWrap++;
+
+				if( ulJobsAfterWrap == ( uint32_t ) ( wrPOST_WRAP_TICKS / xPeriods[ 0 ] ) )
+				{
+					prvEndScenario();
+				}
+			}
+		}
+
+		( void ) xTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndScenario( void )
+{
+UBaseType_t uxMisses, uxTotalMisses = 0U, ux;
+
+	for( ux = 0U; ux < wrTASKS; ux++ )
+	{
+		vTaskGetDeadlineMissInfo( xTasks[ ux ], &uxMisses, NULL, NULL );
+		uxTotalMisses += uxMisses;
+	}
+
+	vPortSimulationTrace( "RESULT started at tick %lu, now %lu, %lu jobs out of deadline order, %lu deadlines missed\n",
+						  ( unsigned long ) configINITIAL_TICK_COUNT, ( unsigned long ) xTaskGetTickCount(),
+						  ( unsigned long ) ulOutOfOrder, ( unsigned long ) uxTotalMisses );
+
+	if( xWrapped == pdFALSE )
+	{
+		vPortSimulationTrace( "FAIL the tick count did not overflow\n" );
+	}
+	else if( ulOutOfOrder != 0UL )
+	{
+		vPortSimulationTrace( "FAIL jobs ran out of deadline order\n" );
+	}
+	else if( uxTotalMisses != 0U )
+	{
+		vPortSimulationTrace( "FAIL deadlines were missed\n" );
+	}
+	else
+	{
+		vPortSimulationTrace( "PASS\n" );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateIdle();
+}
@@ -0,0 +1,4 @@
+/* scenario_wrap.c runs across the overflow of the tick count, so it starts
+1000 ticks before it. */
+#undef configINITIAL_TICK_COUNT
+#define configINITIAL_TICK_COUNT	( ( TickType_t ) 0xFFFFFC18UL )
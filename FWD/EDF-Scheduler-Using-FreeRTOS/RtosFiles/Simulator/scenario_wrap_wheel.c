@@ -0,0 +1,7 @@
+/*
+ * The tick overflow scenario of scenario_wrap.c, built with the blocked tasks
+ * held in the timing wheel rather than the two delayed lists, see
+ * scenario_wrap_wheel.h.
+ */
+
+#include "scenario_wrap.c"
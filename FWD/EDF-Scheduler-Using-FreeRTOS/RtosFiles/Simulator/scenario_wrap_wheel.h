@@ -0,0 +1,6 @@
+/* Start 1000 ticks before the overflow of the tick count as scenario_wrap.c
+does, and keep the blocked tasks in the timing wheel. */
+#include "scenario_wrap.h"
+
+#undef configUSE_TIMING_WHEEL
+#define configUSE_TIMING_WHEEL		1
@@ -0,0 +1,577 @@
+/*
+ * Host side decoder for the binary scheduler event trace of edf_trace.h.
+ *
+ * Reads a dump of xEdfTraceBuffer, either read from the target with a
+ * debugger or written by the POSIX simulator to the file named by
+ * EDF_SIM_EVENTS, and prints:
+ *   - optionally every record in the buffer, oldest first (-l),
+ *   - a Gantt timeline with one row per task and interrupt,
+ *   - response time and deadline statistics for each task.
+ *
+ * A job starts at its nominal release, taken from the RELEASE record, and
+ * ends at the last time its task is switched out before the next job of the
+ * task is released.  This is exact for periodic tasks that only block at the
+ * end of their job.  The job of a task that also blocks part way through is
+ * measured to its last switch out, which is still its completion time.  The
+ * last job of each task in the buffer is not counted as it may not be
+ * complete.
+ *
+ * The dump is little endian, as both the LPC2129 and x86 hosts are.  This
+ * file only uses the C library, build it with e.g.
+ *   gcc -O2 -o edf_trace_decode edf_trace_decode.c
+ * and run it as
+ *   edf_trace_decode [-l] [-w columns] dump.bin
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* Must match edf_trace.h. */
+#define decodeMAGIC					( 0x54464445UL )
+#define decodeVERSION				( 1U )
+#define decodeHEADER_SIZE			( 24U )
+#define decodeRECORD_SIZE			( 8U )
+
+#define decodeEVENT_SWITCHED_IN		( 1U )
+#define decodeEVENT_SWITCHED_OUT	( 2U )
+#define decodeEVENT_RELEASE			( 3U )
+#define decodeEVENT_DEADLINE		( 4U )
+#define decodeEVENT_MISS			( 5U )
+#define decodeEVENT_ISR_ENTER		( 6U )
+#define decodeEVENT_ISR_EXIT		( 7U )
+
+/* Ids are 8 bits wide, tasks and interrupts each have their own range. */
+#define decodeMAX_IDS				( 256U )
+
+#define decodeDEFAULT_COLUMNS		( 100U )
+
+/* Characters used in the timeline. */
+#define decodeGANTT_IDLE			'.'
+#define decodeGANTT_RUNNING			'#'
+#define decodeGANTT_RELEASE			'^'
+#define decodeGANTT_MISS			'!'
+
+typedef struct DECODED_RECORD
+{
+	uint64_t ullTime;			/*< Timestamp with wraps of the 32 bit counter removed. */
+	uint8_t ucEvent;
+	uint8_t ucId;
+	uint16_t usData;
+} DecodedRecord_t;
+
+typedef struct TASK_STATISTICS
+{
+	int iSeen;					/*< Non zero once any record of the task was read. */
+	int iRunning;				/*< Non zero between a switch in and its switch out. */
+	uint64_t ullSwitchedIn;		/*< Time of the last switch in. */
+	uint64_t ullRunTime;		/*< Total time spent running. */
+	int iJobOpen;				/*< Non zero once the first release was seen. */
+	uint64_t ullRelease;		/*< Nominal release of the current job. */
+	uint64_t ullDeadline;		/*< Absolute deadline of the current job. */
+	uint64_t ullLastOut;		/*< Last switch out of the current job. */
+	unsigned long ulJobs;		/*< Completed jobs measured. */
+	uint64_t ullMinResponse;
+	uint64_t ullMaxResponse;
+	uint64_t ullTotalResponse;
+	unsigned long ulLateJobs;	/*< Measured jobs that completed after their deadline. */
+	unsigned long ulMisses;		/*< MISS records. */
+	uint64_t ullMaxLateness;	/*< Largest lateness of a MISS record, in ticks. */
+} TaskStatistics_t;
+
+static uint32_t ulTimestampHz;
+static uint32_t ulTickRateHz;
+
+static TaskStatistics_t xTasks[ decodeMAX_IDS ];
+static int iInterruptSeen[ decodeMAX_IDS ];
+
+/*
+ * Read a little endian value from a byte buffer.
+ */
+static uint32_t prvRead32( const uint8_t *pucBytes );
+static uint16_t prvRead16( const uint8_t *pucBytes );
+
+/*
+ * Timestamp clock cycles in one tick, used to convert tick counts in the data
+ * field of records into timestamps.
+ */
+static uint64_t prvTickLength( void );
+
+/*
+ * Convert a time in timestamp clock cycles into microseconds.
+ */
+static double prvToMicroseconds( uint64_t ullTime );
+
+static const char *prvEventName( uint8_t ucEvent );
+
+/*
+ * Account for one record in the statistics of its task.
+ */
+static void prvUpdateStatistics( const DecodedRecord_t *pxRecord );
+
+static void prvPrintRecords( const DecodedRecord_t *pxRecords, size_t xCount );
+static void prvPrintGantt( const DecodedRecord_t *pxRecords, size_t xCount, unsigned long ulColumns );
+static void prvPrintStatistics( void );
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRead32( const uint8_t *pucBytes )
+{
+	return ( uint32_t ) pucBytes[ 0 ] |
+		   ( ( uint32_t ) pucBytes[ 1 ] << 8 ) |
+		   ( ( uint32_t ) pucBytes[ 2 ] << 16 ) |
+		   ( ( uint32_t ) pucBytes[ 3 ] << 24 );
+}
+/*-----------------------------------------------------------*/
+
+static uint16_t prvRead16( const uint8_t *pucBytes )
+{
+	return ( uint16_t ) ( ( uint16_t ) pucBytes[ 0 ] | ( ( uint16_t ) pucBytes[ 1 ] << 8 ) );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvTickLength( void )
+{
+uint64_t ullLength = 1ULL;
+
+	if( ( ulTimestampHz != 0UL ) && ( ulTickRateHz != 0UL ) )
+	{
+		ullLength = ( uint64_t ) ulTimestampHz / ( uint64_t ) ulTickRateHz;
+	}
+
+	return ( ullLength == 0ULL ) ? 1ULL : ullLength;
+}
+/*-----------------------------------------------------------*/
+
+static double prvToMicroseconds( uint64_t ullTime )
+{
+	if( ulTimestampHz == 0UL )
+	{
+		/* Unknown clock, report raw counts. */
+		return ( double ) ullTime;
+	}
+
+	return ( ( double ) ullTime * 1000000.0 ) / ( double ) ulTimestampHz;
+}
+/*-----------------------------------------------------------*/
+
+static const char *prvEventName( uint8_t ucEvent )
+{
+	switch( ucEvent )
+	{
+		case decodeEVENT_SWITCHED_IN:	return "IN";
+		case decodeEVENT_SWITCHED_OUT:	return "OUT";
+		case decodeEVENT_RELEASE:		return "RELEASE";
+		case decodeEVENT_DEADLINE:		return "DEADLINE";
+		case decodeEVENT_MISS:			return "MISS";
+		case decodeEVENT_ISR_ENTER:		return "ISR_ENTER";
+		case decodeEVENT_ISR_EXIT:		return "ISR_EXIT";
+		default:						return "?";
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvUpdateStatistics( const DecodedRecord_t *pxRecord )
+{
+TaskStatistics_t *pxTask = &( xTasks[ pxRecord->ucId ] );
+uint64_t ullTickLength = prvTickLength();
+uint64_t ullRelease, ullResponse;
+
+	switch( pxRecord->ucEvent )
+	{
+		case decodeEVENT_SWITCHED_IN:
+			pxTask->iSeen = 1;
+			pxTask->iRunning = 1;
+			pxTask->ullSwitchedIn = pxRecord->ullTime;
+			break;
+
+		case decodeEVENT_SWITCHED_OUT:
+			pxTask->iSeen = 1;
+			if( pxTask->iRunning != 0 )
+			{
+				pxTask->ullRunTime += pxRecord->ullTime - pxTask->ullSwitchedIn;
+				pxTask->iRunning = 0;
+			}
+			pxTask->ullLastOut = pxRecord->ullTime;
+			break;
+
+		case decodeEVENT_RELEASE:
+			pxTask->iSeen = 1;
+			ullRelease = ( uint64_t ) pxRecord->usData * ullTickLength;
+			ullRelease = ( ullRelease > pxRecord->ullTime ) ? 0ULL : ( pxRecord->ullTime - ullRelease );
+
+			/* A task made ready again within its job, for example after
+			blocking on a queue, reports the release of the same job.  Only a
+			release at least a tick later starts a new job. */
+			if( ( pxTask->iJobOpen != 0 ) && ( ullRelease < ( pxTask->ullRelease + ullTickLength ) ) )
+			{
+				break;
+			}
+
+			if( ( pxTask->iJobOpen != 0 ) && ( pxTask->ullLastOut > pxTask->ullRelease ) )
+			{
+				ullResponse = pxTask->ullLastOut - pxTask->ullRelease;
+
+				if( ( pxTask->ulJobs == 0UL ) || ( ullResponse < pxTask->ullMinResponse ) )
+				{
+					pxTask->ullMinResponse = ullResponse;
+				}
+
+				if( ullResponse > pxTask->ullMaxResponse )
+				{
+					pxTask->ullMaxResponse = ullResponse;
+				}
+
+				if( pxTask->ullLastOut > pxTask->ullDeadline )
+				{
+					pxTask->ulLateJobs++;
+				}
+
+				pxTask->ullTotalResponse += ullResponse;
+				pxTask->ulJobs++;
+			}
+
+			pxTask->iJobOpen = 1;
+			pxTask->ullRelease = ullRelease;
+			pxTask->ullDeadline = UINT64_MAX;
+			break;
+
+		case decodeEVENT_DEADLINE:
+			pxTask->iSeen = 1;
+			pxTask->ullDeadline = pxRecord->ullTime + ( ( uint64_t ) pxRecord->usData * ullTickLength );
+			break;
+
+		case decodeEVENT_MISS:
+			pxTask->iSeen = 1;
+			pxTask->ulMisses++;
+			if( ( uint64_t ) pxRecord->usData > pxTask->ullMaxLateness )
+			{
+				pxTask->ullMaxLateness = ( uint64_t ) pxRecord->usData;
+			}
+			break;
+
+		case decodeEVENT_ISR_ENTER:
+		case decodeEVENT_ISR_EXIT:
+			iInterruptSeen[ pxRecord->ucId ] = 1;
+			break;
+
+		default:
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintRecords( const DecodedRecord_t *pxRecords, size_t xCount )
+{
+size_t x;
+
+	printf( "%14s  %-10s %4s %6s\n", "time us", "event", "id", "data" );
+
+	for( x = 0; x < xCount; x++ )
+	{
+		printf( "%14.1f  %-10s %4u %6u\n",
+				prvToMicroseconds( pxRecords[ x ].ullTime - pxRecords[ 0 ].ullTime ),
+				prvEventName( pxRecords[ x ].ucEvent ),
+				( unsigned ) pxRecords[ x ].ucId,
+				( unsigned ) pxRecords[ x ].usData );
+	}
+
+	printf( "\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintGantt( const DecodedRecord_t *pxRecords, size_t xCount, unsigned long ulColumns )
+{
+uint64_t ullStart = pxRecords[ 0 ].ullTime;
+uint64_t ullSpan = pxRecords[ xCount - 1 ].ullTime - ullStart + 1ULL;
+char *pcRow;
+size_t x;
+unsigned long ulColumn, ulFirst, ulLast;
+unsigned uxId;
+int iInterrupts;
+uint64_t ullRunStart;
+int iRunning;
+
+	pcRow = ( char * ) malloc( ulColumns + 1UL );
+	if( pcRow == NULL )
+	{
+		return;
+	}
+
+	printf( "Timeline, %.1f us per column, '%c' running, '%c' released, '%c' deadline missed\n",
+			prvToMicroseconds( ullSpan ) / ( double ) ulColumns,
+			decodeGANTT_RUNNING, decodeGANTT_RELEASE, decodeGANTT_MISS );
+
+	/* Tasks are rows with id 0 to 255, interrupts rows with id 256 to 511. */
+	for( iInterrupts = 0; iInterrupts < 2; iInterrupts++ )
+	{
+		for( uxId = 0; uxId < decodeMAX_IDS; uxId++ )
+		{
+			if( ( ( iInterrupts == 0 ) && ( xTasks[ uxId ].iSeen == 0 ) ) ||
+				( ( iInterrupts != 0 ) && ( iInterruptSeen[ uxId ] == 0 ) ) )
+			{
+				continue;
+			}
+
+			memset( pcRow, decodeGANTT_IDLE, ulColumns );
+			pcRow[ ulColumns ] = '\0';
+
+			/* A task already running when the buffer starts is drawn from
+			the first record. */
+			iRunning = 0;
+			ullRunStart = ullStart;
+
+			for( x = 0; x < xCount; x++ )
+			{
+				if( pxRecords[ x ].ucId != uxId )
+				{
+					continue;
+				}
+
+				ulColumn = ( unsigned long ) ( ( ( pxRecords[ x ].ullTime - ullStart ) * ulColumns ) / ullSpan );
+
+				if( iInterrupts != 0 )
+				{
+					if( pxRecords[ x ].ucEvent == decodeEVENT_ISR_ENTER )
+					{
+						iRunning = 1;
+						ullRunStart = pxRecords[ x ].ullTime;
+					}
+					else if( ( pxRecords[ x ].ucEvent == decodeEVENT_ISR_EXIT ) && ( iRunning != 0 ) )
+					{
+						ulFirst = ( unsigned long ) ( ( ( ullRunStart - ullStart ) * ulColumns ) / ullSpan );
+						memset( &( pcRow[ ulFirst ] ), decodeGANTT_RUNNING, ( ulColumn - ulFirst ) + 1UL );
+						iRunning = 0;
+					}
+					continue;
+				}
+
+				switch( pxRecords[ x ].ucEvent )
+				{
+					case decodeEVENT_SWITCHED_IN:
+						iRunning = 1;
+						ullRunStart = pxRecords[ x ].ullTime;
+						break;
+
+					case decodeEVENT_SWITCHED_OUT:
+						ulFirst = ( unsigned long ) ( ( ( ullRunStart - ullStart ) * ulColumns ) / ullSpan );
+						for( ulLast = ulFirst; ulLast <= ulColumn; ulLast++ )
+						{
+							if( pcRow[ ulLast ] == decodeGANTT_IDLE )
+							{
+								pcRow[ ulLast ] = decodeGANTT_RUNNING;
+							}
+						}
+						iRunning = 0;
+						break;
+
+					case decodeEVENT_RELEASE:
+						pcRow[ ulColumn ] = decodeGANTT_RELEASE;
+						break;
+
+					case decodeEVENT_MISS:
+						pcRow[ ulColumn ] = decodeGANTT_MISS;
+						break;
+
+					default:
+						break;
+				}
+			}
+
+			if( iRunning != 0 )
+			{
+				ulFirst = ( unsigned long ) ( ( ( ullRunStart - ullStart ) * ulColumns ) / ullSpan );
+				for( ulLast = ulFirst; ulLast < ulColumns; ulLast++ )
+				{
+					if( pcRow[ ulLast ] == decodeGANTT_IDLE )
+					{
+						pcRow[ ulLast ] = decodeGANTT_RUNNING;
+					}
+				}
+			}
+
+			printf( "%s %3u |%s|\n", ( iInterrupts == 0 ) ? "task" : "irq ", uxId, pcRow );
+		}
+	}
+
+	printf( "\n" );
+	free( pcRow );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintStatistics( void )
+{
+unsigned uxId;
+const TaskStatistics_t *pxTask;
+
+	printf( "%4s %6s %12s %12s %12s %6s %6s %8s %12s\n",
+			"task", "jobs", "min resp us", "avg resp us", "max resp us", "late", "misses", "max late", "run us" );
+
+	for( uxId = 0; uxId < decodeMAX_IDS; uxId++ )
+	{
+		pxTask = &( xTasks[ uxId ] );
+
+		if( pxTask->iSeen == 0 )
+		{
+			continue;
+		}
+
+		if( pxTask->ulJobs == 0UL )
+		{
+			printf( "%4u %6lu %12s %12s %12s %6lu %6lu %8lu %12.1f\n",
+					uxId, 0UL, "-", "-", "-", 0UL, pxTask->ulMisses,
+					( unsigned long ) pxTask->ullMaxLateness, prvToMicroseconds( pxTask->ullRunTime ) );
+		}
+		else
+		{
+			printf( "%4u %6lu %12.1f %12.1f %12.1f %6lu %6lu %8lu %12.1f\n",
+					uxId, pxTask->ulJobs,
+					prvToMicroseconds( pxTask->ullMinResponse ),
+					prvToMicroseconds( pxTask->ullTotalResponse ) / ( double ) pxTask->ulJobs,
+					prvToMicroseconds( pxTask->ullMaxResponse ),
+					pxTask->ulLateJobs, pxTask->ulMisses,
+					( unsigned long ) pxTask->ullMaxLateness, prvToMicroseconds( pxTask->ullRunTime ) );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+const char *pcFileName = NULL;
+unsigned long ulColumns = decodeDEFAULT_COLUMNS;
+int iList = 0, iArg;
+FILE *pxFile;
+uint8_t ucHeader[ decodeHEADER_SIZE ];
+uint8_t *pucRecords;
+DecodedRecord_t *pxRecords;
+uint32_t ulLength, ulHead, ulFirst, ulRecorded, ul, ulLastTimestamp = 0UL, ulTimestamp;
+uint64_t ullTime = 0ULL;
+size_t xCount = 0;
+const uint8_t *pucRecord;
+
+	for( iArg = 1; iArg < argc; iArg++ )
+	{
+		if( strcmp( argv[ iArg ], "-l" ) == 0 )
+		{
+			iList = 1;
+		}
+		else if( ( strcmp( argv[ iArg ], "-w" ) == 0 ) && ( ( iArg + 1 ) < argc ) )
+		{
+			ulColumns = strtoul( argv[ ++iArg ], NULL, 10 );
+		}
+		else
+		{
+			pcFileName = argv[ iArg ];
+		}
+	}
+
+	if( ( pcFileName == NULL ) || ( ulColumns == 0UL ) )
+	{
+		fprintf( stderr, "usage: %s [-l] [-w columns] dump.bin\n", argv[ 0 ] );
+		return 2;
+	}
+
+	pxFile = fopen( pcFileName, "rb" );
+	if( pxFile == NULL )
+	{
+		perror( pcFileName );
+		return 1;
+	}
+
+	if( fread( ucHeader, sizeof( ucHeader ), 1, pxFile ) != 1 )
+	{
+		fprintf( stderr, "%s: too short for a trace header\n", pcFileName );
+		fclose( pxFile );
+		return 1;
+	}
+
+	if( ( prvRead32( &( ucHeader[ 0 ] ) ) != decodeMAGIC ) ||
+		( prvRead16( &( ucHeader[ 4 ] ) ) != decodeVERSION ) ||
+		( prvRead16( &( ucHeader[ 6 ] ) ) != decodeRECORD_SIZE ) )
+	{
+		fprintf( stderr, "%s: not a version %u EDF trace dump\n", pcFileName, decodeVERSION );
+		fclose( pxFile );
+		return 1;
+	}
+
+	ulLength = prvRead32( &( ucHeader[ 8 ] ) );
+	ulTimestampHz = prvRead32( &( ucHeader[ 12 ] ) );
+	ulTickRateHz = prvRead32( &( ucHeader[ 16 ] ) );
+	ulHead = prvRead32( &( ucHeader[ 20 ] ) );
+
+	pucRecords = ( uint8_t * ) malloc( ( size_t ) ulLength * decodeRECORD_SIZE );
+	pxRecords = ( DecodedRecord_t * ) malloc( ( size_t ) ulLength * sizeof( DecodedRecord_t ) );
+
+	if( ( ulLength == 0UL ) || ( pucRecords == NULL ) || ( pxRecords == NULL ) ||
+		( fread( pucRecords, decodeRECORD_SIZE, ulLength, pxFile ) != ulLength ) )
+	{
+		fprintf( stderr, "%s: truncated record buffer\n", pcFileName );
+		fclose( pxFile );
+		return 1;
+	}
+
+	fclose( pxFile );
+
+	/* Once the buffer has wrapped the oldest record is the one the next event
+	would overwrite. */
+	if( ulHead > ulLength )
+	{
+		ulRecorded = ulLength;
+		ulFirst = ulHead % ulLength;
+	}
+	else
+	{
+		ulRecorded = ulHead;
+		ulFirst = 0UL;
+	}
+
+	for( ul = 0UL; ul < ulRecorded; ul++ )
+	{
+		pucRecord = &( pucRecords[ ( size_t ) ( ( ulFirst + ul ) % ulLength ) * decodeRECORD_SIZE ] );
+
+		/* A slot claimed but not yet written when the dump was taken. */
+		if( ( pucRecord[ 4 ] < decodeEVENT_SWITCHED_IN ) || ( pucRecord[ 4 ] > decodeEVENT_ISR_EXIT ) )
+		{
+			continue;
+		}
+
+		/* The counter is 32 bits, a timestamp lower than the previous one
+		means it wrapped. */
+		ulTimestamp = prvRead32( pucRecord );
+		ullTime += ( uint64_t ) ( uint32_t ) ( ulTimestamp - ulLastTimestamp );
+		if( xCount == 0 )
+		{
+			ullTime = ( uint64_t ) ulTimestamp;
+		}
+		ulLastTimestamp = ulTimestamp;
+
+		pxRecords[ xCount ].ullTime = ullTime;
+		pxRecords[ xCount ].ucEvent = pucRecord[ 4 ];
+		pxRecords[ xCount ].ucId = pucRecord[ 5 ];
+		pxRecords[ xCount ].usData = prvRead16( &( pucRecord[ 6 ] ) );
+		prvUpdateStatistics( &( pxRecords[ xCount ] ) );
+		xCount++;
+	}
+
+	printf( "%lu events recorded, %lu in the buffer, timestamp clock %lu Hz, tick %lu Hz\n\n",
+			( unsigned long ) ulHead, ( unsigned long ) xCount,
+			( unsigned long ) ulTimestampHz, ( unsigned long ) ulTickRateHz );
+
+	if( xCount > 0 )
+	{
+		if( iList != 0 )
+		{
+			prvPrintRecords( pxRecords, xCount );
+		}
+
+		prvPrintGantt( pxRecords, xCount, ulColumns );
+		prvPrintStatistics();
+	}
+
+	free( pucRecords );
+	free( pxRecords );
+
+	return 0;
+}
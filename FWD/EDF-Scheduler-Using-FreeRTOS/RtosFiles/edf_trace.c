@@ -0,0 +1,51 @@
+/*
+ * Binary scheduler event trace for the EDF kernel, see edf_trace.h.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "edf_trace.h"
+
+#if ( configUSE_EDF_TRACE == 1 )
+
+#if ( ( configEDF_TRACE_BUFFER_LENGTH & ( configEDF_TRACE_BUFFER_LENGTH - 1 ) ) != 0 )
+	#error configEDF_TRACE_BUFFER_LENGTH must be a power of two
+#endif
+
+EdfTraceBuffer_t xEdfTraceBuffer =
+{
+	edftraceMAGIC,
+	edftraceVERSION,
+	( uint16_t ) sizeof( EdfTraceRecord_t ),
+	configEDF_TRACE_BUFFER_LENGTH,
+	configEDF_TRACE_TIMESTAMP_HZ,
+	configTICK_RATE_HZ,
+	0UL,
+	{ { 0UL, 0U, 0U, 0U } }
+};
+/*-----------------------------------------------------------*/
+
+void vEdfTraceRecord( uint8_t ucEvent, uint8_t ucId, uint16_t usData )
+{
+EdfTraceRecord_t *pxRecord;
+UBaseType_t uxSavedInterruptStatus;
+uint32_t ulTimestamp;
+
+	/* Only claiming the slot has to be atomic.  Once claimed the slot is
+	owned by this call, so nothing is held while the record is written.  The
+	timestamp is read in the same window so records stay in time order. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxRecord = &( xEdfTraceBuffer.xRecords[ xEdfTraceBuffer.ulHead & ( configEDF_TRACE_BUFFER_LENGTH - 1UL ) ] );
+		xEdfTraceBuffer.ulHead++;
+		ulTimestamp = ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE();
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	pxRecord->ulTimestamp = ulTimestamp;
+	pxRecord->ucEvent = ucEvent;
+	pxRecord->ucId = ucId;
+	pxRecord->usData = usData;
+}
+
+#endif /* configUSE_EDF_TRACE */
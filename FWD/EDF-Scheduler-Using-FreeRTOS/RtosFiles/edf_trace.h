@@ -0,0 +1,102 @@
+/*
+ * Binary scheduler event trace for the EDF kernel.
+ *
+ * Events are written as 8 byte records into a fixed size ring buffer that
+ * always holds the most recent configEDF_TRACE_BUFFER_LENGTH events.  The
+ * buffer starts with a header describing itself, so a raw dump of
+ * xEdfTraceBuffer taken with a debugger, or written out by the simulator, can
+ * be decoded on the host by Tools/edf_trace_decode.c without any other
+ * information from the build.
+ *
+ * Timestamps are taken from portGET_RUN_TIME_COUNTER_VALUE().  The data field
+ * of each record depends on the event:
+ *   SWITCHED_IN, SWITCHED_OUT   unused.
+ *   RELEASE                     ticks between the nominal release of the job
+ *                               and the tick at which it was made ready.
+ *   DEADLINE                    ticks from the recording to the absolute
+ *                               deadline of the job.
+ *   MISS                        lateness of the job in ticks.
+ *   ISR_ENTER, ISR_EXIT         unused, the id is the interrupt number.
+ * For task events the id is the uxTCBNumber of the task.  Values that do not
+ * fit in 16 bits are saturated.
+ *
+ * This header is included by FreeRTOSConfig.h, the trace macros defined there
+ * record the kernel events.  Application interrupts can be recorded with
+ * edftraceISR_ENTER() and edftraceISR_EXIT().
+ */
+
+#ifndef EDF_TRACE_H
+#define EDF_TRACE_H
+
+#include <stdint.h>
+
+#ifndef configUSE_EDF_TRACE
+	#define configUSE_EDF_TRACE 0
+#endif
+
+/* Must be a power of two. */
+#ifndef configEDF_TRACE_BUFFER_LENGTH
+	#define configEDF_TRACE_BUFFER_LENGTH 64
+#endif
+
+/* Frequency of the clock read by portGET_RUN_TIME_COUNTER_VALUE(). */
+#ifndef configEDF_TRACE_TIMESTAMP_HZ
+	#define configEDF_TRACE_TIMESTAMP_HZ 0
+#endif
+
+/* Header values, the magic number reads "EDFT" in a little endian dump. */
+#define edftraceMAGIC					( 0x54464445UL )
+#define edftraceVERSION					( 1U )
+
+/* Event codes. */
+#define edftraceEVENT_SWITCHED_IN		( 1U )
+#define edftraceEVENT_SWITCHED_OUT		( 2U )
+#define edftraceEVENT_RELEASE			( 3U )
+#define edftraceEVENT_DEADLINE			( 4U )
+#define edftraceEVENT_MISS				( 5U )
+#define edftraceEVENT_ISR_ENTER			( 6U )
+#define edftraceEVENT_ISR_EXIT			( 7U )
+
+typedef struct EDF_TRACE_RECORD
+{
+	uint32_t ulTimestamp;		/*< portGET_RUN_TIME_COUNTER_VALUE() when the event was recorded. */
+	uint8_t ucEvent;			/*< One of the edftraceEVENT_ codes. */
+	uint8_t ucId;				/*< Task number, or interrupt number for interrupt events. */
+	uint16_t usData;			/*< Event specific data, see the top of this file. */
+} EdfTraceRecord_t;
+
+typedef struct EDF_TRACE_BUFFER
+{
+	uint32_t ulMagic;			/*< edftraceMAGIC. */
+	uint16_t usVersion;			/*< edftraceVERSION. */
+	uint16_t usRecordSize;		/*< sizeof( EdfTraceRecord_t ). */
+	uint32_t ulLength;			/*< Number of records in xRecords. */
+	uint32_t ulTimestampHz;		/*< Frequency of the timestamp clock. */
+	uint32_t ulTickRateHz;		/*< configTICK_RATE_HZ. */
+	volatile uint32_t ulHead;	/*< Number of events recorded so far, the next record is written to xRecords[ ulHead % ulLength ]. */
+	EdfTraceRecord_t xRecords[ configEDF_TRACE_BUFFER_LENGTH ];
+} EdfTraceBuffer_t;
+
+#if ( configUSE_EDF_TRACE == 1 )
+
+	extern EdfTraceBuffer_t xEdfTraceBuffer;
+
+	void vEdfTraceRecord( uint8_t ucEvent, uint8_t ucId, uint16_t usData );
+
+	/* Saturate a tick difference into the 16 bit data field. */
+	#define edftraceCLAMP( xValue )		( ( ( int32_t ) ( xValue ) < 0 ) ? ( uint16_t ) 0U : ( ( ( uint32_t ) ( xValue ) > 0xFFFFUL ) ? ( uint16_t ) 0xFFFFU : ( uint16_t ) ( xValue ) ) )
+
+	#define edftraceRECORD( ucEvent, uxId, usData )	vEdfTraceRecord( ( uint8_t ) ( ucEvent ), ( uint8_t ) ( uxId ), ( uint16_t ) ( usData ) )
+	#define edftraceISR_ENTER( uxInterrupt )		edftraceRECORD( edftraceEVENT_ISR_ENTER, ( uxInterrupt ), 0U )
+	#define edftraceISR_EXIT( uxInterrupt )			edftraceRECORD( edftraceEVENT_ISR_EXIT, ( uxInterrupt ), 0U )
+
+#else
+
+	#define edftraceCLAMP( xValue )		( 0U )
+	#define edftraceRECORD( ucEvent, uxId, usData )
+	#define edftraceISR_ENTER( uxInterrupt )
+	#define edftraceISR_EXIT( uxInterrupt )
+
+#endif /* configUSE_EDF_TRACE */
+
+#endif /* EDF_TRACE_H */
@@ -79,13 +79,89 @@
 /*--------------------------------*/
 
 
-#define Button_1_Monitor_PERIOD 		50		//task 1 Period
-#define Button_2_Monitor_PERIOD 		50		//task 2 Period
 #define Periodic_Transmitter_PERIOD 100			//task 3 Period
 #define Uart_Receiver_PERIOD 				20			//task 4 Period
 #define Load_1_Simulation_PERIOD 		10			//task 5 Period
 #define Load_2_Simulation_PERIOD 		100			//task 6 Period
 
+/* Worst case execution times in ticks, rounded up, used by the admission test.
+They are also the execution budgets the kernel charges each job against, so the
+load tasks get a tick of margin over their measured time for the kernel time
+charged to them */
+#define Periodic_Transmitter_WCET 	1			//task 3 measured 20.3Us
+#define Uart_Receiver_WCET 					1			//task 4 measured 26Us
+#define Load_1_Simulation_WCET 			6			//task 5 measured 5ms
+#define Load_2_Simulation_WCET 			13			//task 6 measured 12ms
+
+/* Button edges are not polled by periodic tasks, the tick hook samples the pins
+and each edge releases a job of the monitor of that button.  The monitors are
+sporadic tasks, admitted for one edge every INTERARRIVAL ticks at most, and the
+kernel defers an edge that comes sooner */
+#define Button_1_Monitor_INTERARRIVAL	20			//task 1 minimum time between edges
+#define Button_2_Monitor_INTERARRIVAL	20			//task 2 minimum time between edges
+#define Button_1_Monitor_WCET 			1			//task 1 measured 13.3Us
+#define Button_2_Monitor_WCET 			1			//task 2 measured 13.3Us
+
+/* A button must read the same level for this many ticks to make an edge */
+#define mainDEBOUNCE_TICKS					3
+
+/* Event group bits set by the button monitors */
+#define mainBUTTON_RISING_BIT				( 1 << 0 )
+#define mainBUTTON_FALLING_BIT				( 1 << 1 )
+
+/* Relative deadlines shorter than the period, the other tasks use their period */
+#define Button_1_Monitor_DEADLINE 		5			//task 1 Deadline
+#define Button_2_Monitor_DEADLINE 		5			//task 2 Deadline
+#define Uart_Receiver_DEADLINE 			5			//task 4 Deadline
+
+/* Stack size in words of every application task */
+#define mainTASK_STACK_SIZE					100
+
+/* With static allocation the tasks use the buffers declared below, named after
+the task function, and creating them never touches the heap */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define mainCREATE_TASK( task, name, period, deadline, wcet )	xTaskPeriodicCreateStatic( task, name, mainTASK_STACK_SIZE, ( void * )0, 0, task##_Stack, &task##_TCB, &task##_Handler, period, deadline, wcet )
+	#define mainCREATE_SPORADIC( task, name, interarrival, deadline, wcet )	xTaskSporadicCreateStatic( task, name, mainTASK_STACK_SIZE, ( void * )0, 0, task##_Stack, &task##_TCB, &task##_Handler, interarrival, deadline, wcet )
+	#define mainCREATE_JOB_SERVER( server, name )		xTaskJobServerCreateStatic( name, mainTASK_STACK_SIZE, 0, 0, server##_Stack, &server##_TCB, &server##_Handler )
+	#define mainCREATE_JOB( job, period, deadline, wcet )	xTaskJobCreateStatic( job, ( void * )0, period, deadline, wcet, &job##_Job )
+#else
+	#define mainCREATE_TASK( task, name, period, deadline, wcet )	xTaskPeriodicCreateWithDeadline( task, name, mainTASK_STACK_SIZE, ( void * )0, 0, &task##_Handler, period, deadline, wcet )
+	#define mainCREATE_SPORADIC( task, name, interarrival, deadline, wcet )	xTaskSporadicCreate( task, name, mainTASK_STACK_SIZE, ( void * )0, 0, &task##_Handler, interarrival, deadline, wcet )
+	#define mainCREATE_JOB_SERVER( server, name )		xTaskJobServerCreate( name, mainTASK_STACK_SIZE, 0, 0, &server##_Handler )
+	#define mainCREATE_JOB( job, period, deadline, wcet )	xTaskJobCreate( job, ( void * )0, period, deadline, wcet )
+#endif
+
+/* On the host simulator the busy loops below take no virtual time, so charge
+the execution time measured on the board instead */
+#ifdef POSIX_SIMULATOR
+	#define mainSIMULATE_EXECUTION( us )		vPortSimulateExecution( us )
+#else
+	#define mainSIMULATE_EXECUTION( us )
+#endif
+
+/* Microseconds in a count of timer 1, which runs at the bus clock / 1001 */
+#define mainT1TC_TO_US( count )		( ( unsigned long ) ( ( ( unsigned long long ) ( count ) * 1001ULL * 1000000ULL ) / configCPU_CLOCK_HZ ) )
+
+/* The simulator traces the latency of button edges */
+#ifdef POSIX_SIMULATOR
+	#define mainTRACE_EDGE( pin, rising, latency )	vPortSimulationTrace( "EDGE P0.%d %s latency %lu us\n", ( int ) ( pin ), ( rising ) ? "rising" : "falling", mainT1TC_TO_US( latency ) )
+#else
+	#define mainTRACE_EDGE( pin, rising, latency )
+#endif
+
+
+/* Debounce state of a button, sampled on every tick.  xLevel is the level the
+button settled at on the last edge, and ulEdgeTime is T1TC when that edge
+released the monitor */
+typedef struct BUTTON
+{
+	pinX_t xPin;
+	int counter;
+	EventGroupHandle_t xEvents;
+	TaskHandle_t xMonitor;
+	pinState_t xLevel;
+	unsigned long ulEdgeTime;
+} Button_t;
 
 /*
  * Configure the processor for use with the Keil demo board.  This is very
@@ -93,6 +169,10 @@
  * file.
  */
 static void prvSetupHardware( void );
+static int prvGetDeadlineMisses( void );
+static int prvGetCpuLoad( void );
+static void prvSampleButton( Button_t *button );
+static void prvMonitorButton( Button_t *button );
 void Button_1_Monitor(void *pvParameters);
 void Button_2_Monitor(void *pvParameters);
 void Periodic_Transmitter(void *pvParameters);
@@ -105,21 +185,52 @@ void Load_2_Simulation(void *pvParameters);
 
 TaskHandle_t Button_1_Monitor_Handler = NULL;
 TaskHandle_t Button_2_Monitor_Handler = NULL;
-TaskHandle_t Periodic_Transmitter_Handler = NULL;
+TaskHandle_t Job_Server_Handler = NULL;
 TaskHandle_t Uart_Receiver_Handler = NULL;
 TaskHandle_t Load_1_Simulation_Handler = NULL;
 TaskHandle_t Load_2_Simulation_Handler = NULL;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+/* TCB and stack of every task, including the idle task */
+static StaticTask_t Button_1_Monitor_TCB;
+static StaticTask_t Button_2_Monitor_TCB;
+static StaticTask_t Job_Server_TCB;
+static StaticTask_t Uart_Receiver_TCB;
+static StaticTask_t Load_1_Simulation_TCB;
+static StaticTask_t Load_2_Simulation_TCB;
+static StaticTask_t Idle_TCB;
+static StackType_t Button_1_Monitor_Stack[mainTASK_STACK_SIZE];
+static StackType_t Button_2_Monitor_Stack[mainTASK_STACK_SIZE];
+static StackType_t Job_Server_Stack[mainTASK_STACK_SIZE];
+static StackType_t Uart_Receiver_Stack[mainTASK_STACK_SIZE];
+static StackType_t Load_1_Simulation_Stack[mainTASK_STACK_SIZE];
+static StackType_t Load_2_Simulation_Stack[mainTASK_STACK_SIZE];
+static StackType_t Idle_Stack[configMINIMAL_STACK_SIZE];
+static StaticEventGroup_t Button_Events_Buffer[2];
+static StaticQueue_t UART_Queue_Buffer;
+static uint8_t UART_Queue_Storage[sizeof(char *)];
+/* A job only needs this, it runs on the stack of the job server */
+static StaticJob_t Periodic_Transmitter_Job;
+#endif
+
 /*-----------------------------------------------------------*/
 QueueSetHandle_t UART_Queue = NULL;
 
-int task_1_in_time = 0, task_1_out_time = 0, task_1_total_time;
-int task_2_in_time = 0, task_2_out_time = 0, task_2_total_time;
-int task_3_in_time = 0, task_3_out_time = 0, task_3_total_time;
-int task_4_in_time = 0, task_4_out_time = 0, task_4_total_time;
-int task_5_in_time = 0, task_5_out_time = 0, task_5_total_time;
-int task_6_in_time = 0, task_6_out_time = 0, task_6_total_time;
-int system_time = 0;
+/* Trace records, the tag of task N points at task_traces[N - 1] and task N
+drives pin N + 1 of port 0 while it runs */
+TaskTrace_t task_traces[] = {
+	{ PIN2, 0, 0, 0 },
+	{ PIN3, 0, 0, 0 },
+	{ PIN4, 0, 0, 0 },
+	{ PIN5, 0, 0, 0 },
+	{ PIN6, 0, 0, 0 },
+	{ PIN7, 0, 0, 0 }
+};
+
+Button_t buttons[] = {
+	{ PIN9, 0, NULL, NULL, PIN_IS_LOW, 0 },
+	{ PIN8, 0, NULL, NULL, PIN_IS_LOW, 0 }
+};
 int cpu_load = 0;
 
 
@@ -136,62 +247,34 @@ int main( void )
 	/* Setup the hardware for use with the Keil demo board. */
 	prvSetupHardware();
 
-	
-  /* Create Tasks here */
-  /* Create the task, storing the handle. */
-  xTaskPeriodicCreate(
-                    Button_1_Monitor,       /* Function that implements the task. */
-                    "First Task",          /* Text name for the task. */
-                    100,      /* Stack size in words, not bytes. */
-                    ( void * )0,    /* Parameter passed into the task. */
-                    0,/* Priority at which the task is created. */
-                    &Button_1_Monitor_Handler,
-										Button_1_Monitor_PERIOD);      /* Used to pass out the created task's handle. */
-
-  xTaskPeriodicCreate(
-                    Button_2_Monitor,       /* Function that implements the task. */
-                    "Second Task",          /* Text name for the task. */
-                    100,      /* Stack size in words, not bytes. */
-                    ( void * )0,    /* Parameter passed into the task. */
-                    0,/* Priority at which the task is created. */
-                    &Button_2_Monitor_Handler ,
-										Button_2_Monitor_PERIOD);      /* Used to pass out the created task's handle. */
-
-	xTaskPeriodicCreate(
-                    Periodic_Transmitter,       /* Function that implements the task. */
-                    "Third Task",          /* Text name for the task. */
-                    100,      /* Stack size in words, not bytes. */
-                    ( void * )0,    /* Parameter passed into the task. */
-                    0,/* Priority at which the task is created. */
-                    &Periodic_Transmitter_Handler ,
-										Periodic_Transmitter_PERIOD);      /* Used to pass out the created task's handle. */
-
-	xTaskPeriodicCreate(
-                    Uart_Receiver,       /* Function that implements the task. */
-                    "Forth Task",          /* Text name for the task. */
-                    100,      /* Stack size in words, not bytes. */
-                    ( void * )0,    /* Parameter passed into the task. */
-                    0,/* Priority at which the task is created. */
-                    &Uart_Receiver_Handler ,
-										Uart_Receiver_PERIOD);      /* Used to pass out the created task's handle. */
-										
-	xTaskPeriodicCreate(
-                    Load_1_Simulation,       /* Function that implements the task. */
-                    "Fifth Task",          /* Text name for the task. */
-                    100,      /* Stack size in words, not bytes. */
-                    ( void * )0,    /* Parameter passed into the task. */
-                    0,/* Priority at which the task is created. */
-                    &Load_1_Simulation_Handler ,
-										Load_1_Simulation_PERIOD);      /* Used to pass out the created task's handle. */
-
-	xTaskPeriodicCreate(
-                    Load_2_Simulation,       /* Function that implements the task. */
-                    "Sixth Task",          /* Text name for the task. */
-                    100,      /* Stack size in words, not bytes. */
-                    ( void * )0,    /* Parameter passed into the task. */
-                    0,/* Priority at which the task is created. */
-                    &Load_2_Simulation_Handler ,
-										Load_2_Simulation_PERIOD);      /* Used to pass out the created task's handle. */
+	/* The events of each button are set by its monitor.  The queue from the
+	transmitter to the receiver is created here as the transmitter is a job that
+	returns at the end of each activation */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	buttons[0].xEvents = xEventGroupCreateStatic(&Button_Events_Buffer[0]);
+	buttons[1].xEvents = xEventGroupCreateStatic(&Button_Events_Buffer[1]);
+	UART_Queue = xQueueCreateStatic((UBaseType_t) 1, sizeof(char *), UART_Queue_Storage, &UART_Queue_Buffer);
+#else
+	buttons[0].xEvents = xEventGroupCreate();
+	buttons[1].xEvents = xEventGroupCreate();
+	UART_Queue = xQueueCreate((UBaseType_t) 1, sizeof(char *));
+#endif
+
+	/* Create Tasks here, storing the handles. Tasks without a deadline of their
+	own use their period */
+	mainCREATE_SPORADIC(Button_1_Monitor, "First Task", Button_1_Monitor_INTERARRIVAL, Button_1_Monitor_DEADLINE, Button_1_Monitor_WCET);
+	mainCREATE_SPORADIC(Button_2_Monitor, "Second Task", Button_2_Monitor_INTERARRIVAL, Button_2_Monitor_DEADLINE, Button_2_Monitor_WCET);
+	buttons[0].xMonitor = Button_1_Monitor_Handler;
+	buttons[1].xMonitor = Button_2_Monitor_Handler;
+	/* The transmitter never blocks, so it runs as a job of the job server,
+	which takes the trace record of task 3 */
+	mainCREATE_JOB_SERVER(Job_Server, "Third Task");
+	vTaskSetApplicationTaskTag(Job_Server_Handler, (TaskHookFunction_t) &task_traces[2]);
+	mainCREATE_JOB(Periodic_Transmitter, Periodic_Transmitter_PERIOD, Periodic_Transmitter_PERIOD, Periodic_Transmitter_WCET);
+	mainCREATE_TASK(Uart_Receiver, "Forth Task", Uart_Receiver_PERIOD, Uart_Receiver_DEADLINE, Uart_Receiver_WCET);
+	mainCREATE_TASK(Load_1_Simulation, "Fifth Task", Load_1_Simulation_PERIOD, Load_1_Simulation_PERIOD, Load_1_Simulation_WCET);
+	mainCREATE_TASK(Load_2_Simulation, "Sixth Task", Load_2_Simulation_PERIOD, Load_2_Simulation_PERIOD, Load_2_Simulation_WCET);
+
 										
 										
 /* Now all the tasks have been started - start the scheduler.
@@ -243,85 +326,73 @@ static void prvSetupHardware( void )
 /*-----------------------------------------------------------*/
 
 /*
-		Second task : Button_1_Monitor 
-		periodic: 50ms, execution : 13.3Us
-		the task sends a Button state every 50ms through an Event with hanler Button_1_Events
+		First task : Button_1_Monitor 
+		sporadic: an edge at most every 20ms, execution : 13.3Us
+		each edge of the button releases a job, which sets the rising or falling
+		bit in the events of the button
 */
 void Button_1_Monitor(void *pvParameters){
-	int counter = 0;
-	pinState_t state;
-	int xLastWakeTime = xTaskGetTickCount();
-	EventGroupHandle_t Button_1_Events = xEventGroupCreate();
-	vTaskSetApplicationTaskTag(NULL, (void*) 1);
-	for(;;){
-		state = GPIO_read(PORT_0, PIN9);
-		if(state == PIN_IS_HIGH && counter < 3){
-			counter++;
-			if(counter == 3){
-				// send the event of rising
-				xEventGroupSetBits(Button_1_Events, 0);
-			}
-		}else if(state == PIN_IS_LOW && counter > 1){
-			counter--;
-			if(counter == 0){
-				// send the event of falling
-				xEventGroupSetBits(Button_1_Events, 1);
-				
-			}
-		}
-		vTaskDelayUntil(&xLastWakeTime, Button_1_Monitor_PERIOD);
-	}
+	vTaskSetApplicationTaskTag(NULL, (TaskHookFunction_t) &task_traces[0]);
+	prvMonitorButton(&buttons[0]);
 }
 
 /*
 		Second task : Button_2_Monitor 
-		periodic: 50ms, execution : 13.3Us
-		the task sends a Button state every 50ms through an Event with hanler Button_2_Events
+		sporadic: an edge at most every 20ms, execution : 13.3Us
+		the same as the first task for the second button
 */
 void Button_2_Monitor(void *pvParameters){
-	int counter = 0;
-	pinState_t state;
-	int xLastWakeTime = xTaskGetTickCount();
-	EventGroupHandle_t Button_2_Events = xEventGroupCreate();
-	vTaskSetApplicationTaskTag(NULL, (void*) 2);
+	vTaskSetApplicationTaskTag(NULL, (TaskHookFunction_t) &task_traces[1]);
+	prvMonitorButton(&buttons[1]);
+}
+
+/* Body of both button monitors, one job for each edge */
+static void prvMonitorButton(Button_t *button){
 	for(;;){
-		state = GPIO_read(PORT_0, PIN8);
-		if(state == PIN_IS_HIGH && counter < 3){
-			counter++;
-			if(counter == 3){
-				// send the event of rising
-				xEventGroupSetBits(Button_2_Events, 0);
-			}
-		}else if(state == PIN_IS_LOW && counter > 0){
-			counter--;
-			if(counter == 0){
-				// send the event of falling
-				xEventGroupSetBits(Button_2_Events, 1);
-			}
+		/* Wait for the tick hook to release the next edge */
+		vTaskSporadicWait();
+		mainTRACE_EDGE(button->xPin, button->xLevel == PIN_IS_HIGH, T1TC - button->ulEdgeTime);
+		if(button->xLevel == PIN_IS_HIGH){
+			xEventGroupSetBits(button->xEvents, mainBUTTON_RISING_BIT);
+		}else{
+			xEventGroupSetBits(button->xEvents, mainBUTTON_FALLING_BIT);
+		}
+	}
+}
+
+/* Function called from the tick hook to debounce a button, an edge releases the
+monitor of the button straight away rather than being found by the next poll */
+static void prvSampleButton(Button_t *button){
+	pinState_t state = GPIO_read(PORT_0, button->xPin);
+	if(state == PIN_IS_HIGH && button->counter < mainDEBOUNCE_TICKS){
+		button->counter++;
+		if(button->counter == mainDEBOUNCE_TICKS){
+			button->xLevel = PIN_IS_HIGH;
+			button->ulEdgeTime = T1TC;
+			xTaskSporadicReleaseFromISR(button->xMonitor, NULL);
+		}
+	}else if(state == PIN_IS_LOW && button->counter > 0){
+		button->counter--;
+		if(button->counter == 0){
+			button->xLevel = PIN_IS_LOW;
+			button->ulEdgeTime = T1TC;
+			xTaskSporadicReleaseFromISR(button->xMonitor, NULL);
 		}
-		vTaskDelayUntil(&xLastWakeTime, Button_2_Monitor_PERIOD);
 	}
 }
 
 /*
 		Third task : Periodic_Transmitter 
-		periodic: 100ms, execution : 20.3Us
-		the task sends a string every 100ms through a queue with hanler UART_Queue
+		periodic job: 100ms, execution : 20.3Us
+		each job sends a string through a queue with hanler UART_Queue, then
+		returns to the job server, so it must never block
 */
 void Periodic_Transmitter(void *pvParameters){
-	BaseType_t state;
 	/* My Message that will be send periodically */
 	char *msg = "Mohammed Salah";
-	int xLastWakeTime = xTaskGetTickCount();
-	vTaskSetApplicationTaskTag(NULL, (void*) 3);
-	/* Creating a queue */
-	UART_Queue = xQueueCreate((UBaseType_t) 1, sizeof(&msg));
-	for(;;){
-		/* Sending my messsage */
-		if(uxQueueSpacesAvailable(UART_Queue) > 0){
-			state = xQueueSend(UART_Queue, ( void * )&msg, 10);
-		}
-		vTaskDelayUntil(&xLastWakeTime, Periodic_Transmitter_PERIOD);
+	/* Sending my messsage */
+	if(uxQueueSpacesAvailable(UART_Queue) > 0){
+		xQueueSend(UART_Queue, ( void * )&msg, 0);
 	}
 }
 
@@ -338,9 +409,8 @@ void Uart_Receiver(void *pvParameters){
 	/* My Message holder */
 	char *msg_2 = "No Data";
 	int i = 0;
-	int xLastWakeTime = xTaskGetTickCount();
 	BaseType_t state;
-	vTaskSetApplicationTaskTag(NULL, (void*) 4);
+	vTaskSetApplicationTaskTag(NULL, (TaskHookFunction_t) &task_traces[3]);
 	for(;;){
 	/* Receiving the message through my queue */
 		if(UART_Queue != NULL){
@@ -353,8 +423,8 @@ void Uart_Receiver(void *pvParameters){
 			vSerialPutString(msg_2, 14);
 			state = pdFAIL;
 		}
-		/* Sending the received message through the queue */
-		vTaskDelayUntil(&xLastWakeTime, Uart_Receiver_PERIOD);
+		/* The kernel releases the next job at the period of the task */
+		xTaskWaitForNextPeriod();
 	}
 }
 
@@ -365,15 +435,14 @@ void Uart_Receiver(void *pvParameters){
 */
 void Load_1_Simulation(void *pvParameters){
  	int i = 0, j = 0;
-	/* My Message holder */
-	int xLastWakeTime = xTaskGetTickCount();
-	vTaskSetApplicationTaskTag(NULL, (void*) 5);
+	vTaskSetApplicationTaskTag(NULL, (TaskHookFunction_t) &task_traces[4]);
 	for(;;){
 		for(i = 0; i < 7648; i++){
 			for( j = 0; j < 5; j++){
 			}
 		}
-		vTaskDelayUntil(&xLastWakeTime, Load_1_Simulation_PERIOD);
+		mainSIMULATE_EXECUTION(5000);
+		xTaskWaitForNextPeriod();
 	}
 }
 
@@ -385,30 +454,84 @@ void Load_1_Simulation(void *pvParameters){
 void Load_2_Simulation(void *pvParameters){
  	int i = 0, j = 0, q = 0;
 	portBASE_TYPE uart_state;
-	int xLastWakeTime = xTaskGetTickCount();
-	vTaskSetApplicationTaskTag(NULL, (void*) 6);
+	vTaskSetApplicationTaskTag(NULL, (TaskHookFunction_t) &task_traces[5]);
 	for(;;){
 		for(i = 0; i < 12128; i++){
 			for( j = 0; j < 9; j++){
 			}
 		}
+		mainSIMULATE_EXECUTION(12000);
 //		xSerialPutChar('\n');
 		vTaskGetRunTimeStats(runTimeStatsBuff);
+		/* Update the total number of missed deadlines of all the tasks */
+		misses = prvGetDeadlineMisses();
+		/* Update the CPU load, only computed here rather than on every switch */
+		cpu_load = prvGetCpuLoad();
 /*			vSerialPutString(runTimeStatsBuff, 280);*/
 /*		for(q = 0; q < 14; q++){
 			vSerialPutString(&runTimeStatsBuff[q*20], 20);
 			vTaskDelay(10);
 		}*/
-		vTaskDelayUntil(&xLastWakeTime, Load_2_Simulation_PERIOD);
+		xTaskWaitForNextPeriod();
 	}
 }
 
 
+/* Function to sum the deadline misses the kernel recorded for every task */
+static int prvGetDeadlineMisses( void )
+{
+	TaskHandle_t handles[6];
+	UBaseType_t task_misses;
+	int total = 0, i;
+	handles[0] = Button_1_Monitor_Handler;
+	handles[1] = Button_2_Monitor_Handler;
+	handles[2] = Job_Server_Handler;
+	handles[3] = Uart_Receiver_Handler;
+	handles[4] = Load_1_Simulation_Handler;
+	handles[5] = Load_2_Simulation_Handler;
+	for(i = 0; i < 6; i++){
+		vTaskGetDeadlineMissInfo(handles[i], &task_misses, NULL, NULL);
+		total += task_misses;
+	}
+	return total;
+}
+
+/* Function to compute the CPU load in percent from the trace records, in
+integer arithmetic so the switch hooks only have to accumulate times */
+static int prvGetCpuLoad( void )
+{
+	unsigned long long busy = 0;
+	unsigned long now = T1TC;
+	int i;
+	for(i = 0; i < (int)(sizeof(task_traces) / sizeof(task_traces[0])); i++){
+		busy += task_traces[i].ulTotalTime;
+	}
+	if(now == 0){
+		return 0;
+	}
+	return (int)((busy * 100) / now);
+}
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+/* The kernel creates the idle task from these buffers when the scheduler starts */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize){
+		*ppxIdleTaskTCBBuffer = &Idle_TCB;
+		*ppxIdleTaskStackBuffer = Idle_Stack;
+		*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+#endif
+
 void vApplicationTickHook(void){
 		GPIO_write(PORT_0, PIN0, PIN_IS_HIGH);
+		prvSampleButton(&buttons[0]);
+		prvSampleButton(&buttons[1]);
 		GPIO_write(PORT_0, PIN0, PIN_IS_LOW);
 }
 
 void vApplicationIdleHook(void){
 		GPIO_write(PORT_0, PIN1, PIN_IS_HIGH);
+#ifdef POSIX_SIMULATOR
+		/* Nothing else is ready, let virtual time run on to the next tick */
+		vPortSimulateIdle();
+#endif
 }
@@ -0,0 +1,35 @@
+/*
+ * Stand-in for the GPIO driver used by the application when it is built for
+ * the POSIX simulator.  Writes that change a pin are recorded in the trace
+ * so the logic analyser view of the target can be rebuilt from a run, and
+ * reads return a fixed stimulus derived from virtual time.
+ */
+
+#ifndef GPIO_H_
+#define GPIO_H_
+
+typedef enum
+{
+	PIN_IS_LOW,
+	PIN_IS_HIGH
+} pinState_t;
+
+typedef enum
+{
+	PORT_0,
+	PORT_1
+} portX_t;
+
+typedef enum
+{
+	PIN0, PIN1, PIN2, PIN3, PIN4, PIN5, PIN6, PIN7,
+	PIN8, PIN9, PIN10, PIN11, PIN12, PIN13, PIN14, PIN15,
+	PIN16, PIN17, PIN18, PIN19, PIN20, PIN21, PIN22, PIN23,
+	PIN24, PIN25, PIN26, PIN27, PIN28, PIN29, PIN30, PIN31
+} pinX_t;
+
+void GPIO_init( void );
+void GPIO_write( portX_t port, pinX_t pin, pinState_t state );
+pinState_t GPIO_read( portX_t port, pinX_t pin );
+
+#endif /* GPIO_H_ */
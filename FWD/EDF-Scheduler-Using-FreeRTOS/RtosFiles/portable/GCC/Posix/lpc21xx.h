@@ -0,0 +1,20 @@
+/*
+ * Stand-in for the LPC21xx register definitions used by the application when
+ * it is built for the POSIX simulator.  Only the timer 1 and VPB divider
+ * registers that main.c and FreeRTOSConfig.h touch are provided.
+ *
+ * Timer 1 counts virtual time: T1TC reads the number of prescaled peripheral
+ * clock cycles that have elapsed since the timer was enabled in T1TCR.
+ */
+
+#ifndef lpc21xx_h
+#define lpc21xx_h
+
+extern volatile unsigned long T1TCR;	/* Timer 1 control, bit 0 enables the counter, bit 1 resets it. */
+extern volatile unsigned long T1PR;		/* Timer 1 prescaler. */
+extern volatile unsigned long VPBDIV;	/* VPB divider, the simulator always runs the bus at full speed. */
+
+unsigned long ulSimulatedT1TC( void );
+#define T1TC	( ulSimulatedT1TC() )
+
+#endif /* lpc21xx_h */
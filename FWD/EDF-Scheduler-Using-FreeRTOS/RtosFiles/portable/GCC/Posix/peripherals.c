@@ -0,0 +1,128 @@
+/*
+ * Stand-in peripherals for running the application on the POSIX simulator.
+ *
+ * Every access is charged a fixed amount of virtual time and recorded in the
+ * trace, so a run produces the same pin and UART activity as the target in a
+ * form that can be diffed between builds.  Pins 2 to 7 of port 0 mark the
+ * six application tasks, pin 0 the tick and pin 1 the idle task, as set up
+ * by the trace macros in FreeRTOSConfig.h.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+
+/* Stand-in peripheral includes. */
+#include "lpc21xx.h"
+#include "GPIO.h"
+#include "serial.h"
+
+/* Virtual execution time of one peripheral register access. */
+#define perACCESS_TIME_US		( 1UL )
+
+/* Button inputs toggle with these periods, in milliseconds of virtual time,
+so the monitor tasks see edges to report. */
+#define perPIN8_TOGGLE_MS		( 700ULL )
+#define perPIN9_TOGGLE_MS		( 1100ULL )
+
+#define perNUMBER_OF_PORTS		( 2 )
+#define perPINS_PER_PORT		( 32 )
+
+volatile unsigned long T1TCR = 0UL;
+volatile unsigned long T1PR = 0UL;
+volatile unsigned long VPBDIV = 0UL;
+
+static pinState_t xPinStates[ perNUMBER_OF_PORTS ][ perPINS_PER_PORT ];
+/*-----------------------------------------------------------*/
+
+unsigned long ulSimulatedT1TC( void )
+{
+uint64_t ullCycles;
+
+	if( ( T1TCR & 0x1UL ) == 0UL )
+	{
+		return 0UL;
+	}
+
+	/* The peripheral clock runs at the CPU clock, see VPBDIV in main.c. */
+	ullCycles = ullPortSimulatedTime() * ( ( uint64_t ) configCPU_CLOCK_HZ / 1000000ULL );
+
+	return ( unsigned long ) ( ullCycles / ( ( uint64_t ) T1PR + 1ULL ) );
+}
+/*-----------------------------------------------------------*/
+
+void GPIO_init( void )
+{
+int iPort, iPin;
+
+	for( iPort = 0; iPort < perNUMBER_OF_PORTS; iPort++ )
+	{
+		for( iPin = 0; iPin < perPINS_PER_PORT; iPin++ )
+		{
+			xPinStates[ iPort ][ iPin ] = PIN_IS_LOW;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void GPIO_write( portX_t port, pinX_t pin, pinState_t state )
+{
+	if( xPinStates[ port ][ pin ] != state )
+	{
+		xPinStates[ port ][ pin ] = state;
+		vPortSimulationTrace( "P%d.%d %d\n", ( int ) port, ( int ) pin, ( int ) state );
+	}
+
+	vPortSimulateExecution( perACCESS_TIME_US );
+}
+/*-----------------------------------------------------------*/
+
+pinState_t GPIO_read( portX_t port, pinX_t pin )
+{
+uint64_t ullTimeMs = ullPortSimulatedTime() / 1000ULL;
+pinState_t xState = PIN_IS_LOW;
+
+	if( port == PORT_0 )
+	{
+		if( pin == PIN8 )
+		{
+			xState = ( ( ullTimeMs / perPIN8_TOGGLE_MS ) & 1ULL ) ? PIN_IS_HIGH : PIN_IS_LOW;
+		}
+		else if( pin == PIN9 )
+		{
+			xState = ( ( ullTimeMs / perPIN9_TOGGLE_MS ) & 1ULL ) ? PIN_IS_HIGH : PIN_IS_LOW;
+		}
+		else
+		{
+			xState = xPinStates[ port ][ pin ];
+		}
+	}
+
+	vPortSimulateExecution( perACCESS_TIME_US );
+
+	return xState;
+}
+/*-----------------------------------------------------------*/
+
+void xSerialPortInitMinimal( unsigned long ulWantedBaud )
+{
+	vPortSimulationTrace( "UART init %lu\n", ulWantedBaud );
+}
+/*-----------------------------------------------------------*/
+
+signed long xSerialPutChar( char cOutChar )
+{
+	vPortSimulationTrace( "UART 0x%02x\n", ( unsigned int ) ( unsigned char ) cOutChar );
+	vPortSimulateExecution( perACCESS_TIME_US );
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vSerialPutString( const char * pcString, unsigned short usStringLength )
+{
+	vPortSimulationTrace( "UART \"%.*s\"\n", ( int ) usStringLength, pcString );
+	vPortSimulateExecution( perACCESS_TIME_US * ( unsigned long ) usStringLength );
+}
@@ -0,0 +1,715 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for a Linux/POSIX host.
+ *
+ * This port runs the kernel and the application of main.c on the build
+ * machine so scheduler changes can be measured without the LPC2129 board.
+ *
+ * Every task runs on its own ucontext, all on the one host thread, so only
+ * one task ever executes at a time and no host scheduling decision can change
+ * the result.  Time is virtual.  It only moves forward when a task charges
+ * execution time with vPortSimulateExecution(), when a stand-in peripheral is
+ * accessed, or when the idle hook calls vPortSimulateIdle().  Each time the
+ * virtual clock crosses a tick boundary the tick interrupt is raised, and is
+ * held pending while interrupts are masked, exactly as it would be on the
+ * target.  A run is therefore deterministic and much faster than real time.
+ *
+ * The run length and trace output are set from the environment:
+ *   EDF_SIM_TICKS  number of ticks to simulate before exiting, default 10000.
+ *   EDF_SIM_TRACE  file the trace is written to, default stdout.
+ *   EDF_SIM_EVENTS file the binary event buffer of edf_trace.h is dumped to
+ *                  at the end of the run, for Tools/edf_trace_decode.c.
+ *
+ * The trace ends with a summary of the run: the ticks taken and suppressed,
+ * the number of scheduler runs and actual context switches with their rate
+ * per second of virtual time, and the switches the EDF kernel avoided.  This
+ * is the benchmark for scheduler changes on the main.c task set.  The host CPU
+ * time of the run and of the tick interrupt is printed too, as the cost of the
+ * kernel itself does not show in virtual time.  Last comes one line for each
+ * task that had a job released, with the time from the nominal release of its
+ * jobs to their start and the deadlines it missed.
+ *
+ * Build with POSIX_SIMULATOR defined, this directory ahead of RtosFiles on the
+ * include path, and the kernel sources (list.c, queue.c, event_groups.c and a
+ * heap_x.c) plus tasks.c, edf_trace.c, main.c, port.c and peripherals.c, e.g.
+ *   gcc -DPOSIX_SIMULATOR -Iportable/GCC/Posix -I. -I<kernel>/include ...
+ *----------------------------------------------------------*/
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <ucontext.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Each task runs on a host stack, the stack given to the kernel is only used
+to hold a pointer to the task's simulator state. */
+#define portHOST_STACK_SIZE			( ( size_t ) 64 * 1024 )
+
+/* Length of one tick in microseconds of virtual time. */
+#define portTICK_PERIOD_US			( ( uint64_t ) 1000000ULL / ( uint64_t ) configTICK_RATE_HZ )
+
+/* Number of ticks simulated when EDF_SIM_TICKS is not set. */
+#define portDEFAULT_SIMULATION_TICKS	( 10000UL )
+
+/* Value used for the critical nesting count before the scheduler starts, so
+the tick cannot be taken until the first task runs. */
+#define portNO_CRITICAL_NESTING		( ( UBaseType_t ) 0 )
+#define portINITIAL_CRITICAL_NESTING	( ( UBaseType_t ) 9999 )
+
+/* Tasks whose jobs are measured, by uxTCBNumber.  The binary event trace has
+the same limit. */
+#define portMAX_MEASURED_TASKS		( 256U )
+
+/* Simulator state of one task, referenced from the top of its kernel stack. */
+typedef struct SIMULATED_TASK
+{
+	ucontext_t xContext;				/*< Host context, saved when the task is switched out. */
+	UBaseType_t uxCriticalNesting;		/*< Critical nesting count of the task while it is switched out. */
+	void *pvHostStack;					/*< Stack the task runs on. */
+	TaskFunction_t pxCode;				/*< Task function and its parameter, used when the task first runs. */
+	void *pvParameters;
+} SimulatedTask_t;
+
+/* Release to start time of the jobs of one task, see
+vPortSimulationJobReleased(). */
+typedef struct SIMULATED_JOBS
+{
+	const char *pcName;					/*< Name of the task, NULL until its first job is released. */
+	TickType_t xRelease;				/*< Nominal release of the current job, in ticks. */
+	uint64_t ullRelease;				/*< The same in microseconds of virtual time. */
+	BaseType_t xStartPending;			/*< pdTRUE from the release of a job until the task first runs. */
+	uint32_t ulJobs;					/*< Jobs that started. */
+	uint32_t ulMisses;					/*< Deadlines missed. */
+	uint64_t ullMinStart;				/*< Shortest, longest and total time from release to start, in microseconds. */
+	uint64_t ullMaxStart;
+	uint64_t ullTotalStart;
+} SimulatedJobs_t;
+
+/* The TCB of the running task.  The first member of a TCB is the top of its
+stack, which holds the SimulatedTask_t pointer. */
+extern volatile void * volatile pxCurrentTCB;
+
+/* Virtual time in microseconds, and the time at which the next tick is due. */
+static uint64_t ullTimeNow = 0ULL;
+static uint64_t ullNextTickTime = 0ULL;
+
+/* Tick interrupts raised while interrupts were masked. */
+static UBaseType_t uxTicksPending = 0U;
+static uint32_t ulTicksTaken = 0UL;
+static uint32_t ulTicksSuppressed = 0UL;
+static uint32_t ulTicksToRun = portDEFAULT_SIMULATION_TICKS;
+
+/* Number of times the scheduler was run, and how many of those runs selected
+a different task.  On the target every run saves and restores a full task
+context, even when the same task is selected again. */
+static uint32_t ulSchedulerRuns = 0UL;
+static uint32_t ulContextSwitches = 0UL;
+
+/* Host CPU time spent in xTaskIncrementTick(), in total and for the longest
+tick, in nanoseconds. */
+static uint64_t ullTickHostTime = 0ULL;
+static uint64_t ullTickHostTimeMax = 0ULL;
+
+static volatile UBaseType_t uxCriticalNesting = portINITIAL_CRITICAL_NESTING;
+static BaseType_t xInterruptsMasked = pdTRUE;
+static BaseType_t xInTickInterrupt = pdFALSE;
+static BaseType_t xYieldFromInterrupt = pdFALSE;
+static BaseType_t xSchedulerStarted = pdFALSE;
+
+static FILE *pxTraceFile = NULL;
+
+/* Virtual time and tick count when the scheduler started, which place the
+ticks on the virtual time line. */
+static uint64_t ullStartTime = 0ULL;
+static TickType_t xStartTick = ( TickType_t ) 0;
+
+static SimulatedJobs_t xMeasuredJobs[ portMAX_MEASURED_TASKS ];
+
+/*
+ * Returns the simulator state of the task owning pxTCB.
+ */
+static SimulatedTask_t *prvGetSimulatedTask( volatile void *pxTCB );
+
+/*
+ * Entry point of every task context.  Calls the task function of the task
+ * that has just been switched in for the first time.
+ */
+static void prvTaskEntry( void );
+
+/*
+ * Ask the kernel which task should run next, and switch to it.
+ */
+static void prvSwitchContext( void );
+
+/*
+ * Run the tick interrupt once for every tick that is pending, provided
+ * interrupts are not masked.
+ */
+static void prvProcessPendingTicks( void );
+
+/*
+ * Print the end of run summary and exit the process.
+ */
+static void prvEndSimulation( void );
+
+/*
+ * Account for the start of the current job of a task.
+ */
+static void prvJobStarted( SimulatedJobs_t *pxJobs );
+
+/*
+ * Host CPU time used by the process so far, in nanoseconds.
+ */
+static uint64_t prvHostTime( void );
+/*-----------------------------------------------------------*/
+
+static SimulatedTask_t *prvGetSimulatedTask( volatile void *pxTCB )
+{
+	return ( SimulatedTask_t * ) ( **( StackType_t * volatile * ) pxTCB );
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+SimulatedTask_t *pxTask;
+
+	pxTask = ( SimulatedTask_t * ) calloc( 1, sizeof( SimulatedTask_t ) );
+	configASSERT( pxTask != NULL );
+
+	pxTask->pvHostStack = malloc( portHOST_STACK_SIZE );
+	configASSERT( pxTask->pvHostStack != NULL );
+
+	pxTask->pxCode = pxCode;
+	pxTask->pvParameters = pvParameters;
+	pxTask->uxCriticalNesting = portNO_CRITICAL_NESTING;
+
+	( void ) getcontext( &( pxTask->xContext ) );
+	pxTask->xContext.uc_stack.ss_sp = pxTask->pvHostStack;
+	pxTask->xContext.uc_stack.ss_size = portHOST_STACK_SIZE;
+	pxTask->xContext.uc_link = NULL;
+	makecontext( &( pxTask->xContext ), prvTaskEntry, 0 );
+
+	/* Leave the simulator state where the kernel expects the top of stack. */
+	pxTopOfStack--;
+	*pxTopOfStack = ( StackType_t ) pxTask;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pxTCB )
+{
+SimulatedTask_t *pxTask = prvGetSimulatedTask( pxTCB );
+
+	/* Never called for the running task, the idle task frees the TCB of a
+	task that deleted itself. */
+	free( pxTask->pvHostStack );
+	free( pxTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( void )
+{
+SimulatedTask_t *pxTask = prvGetSimulatedTask( pxCurrentTCB );
+
+	pxTask->pxCode( pxTask->pvParameters );
+
+	/* Tasks must not return from their implementing function. */
+	vPortSimulationTrace( "ERROR task returned from its function\n" );
+	prvEndSimulation();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+const char *pcValue;
+static ucontext_t xSchedulerContext;
+
+	pcValue = getenv( "EDF_SIM_TICKS" );
+	if( pcValue != NULL )
+	{
+		ulTicksToRun = ( uint32_t ) strtoul( pcValue, NULL, 10 );
+	}
+
+	pcValue = getenv( "EDF_SIM_TRACE" );
+	if( pcValue != NULL )
+	{
+		pxTraceFile = fopen( pcValue, "w" );
+	}
+
+	if( pxTraceFile == NULL )
+	{
+		pxTraceFile = stdout;
+	}
+
+	/* Start the tick timer, then restore the context of the first task with
+	interrupts enabled. */
+	ullStartTime = ullTimeNow;
+	xStartTick = xTaskGetTickCount();
+	ullNextTickTime = ullTimeNow + portTICK_PERIOD_US;
+	xSchedulerStarted = pdTRUE;
+	xInterruptsMasked = pdFALSE;
+	uxCriticalNesting = portNO_CRITICAL_NESTING;
+
+	( void ) swapcontext( &xSchedulerContext, &( prvGetSimulatedTask( pxCurrentTCB )->xContext ) );
+
+	/* Should not get here, the simulation ends by exiting the process. */
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	prvEndSimulation();
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndSimulation( void )
+{
+const uint64_t ullSeconds = ( ullTimeNow >= 1000000ULL ) ? ( ullTimeNow / 1000000ULL ) : 1ULL;
+const SimulatedJobs_t *pxJobs;
+UBaseType_t uxTask;
+#if( configUSE_EDF_TRACE == 1 )
+	const char *pcValue;
+	FILE *pxEventFile;
+#endif
+
+	if( pxTraceFile == NULL )
+	{
+		pxTraceFile = stdout;
+	}
+
+	#if( configUSE_EDF_TRACE == 1 )
+	{
+		/* The dump is the buffer exactly as it is laid out in memory, the
+		same as a dump of xEdfTraceBuffer read from the target. */
+		pcValue = getenv( "EDF_SIM_EVENTS" );
+		if( pcValue != NULL )
+		{
+			pxEventFile = fopen( pcValue, "wb" );
+			if( pxEventFile != NULL )
+			{
+				( void ) fwrite( &xEdfTraceBuffer, sizeof( xEdfTraceBuffer ), 1, pxEventFile );
+				( void ) fclose( pxEventFile );
+			}
+		}
+	}
+	#endif /* configUSE_EDF_TRACE */
+
+	vPortSimulationTrace( "END %lu ticks %lu suppressed\n", ( unsigned long ) ulTicksTaken, ( unsigned long ) ulTicksSuppressed );
+	vPortSimulationTrace( "HOST %lu us cpu, tick %lu ns mean %lu ns max\n",
+						  ( unsigned long ) ( prvHostTime() / 1000ULL ),
+						  ( unsigned long ) ( ullTickHostTime / ( ( ulTicksTaken > ulTicksSuppressed ) ? ( ulTicksTaken - ulTicksSuppressed ) : 1UL ) ),
+						  ( unsigned long ) ullTickHostTimeMax );
+	vPortSimulationTrace( "SWITCHES %lu runs %lu/s %lu switches %lu/s\n",
+						  ( unsigned long ) ulSchedulerRuns, ( unsigned long ) ( ulSchedulerRuns / ullSeconds ),
+						  ( unsigned long ) ulContextSwitches, ( unsigned long ) ( ulContextSwitches / ullSeconds ) );
+
+	#if( configUSE_EDF_SCHEDULER == 1 )
+	{
+		vPortSimulationTrace( "AVOIDED %lu\n", ( unsigned long ) uxTaskGetAvoidedContextSwitches() );
+	}
+	#endif
+
+	/* The jitter of a task is the spread of its release to start times. */
+	for( uxTask = 0U; uxTask < portMAX_MEASURED_TASKS; uxTask++ )
+	{
+		pxJobs = &( xMeasuredJobs[ uxTask ] );
+
+		if( pxJobs->ulJobs > 0UL )
+		{
+			vPortSimulationTrace( "JITTER %3lu %-*s jobs %lu start %lu/%lu/%lu us jitter %lu us missed %lu\n",
+								  ( unsigned long ) uxTask, configMAX_TASK_NAME_LEN, pxJobs->pcName,
+								  ( unsigned long ) pxJobs->ulJobs,
+								  ( unsigned long ) pxJobs->ullMinStart,
+								  ( unsigned long ) ( pxJobs->ullTotalStart / ( uint64_t ) pxJobs->ulJobs ),
+								  ( unsigned long ) pxJobs->ullMaxStart,
+								  ( unsigned long ) ( pxJobs->ullMaxStart - pxJobs->ullMinStart ),
+								  ( unsigned long ) pxJobs->ulMisses );
+		}
+	}
+
+	( void ) fflush( pxTraceFile );
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( void )
+{
+SimulatedTask_t *pxOldTask = prvGetSimulatedTask( pxCurrentTCB );
+SimulatedTask_t *pxNewTask;
+
+	/* Select the next task with the tick masked, as the trace macros called
+	from vTaskSwitchContext() can move virtual time on. */
+	uxCriticalNesting++;
+	vTaskSwitchContext();
+	uxCriticalNesting--;
+	ulSchedulerRuns++;
+
+	pxNewTask = prvGetSimulatedTask( pxCurrentTCB );
+
+	if( pxNewTask != pxOldTask )
+	{
+		ulContextSwitches++;
+
+		/* The critical nesting count is part of the task context. */
+		pxOldTask->uxCriticalNesting = uxCriticalNesting;
+		uxCriticalNesting = pxNewTask->uxCriticalNesting;
+		( void ) swapcontext( &( pxOldTask->xContext ), &( pxNewTask->xContext ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	prvSwitchContext();
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+	if( xInTickInterrupt != pdFALSE )
+	{
+		/* Switch once the tick interrupt has completed. */
+		xYieldFromInterrupt = pdTRUE;
+	}
+	else
+	{
+		prvSwitchContext();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvHostTime( void )
+{
+struct timespec xTime;
+
+	( void ) clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xTime );
+	return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessPendingTicks( void )
+{
+BaseType_t xSwitchRequired;
+uint64_t ullTickStart, ullTickTime;
+
+	while( ( uxTicksPending > 0U ) &&
+		   ( xSchedulerStarted != pdFALSE ) &&
+		   ( uxCriticalNesting == portNO_CRITICAL_NESTING ) &&
+		   ( xInterruptsMasked == pdFALSE ) &&
+		   ( xInTickInterrupt == pdFALSE ) )
+	{
+		uxTicksPending--;
+
+		/* The tick interrupt runs with further interrupts masked. */
+		xInTickInterrupt = pdTRUE;
+		ullTickStart = prvHostTime();
+		xSwitchRequired = xTaskIncrementTick();
+		ullTickTime = prvHostTime() - ullTickStart;
+		xInTickInterrupt = pdFALSE;
+
+		ullTickHostTime += ullTickTime;
+		if( ullTickTime > ullTickHostTimeMax )
+		{
+			ullTickHostTimeMax = ullTickTime;
+		}
+
+		ulTicksTaken++;
+		if( ulTicksTaken >= ulTicksToRun )
+		{
+			prvEndSimulation();
+		}
+
+		if( ( xSwitchRequired != pdFALSE ) || ( xYieldFromInterrupt != pdFALSE ) )
+		{
+			xYieldFromInterrupt = pdFALSE;
+			prvSwitchContext();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateExecution( uint32_t ulMicroseconds )
+{
+uint64_t ullStep;
+
+	while( ulMicroseconds > 0UL )
+	{
+		if( xSchedulerStarted == pdFALSE )
+		{
+			/* The tick timer is not running yet. */
+			ullTimeNow += ulMicroseconds;
+			break;
+		}
+
+		ullStep = ullNextTickTime - ullTimeNow;
+		if( ullStep > ( uint64_t ) ulMicroseconds )
+		{
+			ullStep = ( uint64_t ) ulMicroseconds;
+		}
+
+		ullTimeNow += ullStep;
+		ulMicroseconds -= ( uint32_t ) ullStep;
+
+		if( ullTimeNow >= ullNextTickTime )
+		{
+			ullNextTickTime += portTICK_PERIOD_US;
+			uxTicksPending++;
+		}
+
+		/* May switch to another task, in which case the rest of the
+		execution time is charged when this task runs again. */
+		prvProcessPendingTicks();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateIdle( void )
+{
+	/* Nothing runs until the next tick, so jump straight to it. */
+	if( xSchedulerStarted != pdFALSE )
+	{
+		vPortSimulateExecution( ( uint32_t ) ( ullNextTickTime - ullTimeNow ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE != 0 )
+
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+	uint32_t ulTicksRemaining = ulTicksToRun - ulTicksTaken;
+	TickType_t xSleptTicks;
+
+		/* Called by the idle task with the scheduler suspended.  Mask the
+		tick and check nothing became ready since the idle time was sampled. */
+		xInterruptsMasked = pdTRUE;
+
+		if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+		{
+			vPortEnableInterrupts();
+			return;
+		}
+
+		/* Nothing can run until the wake up tick, or the end of the run, so
+		virtual time jumps straight to it. */
+		if( ( uint32_t ) xExpectedIdleTime > ulTicksRemaining )
+		{
+			xExpectedIdleTime = ( TickType_t ) ulTicksRemaining;
+		}
+
+		if( xExpectedIdleTime > ( TickType_t ) 1 )
+		{
+			xSleptTicks = xExpectedIdleTime - ( TickType_t ) 1;
+			vPortSimulationTrace( "SLEEP %lu\n", ( unsigned long ) xExpectedIdleTime );
+
+			ullTimeNow = ullNextTickTime + ( ( uint64_t ) xSleptTicks * portTICK_PERIOD_US );
+			ullNextTickTime = ullTimeNow + portTICK_PERIOD_US;
+
+			/* The ticks slept through are stepped without being processed.
+			The wake up tick is raised as an interrupt, which the kernel pends
+			until xTaskResumeAll() as the scheduler is suspended, so it is
+			processed just as xTaskCatchUpTicks() would. */
+			vTaskStepTick( xSleptTicks );
+			ulTicksTaken += ( uint32_t ) xSleptTicks;
+			ulTicksSuppressed += ( uint32_t ) xSleptTicks;
+			uxTicksPending++;
+		}
+
+		vPortEnableInterrupts();
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortSimulatedTime( void )
+{
+	return ullTimeNow;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulatedSchedulerRuns( uint32_t *pulRuns, uint32_t *pulSwitches )
+{
+	*pulRuns = ulSchedulerRuns;
+	*pulSwitches = ulContextSwitches;
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortSimulatedTickHostTime( uint32_t *pulTicks )
+{
+	/* Suppressed ticks never run xTaskIncrementTick() one at a time. */
+	*pulTicks = ulTicksTaken - ulTicksSuppressed;
+	return ullTickHostTime;
+}
+/*-----------------------------------------------------------*/
+
+static void prvJobStarted( SimulatedJobs_t *pxJobs )
+{
+uint64_t ullStart = 0ULL;
+
+	if( ullTimeNow > pxJobs->ullRelease )
+	{
+		ullStart = ullTimeNow - pxJobs->ullRelease;
+	}
+
+	if( ( pxJobs->ulJobs == 0UL ) || ( ullStart < pxJobs->ullMinStart ) )
+	{
+		pxJobs->ullMinStart = ullStart;
+	}
+
+	if( ullStart > pxJobs->ullMaxStart )
+	{
+		pxJobs->ullMaxStart = ullStart;
+	}
+
+	pxJobs->ullTotalStart += ullStart;
+	pxJobs->ulJobs++;
+	pxJobs->xStartPending = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulationJobReleased( UBaseType_t uxTask, const char *pcName, TickType_t xRelease, BaseType_t xRunning )
+{
+SimulatedJobs_t *pxJobs;
+
+	if( uxTask < portMAX_MEASURED_TASKS )
+	{
+		pxJobs = &( xMeasuredJobs[ uxTask ] );
+
+		/* A task made ready again part way through a job, after blocking on
+		a queue for example, reports the release of the same job. */
+		if( ( pxJobs->pcName == NULL ) || ( xRelease != pxJobs->xRelease ) )
+		{
+			pxJobs->pcName = pcName;
+			pxJobs->xRelease = xRelease;
+			pxJobs->ullRelease = ullStartTime + ( ( uint64_t ) ( TickType_t ) ( xRelease - xStartTick ) * portTICK_PERIOD_US );
+			pxJobs->xStartPending = pdTRUE;
+
+			if( xRunning != pdFALSE )
+			{
+				prvJobStarted( pxJobs );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulationTaskSwitchedIn( UBaseType_t uxTask )
+{
+	if( ( uxTask < portMAX_MEASURED_TASKS ) && ( xMeasuredJobs[ uxTask ].xStartPending != pdFALSE ) )
+	{
+		prvJobStarted( &( xMeasuredJobs[ uxTask ] ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulationDeadlineMissed( UBaseType_t uxTask )
+{
+	if( uxTask < portMAX_MEASURED_TASKS )
+	{
+		xMeasuredJobs[ uxTask ].ulMisses++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulationTrace( const char *pcFormat, ... )
+{
+va_list xArgs;
+
+	if( pxTraceFile != NULL )
+	{
+		/* Every record starts with the virtual time in microseconds. */
+		( void ) fprintf( pxTraceFile, "%12llu ", ( unsigned long long ) ullTimeNow );
+		va_start( xArgs, pcFormat );
+		( void ) vfprintf( pxTraceFile, pcFormat, xArgs );
+		va_end( xArgs );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	if( uxCriticalNesting > portNO_CRITICAL_NESTING )
+	{
+		uxCriticalNesting--;
+
+		/* A tick that became due inside the critical section is taken as
+		soon as interrupts are enabled again. */
+		if( uxCriticalNesting == portNO_CRITICAL_NESTING )
+		{
+			prvProcessPendingTicks();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	xInterruptsMasked = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	xInterruptsMasked = pdFALSE;
+	prvProcessPendingTicks();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+UBaseType_t uxPreviousMask = ( UBaseType_t ) xInterruptsMasked;
+
+	xInterruptsMasked = pdTRUE;
+	return uxPreviousMask;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxMask )
+{
+	xInterruptsMasked = ( BaseType_t ) uxMask;
+
+	if( xInterruptsMasked == pdFALSE )
+	{
+		prvProcessPendingTicks();
+	}
+}
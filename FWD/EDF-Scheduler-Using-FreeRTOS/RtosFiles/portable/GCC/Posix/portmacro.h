@@ -0,0 +1,156 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions for the host simulator.
+ *
+ * The settings in this file configure FreeRTOS correctly for the given
+ * hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+#include <stdint.h>
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned long
+#define portBASE_TYPE	long
+#define portPOINTER_SIZE_TYPE	uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* The simulator runs the kernel on a single host thread and only takes
+	the tick at well defined points, so tick reads are atomic. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portNOP()
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+extern void vPortYield( void );
+
+#define portYIELD()					vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired != pdFALSE ) vPortYieldFromISR()
+#define portYIELD_FROM_ISR( x )		portEND_SWITCHING_ISR( x )
+
+extern void vPortYieldFromISR( void );
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  There are no asynchronous interrupts on the
+host, the simulated tick is only taken when virtual time advances, and is held
+pending while the nesting count is above zero. */
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+extern UBaseType_t uxPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxMask );
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()		uxPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )	vPortClearInterruptMask( x )
+#define portDISABLE_INTERRUPTS()				vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()					vPortEnableInterrupts()
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+/*-----------------------------------------------------------*/
+
+/* Each task owns a host context and a host stack, released when the idle task
+frees the TCB. */
+extern void vPortCleanUpTCB( void *pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )	vPortCleanUpTCB( pxTCB )
+/*-----------------------------------------------------------*/
+
+/* Tickless idle.  The simulator sleeps by moving virtual time straight to the
+expected wake up tick. */
+#if( configUSE_TICKLESS_IDLE != 0 )
+	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+/* Virtual time.  Application code that only burns CPU, such as the load
+tasks in main.c, takes no virtual time when run on the host.  It calls
+vPortSimulateExecution() to charge its execution time instead.
+vPortSimulateIdle() moves virtual time on to the next tick and is called from
+the idle hook.  ullPortSimulatedTickHostTime() returns the host CPU time in
+nanoseconds spent in the tick so far, and the number of ticks it was spent on,
+for a benchmark to measure the tick over a part of the run.
+vPortSimulatedSchedulerRuns() returns the scheduler runs and actual context
+switches so far, as in the end of run summary. */
+extern void vPortSimulateExecution( uint32_t ulMicroseconds );
+extern void vPortSimulateIdle( void );
+extern uint64_t ullPortSimulatedTime( void );
+extern uint64_t ullPortSimulatedTickHostTime( uint32_t *pulTicks );
+extern void vPortSimulatedSchedulerRuns( uint32_t *pulRuns, uint32_t *pulSwitches );
+
+/* Called from the trace macros of FreeRTOSConfig.h to measure the time from
+the nominal release of each job to its start, and the deadlines missed.  The
+results are printed at the end of the run. */
+extern void vPortSimulationJobReleased( UBaseType_t uxTask, const char *pcName, TickType_t xRelease, BaseType_t xRunning );
+extern void vPortSimulationTaskSwitchedIn( UBaseType_t uxTask );
+extern void vPortSimulationDeadlineMissed( UBaseType_t uxTask );
+extern void vPortSimulationTrace( const char *pcFormat, ... );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,14 @@
+/*
+ * Stand-in for the serial driver used by the application when it is built
+ * for the POSIX simulator.  Every character and string written is recorded
+ * in the trace.
+ */
+
+#ifndef SERIAL_COMMS_H
+#define SERIAL_COMMS_H
+
+void xSerialPortInitMinimal( unsigned long ulWantedBaud );
+signed long xSerialPutChar( char cOutChar );
+void vSerialPutString( const char * pcString, unsigned short usStringLength );
+
+#endif /* SERIAL_COMMS_H */
@@ -112,6 +112,120 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
+/* Called when a periodic task completes a job after its absolute deadline.
+This can be overridden by defining traceTASK_DEADLINE_MISSED in
+FreeRTOSConfig.h. */
+#ifndef traceTASK_DEADLINE_MISSED
+	#define traceTASK_DEADLINE_MISSED( pxTCB, xLateness )
+#endif
+
+/* Fixed point representation of a utilisation of 1.0, the EDF bound for
+implicit deadline task sets. */
+#define taskEDF_UTILISATION_ONE		( ( uint32_t ) 0x10000UL )
+
+/* The total utilisation, in percent, a periodic task set is allowed to reach
+before xTaskPeriodicCreateWithWCET() rejects a new task.  Defaults to the EDF
+bound of 100%, lower values leave a safety margin.  This can be overridden by
+defining configEDF_UTILISATION_BOUND_PERCENT in FreeRTOSConfig.h. */
+#ifndef configEDF_UTILISATION_BOUND_PERCENT
+	#define configEDF_UTILISATION_BOUND_PERCENT		100UL
+#endif
+
+/* The bound in units of 1 / taskEDF_UTILISATION_ONE.  Multiplied before it is
+divided, so a bound of 100% is exactly taskEDF_UTILISATION_ONE and a set with a
+utilisation of exactly 1.0 is admitted. */
+#define taskEDF_UTILISATION_BOUND	( ( taskEDF_UTILISATION_ONE * ( uint32_t ) configEDF_UTILISATION_BOUND_PERCENT ) / 100UL )
+
+/* The number of tasks the EDF ready heap can hold at once.  The idle task is
+never in the heap, and creating any more tasks than this fails with
+errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.  This can be overridden by defining
+configEDF_MAX_READY_TASKS in FreeRTOSConfig.h.  It is not used when
+configUSE_EDF_READY_HEAP is 0. */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	#ifndef configEDF_MAX_READY_TASKS
+		#define configEDF_MAX_READY_TASKS	( ( UBaseType_t ) 16U )
+	#endif
+#endif
+
+#if ( ( configUSE_EDF_SRP == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
+	#error configUSE_EDF_SRP requires configUSE_EDF_SCHEDULER to be set to 1
+#endif
+
+#if ( ( configUSE_EDF_OVERRUN_POLICY == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
+	#error configUSE_EDF_OVERRUN_POLICY requires configUSE_EDF_SCHEDULER to be set to 1
+#endif
+
+#if ( ( configUSE_EDF_OVERRUN_POLICY == 1 ) && ( portUSING_MPU_WRAPPERS == 1 ) )
+	#error configUSE_EDF_OVERRUN_POLICY cannot restart the jobs of MPU tasks
+#endif
+
+#if ( configUSE_EDF_BUDGETS == 1 )
+	#if ( configUSE_EDF_SCHEDULER == 0 )
+		#error configUSE_EDF_BUDGETS requires configUSE_EDF_SCHEDULER to be set to 1
+	#endif
+
+	#if ( configGENERATE_RUN_TIME_STATS == 0 )
+		#error configUSE_EDF_BUDGETS requires configGENERATE_RUN_TIME_STATS to be set to 1
+	#endif
+
+	#ifndef configEDF_RUN_TIME_COUNTS_PER_TICK
+		#error configEDF_RUN_TIME_COUNTS_PER_TICK must be defined when configUSE_EDF_BUDGETS is set to 1
+	#endif
+#endif
+
+#if ( ( configUSE_EDF_CBS == 1 ) && ( configUSE_EDF_BUDGETS == 0 ) )
+	#error configUSE_EDF_CBS requires configUSE_EDF_BUDGETS to be set to 1
+#endif
+
+#if ( ( configUSE_EDF_CBS == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 0 ) )
+	#error configUSE_EDF_CBS requires configUSE_TASK_NOTIFICATIONS to be set to 1
+#endif
+
+#if ( ( configUSE_EDF_SPORADIC == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
+	#error configUSE_EDF_SPORADIC requires configUSE_EDF_SCHEDULER to be set to 1
+#endif
+
+#if ( ( configUSE_EDF_JOBS == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
+	#error configUSE_EDF_JOBS requires configUSE_EDF_SCHEDULER to be set to 1
+#endif
+
+/* Set configUSE_TIMING_WHEEL to 1 in FreeRTOSConfig.h to hold blocked tasks in
+a hierarchical timing wheel instead of the two sorted delayed lists.  Each of the
+configTIMING_WHEEL_LEVELS levels has 2 ^ configTIMING_WHEEL_BITS lists, and a
+list of one level spans as many ticks as the whole level below it.  Blocking is
+then an insert at the end of a list, and a tick only looks at the tasks that
+wake on it, see prvTimingWheelInsert(). */
+#ifndef configUSE_TIMING_WHEEL
+	#define configUSE_TIMING_WHEEL	0
+#endif
+
+#if ( configUSE_TIMING_WHEEL == 1 )
+	#ifndef configTIMING_WHEEL_BITS
+		#define configTIMING_WHEEL_BITS		4
+	#endif
+
+	#ifndef configTIMING_WHEEL_LEVELS
+		#define configTIMING_WHEEL_LEVELS	3
+	#endif
+
+	#if ( configUSE_16_BIT_TICKS == 1 )
+		#if ( ( configTIMING_WHEEL_BITS * configTIMING_WHEEL_LEVELS ) > 15 )
+			#error configTIMING_WHEEL_BITS * configTIMING_WHEEL_LEVELS must be less than 16 when configUSE_16_BIT_TICKS is 1
+		#endif
+	#else
+		#if ( ( configTIMING_WHEEL_BITS * configTIMING_WHEEL_LEVELS ) > 31 )
+			#error configTIMING_WHEEL_BITS * configTIMING_WHEEL_LEVELS must be less than 32
+		#endif
+	#endif
+#endif
+
+/* Called when a job has used its whole execution budget and is moved to the
+background.  This can be overridden by defining traceTASK_BUDGET_EXHAUSTED in
+FreeRTOSConfig.h. */
+#ifndef traceTASK_BUDGET_EXHAUSTED
+	#define traceTASK_BUDGET_EXHAUSTED( pxTCB )
+#endif
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -194,6 +308,8 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL == 0 )
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
 count overflows. */
 #define taskSWITCH_DELAYED_LISTS()																	\
@@ -210,6 +326,35 @@ count overflows. */
 	prvResetNextTaskUnblockTime();																	\
 }
 
+#else /* configUSE_TIMING_WHEEL */
+
+/* Number of lists in each level of the timing wheel, and the number of ticks
+one list of uxLevel spans.  The wheel as a whole reaches taskWHEEL_RANGE ticks
+ahead. */
+#define taskWHEEL_SLOTS					( ( TickType_t ) 1U << configTIMING_WHEEL_BITS )
+#define taskWHEEL_SLOT_MASK				( taskWHEEL_SLOTS - ( TickType_t ) 1U )
+#define taskWHEEL_SHIFT( uxLevel )		( ( UBaseType_t ) configTIMING_WHEEL_BITS * ( UBaseType_t ) ( uxLevel ) )
+#define taskWHEEL_SLOT_TICKS( uxLevel )	( ( TickType_t ) 1U << taskWHEEL_SHIFT( uxLevel ) )
+#define taskWHEEL_RANGE					taskWHEEL_SLOT_TICKS( configTIMING_WHEEL_LEVELS )
+
+/* List xSlot of uxLevel.  The far list, which holds the tasks that wake beyond
+the reach of the wheel, follows the lists of the last level. */
+#define taskWHEEL_LISTS					( ( ( UBaseType_t ) configTIMING_WHEEL_LEVELS << configTIMING_WHEEL_BITS ) + ( UBaseType_t ) 1U )
+#define taskWHEEL_LIST( uxLevel, xSlot )	( &( xTimingWheel[ ( ( UBaseType_t ) ( uxLevel ) << configTIMING_WHEEL_BITS ) + ( UBaseType_t ) ( xSlot ) ] ) )
+#define taskWHEEL_FAR_LIST				( &( xTimingWheel[ taskWHEEL_LISTS - ( UBaseType_t ) 1U ] ) )
+
+/* The wheel is indexed by the tick count itself, so nothing has to move when
+the tick count overflows.  xNextTaskUnblockTime is held at portMAX_DELAY while
+the next task to wake is beyond the overflow, so the wheel is looked at again
+on tick 0. */
+#define taskSWITCH_DELAYED_LISTS()																	\
+{																									\
+	xNumOfOverflows++;																				\
+	xNextTaskUnblockTime = ( TickType_t ) 0U;														\
+}
+
+#endif /* configUSE_TIMING_WHEEL */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -230,8 +375,176 @@ Change the function prvAddTaskToReadyList to arrange the list with respect to th
 	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
 	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 #else
-#define prvAddTaskToReadyList( pxTCB ) /*xGenericListIteam must contain the deadline value */ \
-vListInsert( &(xReadyTasksListEDF), &( ( pxTCB )->xStateListItem ) )
+/* The absolute deadline of the current job of a periodic task.  It is anchored
+to the nominal release time of the job rather than to the tick at which the
+task was unblocked, so late tick processing does not make deadlines drift. */
+#define taskEDF_ABSOLUTE_DEADLINE( pxTCB ) ( ( pxTCB )->xTaskReleaseTime + ( pxTCB )->xTaskRelativeDeadline )
+
+/* Tick values are compared by the sign of their difference, so the order holds
+when the tick count overflows.  The times compared must be less than half the
+tick range apart, which absolute deadlines always are as a relative deadline is
+at most a period.  Nothing is re-sorted when the tick count wraps. */
+#define taskEDF_TICK_SIGN_BIT			( ( TickType_t ) ( ( portMAX_DELAY >> 1 ) + ( TickType_t ) 1U ) )
+#define taskEDF_TIME_BEFORE( xA, xB )	( ( ( TickType_t ) ( ( xA ) - ( xB ) ) & taskEDF_TICK_SIGN_BIT ) != ( TickType_t ) 0U )
+
+/* Ready keys are compared the same way, except that portMAX_DELAY, used for
+the background deadline and while no deadline is inherited, is later than any
+other key.  A deadline that falls on portMAX_DELAY is keyed a tick early so it
+is not taken for one of those. */
+#define taskEDF_DEADLINE_KEY( xDeadline )	( ( TickType_t ) ( ( xDeadline ) - ( ( ( xDeadline ) == portMAX_DELAY ) ? ( TickType_t ) 1U : ( TickType_t ) 0U ) ) )
+#define taskEDF_DEADLINE_BEFORE( xA, xB )																\
+	( ( ( xA ) != portMAX_DELAY ) && ( ( ( xB ) == portMAX_DELAY ) || taskEDF_TIME_BEFORE( ( xA ), ( xB ) ) ) )
+
+/* The period and relative deadline a task is admitted with.  While a timing
+change is pending the task can release jobs with either its current or its new
+timing, so it is admitted with the shorter of each, see xTaskModeChange(). */
+#define taskEDF_ADMITTED_PERIOD( pxTCB )																\
+	( ( ( ( pxTCB )->xPendingPeriod != ( TickType_t ) 0U ) && ( ( pxTCB )->xPendingPeriod < ( pxTCB )->xTaskPeriod ) ) ? ( pxTCB )->xPendingPeriod : ( pxTCB )->xTaskPeriod )
+#define taskEDF_ADMITTED_DEADLINE( pxTCB )																\
+	( ( ( ( pxTCB )->xPendingPeriod != ( TickType_t ) 0U ) && ( ( pxTCB )->xPendingDeadline < ( pxTCB )->xTaskRelativeDeadline ) ) ? ( pxTCB )->xPendingDeadline : ( pxTCB )->xTaskRelativeDeadline )
+
+/* The utilisation test is only exact when every deadline equals the period and
+nothing runs non-preemptively.  Otherwise the processor demand test has to be
+run as well, which jobs need as soon as one of them can delay another. */
+#if ( configUSE_EDF_JOBS == 1 )
+	#define taskEDF_DEMAND_TEST_NEEDED()																	\
+		( ( ( uxConstrainedDeadlineTasks > ( UBaseType_t ) 0U ) || ( uxPeriodicJobs > ( UBaseType_t ) 1U ) ) ? pdTRUE : pdFALSE )
+#else
+	#define taskEDF_DEMAND_TEST_NEEDED() ( ( uxConstrainedDeadlineTasks > ( UBaseType_t ) 0U ) ? pdTRUE : pdFALSE )
+#endif
+
+/* The deadline the current job is scheduled by before any inheritance.  A job
+that has used its whole budget keeps running in the background, after every
+job that still has budget left but before the idle task. */
+#if ( configUSE_EDF_BUDGETS == 1 )
+	#define taskEDF_BACKGROUND_DEADLINE		portMAX_DELAY
+	#define taskEDF_JOB_DEADLINE( pxTCB )																\
+		( ( ( pxTCB )->xBudgetExhausted != pdFALSE ) ? taskEDF_BACKGROUND_DEADLINE : taskEDF_DEADLINE_KEY( taskEDF_ABSOLUTE_DEADLINE( pxTCB ) ) )
+#else
+	#define taskEDF_JOB_DEADLINE( pxTCB ) taskEDF_DEADLINE_KEY( taskEDF_ABSOLUTE_DEADLINE( pxTCB ) )
+#endif
+
+#if ( configUSE_MUTEXES == 1 )
+	/* Value of xInheritedDeadline while a task is not inheriting a deadline. */
+	#define taskEDF_NO_INHERITED_DEADLINE	portMAX_DELAY
+
+	/* The deadline a ready task is scheduled by.  While it holds a mutex a
+	task runs on the earlier deadline of a task blocked on that mutex, see
+	xTaskPriorityInherit(). */
+	#define taskEDF_READY_DEADLINE( pxTCB )																\
+		( taskEDF_DEADLINE_BEFORE( ( pxTCB )->xInheritedDeadline, taskEDF_JOB_DEADLINE( pxTCB ) ) ? ( pxTCB )->xInheritedDeadline : taskEDF_JOB_DEADLINE( pxTCB ) )
+	#define taskEDF_HAS_INHERITED_DEADLINE( pxTCB ) ( ( pxTCB )->xInheritedDeadline != taskEDF_NO_INHERITED_DEADLINE )
+#else
+	#define taskEDF_READY_DEADLINE( pxTCB ) taskEDF_JOB_DEADLINE( pxTCB )
+#endif
+
+/* The xStateListItem value is set to the deadline the task is scheduled by.
+With the ready heap the list item is only appended to xReadyTasksListEDF so the
+state of the task can still be found from its container, the deadline ordering
+is held by the heap.  Without it the list itself is kept in deadline order. */
+#if ( configUSE_EDF_READY_HEAP == 1 )
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), taskEDF_READY_DEADLINE( pxTCB ) );	\
+		vListInsertEnd( &( xReadyTasksListEDF ), &( ( pxTCB )->xStateListItem ) );						\
+		prvReadyHeapInsert( pxTCB );																	\
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#else
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), taskEDF_READY_DEADLINE( pxTCB ) );	\
+		prvReadyHeapInsert( pxTCB );																	\
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#endif
+#endif
+
+/*
+ * Must be called before the xStateListItem of a task is removed from whichever
+ * list it is in.  If the task is in the EDF ready list it is also taken out of
+ * the ready heap.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	/* Under the Stack Resource Policy the preemption level of a task is
+	derived from its relative deadline, the shorter the deadline the higher the
+	level.  A job that has not started yet may only start while its level is
+	above the system ceiling.  A job that has started always continues. */
+	#if ( configUSE_EDF_SRP == 1 )
+		#define taskSRP_MAY_RUN( pxTCB ) ( ( ( pxTCB )->xJobStarted != pdFALSE ) || ( ( pxTCB )->xTaskRelativeDeadline < xSrpSystemCeiling ) )
+	#else
+		#define taskSRP_MAY_RUN( pxTCB ) ( pdTRUE )
+	#endif
+
+	/* A task made ready only preempts the running task if its deadline is
+	strictly earlier, or if the running task is not in the EDF ready list.  That
+	is the idle task, or a task that has left the Ready state and is waiting for
+	a pending yield.  Under SRP it must also be allowed to run.  The deadline is
+	taken from the TCB rather than the ready key, so this also holds for a task
+	that is only pending ready. */
+	#define taskEDF_PREEMPTS_CURRENT( pxTCB )																\
+		( ( taskSRP_MAY_RUN( pxTCB ) != pdFALSE ) &&														\
+		  ( ( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( pxCurrentTCB->xStateListItem ) ) == pdFALSE ) ||	\
+			( taskEDF_DEADLINE_BEFORE( taskEDF_READY_DEADLINE( pxTCB ), listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ) ) ) ) ) )
+
+	/* The task with the earliest deadline of those in the Ready state, which
+	must not be called while xReadyTasksListEDF is empty. */
+	#if ( configUSE_EDF_READY_HEAP == 1 )
+		#define taskEDF_EARLIEST_READY_TASK() ( pxReadyHeapEDF[ 0 ] )
+	#else
+		#define taskEDF_EARLIEST_READY_TASK() ( ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xReadyTasksListEDF ) ) )
+	#endif
+
+	/* Without the heap the caller's uxListRemove() is all that is needed. */
+	#if ( configUSE_EDF_READY_HEAP == 1 )
+		#define taskREMOVE_FROM_READY_HEAP( pxTCB )														\
+		{																								\
+			if( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( ( pxTCB )->xStateListItem ) ) != pdFALSE )	\
+			{																							\
+				prvReadyHeapRemove( pxTCB );															\
+			}																							\
+		}
+	#else
+		#define taskREMOVE_FROM_READY_HEAP( pxTCB )
+	#endif
+#else
+	#define taskREMOVE_FROM_READY_HEAP( pxTCB )
+#endif
+
+/* A server never calls vTaskDelayUntil() or xTaskWaitForNextPeriod(), so its
+timing cannot be changed with xTaskModeChange(). */
+#if ( configUSE_EDF_CBS == 1 )
+	#define taskEDF_IS_CBS_SERVER( pxTCB ) ( ( ( pxTCB )->pxCbsJobs != NULL ) ? pdTRUE : pdFALSE )
+#else
+	#define taskEDF_IS_CBS_SERVER( pxTCB ) ( pdFALSE )
+#endif
+
+/* A job server takes the timing of each job it runs. */
+#if ( configUSE_EDF_JOBS == 1 )
+	#define taskEDF_IS_JOB_SERVER( pxTCB ) prvIsJobServer( pxTCB )
+#else
+	#define taskEDF_IS_JOB_SERVER( pxTCB ) ( pdFALSE )
+#endif
+
+/* Values that can be assigned to the uxSporadicState member of the TCB.  The
+state only changes with interrupts masked, as releases come from interrupts. */
+#if ( configUSE_EDF_SPORADIC == 1 )
+	#define taskSPORADIC_NONE			( ( UBaseType_t ) 0U )	/* The task is periodic. */
+	#define taskSPORADIC_RUNNING		( ( UBaseType_t ) 1U )	/* The current job has been released and has not completed. */
+	#define taskSPORADIC_WAITING		( ( UBaseType_t ) 2U )	/* The task is blocked in vTaskSporadicWait() with no release pending. */
+	#define taskSPORADIC_PENDING		( ( UBaseType_t ) 3U )	/* The next job was released before the current job completed. */
+#endif
+
+/* Only the EDF scheduler inherits deadlines, the priority scheduler only
+inherits priorities. */
+#if ( configUSE_EDF_SCHEDULER == 0 )
+	#define taskEDF_HAS_INHERITED_DEADLINE( pxTCB ) ( pdFALSE )
+#endif
+
+/* Whether a task that has been unblocked by an event, a notification or an
+aborted delay should preempt the running task. */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	#define taskUNBLOCKED_TASK_PREEMPTS( pxTCB ) taskEDF_PREEMPTS_CURRENT( pxTCB )
+#else
+	#define taskUNBLOCKED_TASK_PREEMPTS( pxTCB ) ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
 #endif
 /*-----------------------------------------------------------*/
 
@@ -257,6 +570,52 @@ to its original value when it is released. */
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
 #endif
 
+/* Under EDF the item value holds the deadline the task is scheduled by, which
+can have any bit set as the tick count wraps, so ucEventListItemInUse records
+that the value is borrowed instead of taskEVENT_LIST_ITEM_VALUE_IN_USE.  The key
+is never configMAX_PRIORITIES, so the queue code can still pass the first key of
+a mutex's waiting list to vTaskPriorityDisinheritAfterTimeout() as
+configMAX_PRIORITIES - key and use tskIDLE_PRIORITY for an empty list. */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	#define taskEVENT_LIST_ITEM_KEY( pxTCB )																\
+		( ( TickType_t ) ( taskEDF_READY_DEADLINE( pxTCB ) - ( ( taskEDF_READY_DEADLINE( pxTCB ) == ( TickType_t ) configMAX_PRIORITIES ) ? ( TickType_t ) 1U : ( TickType_t ) 0U ) ) )
+	#define taskEVENT_LIST_ITEM_IS_FREE( pxTCB ) ( ( pxTCB )->ucEventListItemInUse == ( uint8_t ) pdFALSE )
+#else
+	#define taskEVENT_LIST_ITEM_KEY( pxTCB ) ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) ( pxTCB )->uxPriority )
+	#define taskEVENT_LIST_ITEM_IS_FREE( pxTCB ) ( ( listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+#endif
+
+/*
+ * An aperiodic job queued on a Constant Bandwidth Server, see xTaskCbsSubmit().
+ * StaticCbsJob_t in FreeRTOS.h must have the same size.
+ */
+#if ( configUSE_EDF_CBS == 1 )
+	typedef struct tskCbsJob
+	{
+		TaskFunction_t pxJobCode;
+		void *pvParameters;
+	} CbsJob_t;
+#endif
+
+/*
+ * A periodic job run to completion by the job server, see xTaskJobCreate().
+ * StaticJob_t in FreeRTOS.h must have the same size.
+ */
+#if ( configUSE_EDF_JOBS == 1 )
+	typedef struct tskJob
+	{
+		ListItem_t xJobListItem; /*< In the xPendingJobsList of its server by release time while the job waits for its release, in its xReadyJobsList by deadline once released. */
+		TaskFunction_t pxJobCode; /*< Called once for each release. */
+		void *pvParameters;
+		TickType_t xReleaseTime; /*< Release of the current job, or of the next one while it waits. */
+		TickType_t xPeriod;
+		TickType_t xRelativeDeadline;
+		TickType_t xWCET;
+		struct tskJob *pxNextJob; /*< Next job in the chain of admitted jobs. */
+		struct tskJobServer *pxServer; /*< The server that runs the job. */
+	} Job_t;
+#endif
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -347,8 +706,50 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 	/* E.C. : the period of a task */
 	#if ( configUSE_EDF_SCHEDULER == 1 )
 	TickType_t xTaskPeriod; /*< Stores the period in tick of the task. > */
-	#define initIDLEPeriod (TickType_t)1000
-
+	UBaseType_t uxReadyHeapIndex; /*< Position of the task in the ready heap, only valid while the task is in xReadyTasksListEDF. */
+	UBaseType_t uxDeadlineMisses; /*< Number of jobs that completed after their absolute deadline. */
+	TickType_t xWorstLateness; /*< Largest number of ticks a job has completed after its deadline. */
+	TickType_t xLastMissTick; /*< Tick count at which the last late job completed. */
+	TickType_t xTaskRelativeDeadline; /*< Time from the release of a job to its deadline, never greater than xTaskPeriod. */
+	TickType_t xTaskReleaseTime; /*< Nominal release time of the current job, or of the next job while the task waits in vTaskDelayUntil() or xTaskWaitForNextPeriod(). */
+	TickType_t xTaskWCET; /*< Worst case execution time of a job in ticks, 0 if not known. */
+	uint32_t ulUtilisation; /*< xTaskWCET / xTaskPeriod in units of 1 / taskEDF_UTILISATION_ONE. */
+	struct tskTaskControlBlock *pxNextPeriodicTCB; /*< Links all the admitted periodic tasks for the admission test. */
+	TickType_t xPendingPeriod; /*< Period from the next release on, set by xTaskModeChange().  0 if no change is pending. */
+	TickType_t xPendingDeadline; /*< Relative deadline from the next release on, only valid while xPendingPeriod is not 0. */
+	uint8_t ucEventListItemInUse; /*< pdTRUE while the event groups borrow the value of xEventListItem. */
+	#if ( configUSE_MUTEXES == 1 )
+	TickType_t xInheritedDeadline; /*< Earliest deadline inherited from a task blocked on a mutex this task holds, taskEDF_NO_INHERITED_DEADLINE if none. */
+	#endif
+	#if ( configUSE_EDF_SRP == 1 )
+	BaseType_t xJobStarted; /*< pdTRUE once the current job has first run, it no longer has to pass the SRP preemption test. */
+	#endif
+	#if ( configUSE_EDF_OVERRUN_POLICY == 1 )
+	UBaseType_t uxOverrunPolicy; /*< One of the taskOVERRUN_ values, applied by the tick when the running job passes its deadline. */
+	TickType_t xSkippedTicks; /*< Ticks the current job was moved on by taskOVERRUN_SKIP_NEXT, added to the next wake time. */
+	BaseType_t xRestartPending; /*< pdTRUE if the job was abandoned, the task function restarts when the task is next selected. */
+	TaskFunction_t pxTaskCode; /*< Function and parameter the task function is restarted with. */
+	void *pvParameters;
+	TaskFunction_t pxFallbackCode; /*< Function run from the next release on under taskOVERRUN_DEGRADE. */
+	StackType_t *pxInitialTopOfStack; /*< Top of stack before pxPortInitialiseStack(), reused when the task function is restarted. */
+	#endif
+	#if ( configUSE_EDF_BUDGETS == 1 )
+	uint32_t ulBudget; /*< xTaskWCET in run time counter counts, 0 if the task is not charged. */
+	uint32_t ulBudgetUsed; /*< Run time used by the current job so far. */
+	BaseType_t xBudgetExhausted; /*< pdTRUE once the current job has used its budget, it then runs in the background until its next job. */
+	#endif
+	#if ( configUSE_EDF_CBS == 1 )
+	CbsJob_t *pxCbsJobs; /*< Job queue of a Constant Bandwidth Server, NULL if the task is not a server. */
+	UBaseType_t uxCbsLength; /*< Number of jobs pxCbsJobs can hold. */
+	UBaseType_t uxCbsHead; /*< Index of the oldest queued job. */
+	UBaseType_t uxCbsWaiting; /*< Number of queued jobs. */
+	#endif
+	#if ( configUSE_EDF_SPORADIC == 1 )
+	UBaseType_t uxSporadicState; /*< One of the taskSPORADIC_ values, taskSPORADIC_NONE if the task is periodic.  xTaskPeriod holds the minimum inter-arrival time of a sporadic task. */
+	TickType_t xPendingRelease; /*< Release time of the next job, only valid in taskSPORADIC_PENDING. */
+	UBaseType_t uxEarlyReleases; /*< Releases that came less than the minimum inter-arrival time after the previous one, and were deferred. */
+	UBaseType_t uxDroppedReleases; /*< Releases that came while the next job was already pending, and were dropped. */
+	#endif
 	#endif
 
 } tskTCB;
@@ -357,6 +758,22 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+/*
+ * A job server, see xTaskJobServerCreate().  It runs its jobs one at a time,
+ * so they all use the stack of its task.
+ */
+#if ( configUSE_EDF_JOBS == 1 )
+	typedef struct tskJobServer
+	{
+		TCB_t * pxTCB; /*< The task that runs the jobs. */
+		TickType_t xRelativeDeadline; /*< Relative deadline of the jobs it runs, or 0 for every job no other server runs. */
+		List_t xPendingJobsList; /*< Jobs waiting for their next release, earliest release first. */
+		List_t xReadyJobsList; /*< Released jobs the server has not started, earliest deadline first. */
+		volatile BaseType_t xWaiting; /*< pdTRUE while the server is blocked with no job released. */
+		volatile TickType_t xNextRelease; /*< Release time of the job at the head of xPendingJobsList. */
+	} JobServer_t;
+#endif
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
@@ -374,14 +791,38 @@ adding a new ReadyList
 */
 /* The new ReadyList */
 #if ( configUSE_EDF_SCHEDULER == 1 )
-PRIVILEGED_DATA static List_t xReadyTasksListEDF; /*< Ready tasks ordered by their deadline. */
+PRIVILEGED_DATA static List_t xReadyTasksListEDF; /*< Ready tasks, in no particular order with the ready heap, in deadline order without it.  Used to know which tasks are in the Ready state. */
+#if ( configUSE_EDF_READY_HEAP == 1 )
+PRIVILEGED_DATA static TCB_t * pxReadyHeapEDF[ configEDF_MAX_READY_TASKS ]; /*< Binary min-heap of the ready tasks keyed by deadline.  The earliest deadline is always at index 0. */
+PRIVILEGED_DATA static UBaseType_t uxReadyHeapLength = ( UBaseType_t ) 0U;
+PRIVILEGED_DATA static UBaseType_t uxReadyHeapTasks = ( UBaseType_t ) 0U; /*< Tasks that can be in the heap, every task but the idle task.  Never more than configEDF_MAX_READY_TASKS. */
+#endif
+PRIVILEGED_DATA static uint32_t ulTotalUtilisation = 0UL; /*< Sum of the utilisation of all the periodic tasks, in units of 1 / taskEDF_UTILISATION_ONE. */
+PRIVILEGED_DATA static TCB_t * pxPeriodicTasks = NULL; /*< Head of the chain of admitted periodic tasks. */
+PRIVILEGED_DATA static UBaseType_t uxConstrainedDeadlineTasks = ( UBaseType_t ) 0U; /*< Number of admitted tasks with a deadline shorter than their period. */
+PRIVILEGED_DATA static volatile UBaseType_t uxAvoidedContextSwitches = ( UBaseType_t ) 0U; /*< Ticks that released jobs without a context switch, as none had an earlier deadline than the running task. */
+#endif
+
+#if ( configUSE_EDF_JOBS == 1 )
+PRIVILEGED_DATA static JobServer_t xJobServers[ configEDF_JOB_SERVERS ]; /*< The servers created by xTaskJobServerCreate(), in the order they were created. */
+PRIVILEGED_DATA static volatile UBaseType_t uxJobServers = ( UBaseType_t ) 0U; /*< Number of servers at the start of xJobServers. */
+PRIVILEGED_DATA static Job_t * pxPeriodicJobs = NULL; /*< Head of the chain of admitted jobs. */
+PRIVILEGED_DATA static UBaseType_t uxPeriodicJobs = ( UBaseType_t ) 0U; /*< Number of admitted jobs with a WCET. */
+#endif
+
+#if ( configUSE_EDF_SRP == 1 )
+PRIVILEGED_DATA static TickType_t xSrpSystemCeiling = portMAX_DELAY; /*< Lowest ceiling of the resources currently locked, as a relative deadline.  portMAX_DELAY while none are locked. */
 #endif
 
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
+#if ( configUSE_TIMING_WHEEL == 0 )
 PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#else
+PRIVILEGED_DATA static List_t xTimingWheel[ taskWHEEL_LISTS ];			/*< Delayed tasks, in the list of the level and slot their wake time falls in. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -470,6 +911,272 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif /* INCLUDE_vTaskSuspend */
 
+/*
+ * Binary heap holding the EDF ready tasks.  The key of each task is the
+ * deadline held in its xStateListItem, so a task must not have its deadline
+ * changed while it is in the heap without calling prvReadyHeapRemove() first.
+ * Insert and remove are O(log n), the task with the earliest deadline is
+ * always pxReadyHeapEDF[ 0 ].  Must be called from a critical section or with
+ * the scheduler suspended, as is the case for the ready lists.  Without
+ * configUSE_EDF_READY_HEAP, prvReadyHeapInsert() and prvReadyHeapRemove()
+ * insert in and remove from xReadyTasksListEDF in deadline order instead, at a
+ * cost that grows with the number of ready tasks.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static void prvReadyHeapInsert( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+	static void prvReadyHeapRemove( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) )
+
+	static void prvReadyHeapSiftUp( TCB_t *pxTCB, UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+	static void prvReadyHeapSiftDown( TCB_t *pxTCB, UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Used to ready a batch of tasks at once.  prvReadyHeapAppend() adds a task
+	 * to the end of the heap without restoring the order, then
+	 * prvReadyHeapRebuild() restores it in one pass over the ancestors of the
+	 * appended tasks, which costs less than sifting each task up in turn.
+	 */
+	static void prvReadyHeapAppend( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+	static void prvReadyHeapRebuild( UBaseType_t uxFirstAppended ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Inserts a list item whose value is a deadline in deadline order, used for the
+ * event lists and the released jobs.  vListInsert() sorts by the raw item
+ * value, which is wrong for deadlines once the tick count wraps, so the
+ * position is found with taskEDF_DEADLINE_BEFORE() instead.  Items with equal
+ * deadlines stay in the order they were inserted.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static void prvListInsertByDeadline( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Selects the task to run under the Stack Resource Policy, the ready task
+ * with the earliest deadline among those taskSRP_MAY_RUN() allows to run.
+ * Only has to search the ready heap while a resource is locked.
+ */
+#if ( configUSE_EDF_SRP == 1 )
+
+	static TCB_t *prvSrpSelectTask( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from the tick.  prvEnforceOverrunPolicy() applies the overrun policy
+ * of the running task if its job has passed its absolute deadline, and returns
+ * pdTRUE if a context switch is needed.  Only the running job is checked, so
+ * the cost of the tick stays constant.  prvRestartJob() discards the context
+ * of an abandoned job so the task function starts again, it is called when the
+ * task is next selected and never for the task being switched out.
+ */
+#if ( configUSE_EDF_OVERRUN_POLICY == 1 )
+
+	static BaseType_t prvEnforceOverrunPolicy( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+	static void prvRestartJob( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Adds the run time since the running task was switched in to its run time
+ * counter.  With configUSE_EDF_BUDGETS the same time is charged to the budget
+ * of the running job, which is moved to the background once it has used the
+ * whole budget.  pdTRUE is returned if another job then comes before it in the
+ * ready heap.  Called on every switch out,
+ * and from the tick so a job that never blocks is still caught.
+ * prvRefillBudget() ends the budget of the running job and starts a new one,
+ * it is called whenever the running task starts a new job.
+ */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static BaseType_t prvUpdateRunTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_EDF_BUDGETS == 1 )
+
+	static void prvRefillBudget( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Constant Bandwidth Server.  prvCbsServerTask() is the task function of every
+ * server, it runs the queued jobs in the order they were submitted and blocks
+ * on its notification while there are none.  prvInitialiseCbsServer() turns a
+ * newly created periodic task into a server.  prvCbsQueueJob() must be called
+ * from a critical section, it queues a job and applies the CBS arrival rule,
+ * and returns errQUEUE_FULL if the queue has no space.
+ */
+#if ( configUSE_EDF_CBS == 1 )
+
+	static portTASK_FUNCTION_PROTO( prvCbsServerTask, pvParameters );
+	static void prvInitialiseCbsServer( TCB_t *pxTCB, CbsJob_t *pxJobs, UBaseType_t uxQueueLength ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvCbsQueueJob( TCB_t *pxTCB, TaskFunction_t pxJobCode, void *pvParameters ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Releases the next job of a sporadic task, must be called from a critical
+ * section or with interrupts masked.  A release that comes less than the
+ * minimum inter-arrival time after the previous one is deferred until that
+ * time has passed.  At most one release is held while the current job runs,
+ * any more are dropped.  Returns pdFAIL if the release was dropped and pdPASS
+ * otherwise.  *pxYieldRequired is set to pdTRUE if the task was waiting for the
+ * release and now preempts the running task.
+ */
+#if ( configUSE_EDF_SPORADIC == 1 )
+
+	static BaseType_t prvSporadicRelease( TCB_t *pxTCB, BaseType_t * const pxYieldRequired ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Run-to-completion jobs.  prvJobServerTask() is the task function of a job
+ * server, it runs the released jobs of the server in deadline order, each to
+ * completion, and blocks until the next release while there are none.
+ * prvInitialiseJob() admits a new job, gives it to the server for its relative
+ * deadline and releases its first job.  prvQueueJob() puts a job in the
+ * xPendingJobsList of its server for its next release, and prvReleaseJobs()
+ * moves every job of a server whose release has been reached to its
+ * xReadyJobsList.  Both must be called from a critical section, and return
+ * pdTRUE if the server should now preempt the running task.  prvAdmitJob()
+ * must be called with the scheduler suspended.  prvFindJobServer() returns the
+ * server created for a relative deadline, or NULL if there is none.
+ */
+#if ( configUSE_EDF_JOBS == 1 )
+
+	static portTASK_FUNCTION_PROTO( prvJobServerTask, pvParameters );
+	static BaseType_t prvInitialiseJob( Job_t *pxNewJob, TaskFunction_t pxJobCode, void * const pvParameters, TickType_t xPeriod, TickType_t xRelativeDeadline, TickType_t xWCET ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvAdmitJob( Job_t *pxNewJob ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvQueueJob( Job_t *pxJob ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvReleaseJobs( JobServer_t * const pxServer, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+	static JobServer_t *prvFindJobServer( const TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvIsJobServer( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called by a periodic task when its current job completes.  Compares the
+ * completion time against the absolute deadline of the job, not a deadline
+ * inherited through a mutex, and records a miss in the TCB if the job was late.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static void prvCheckForDeadlineMiss( TCB_t *pxTCB, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Admission control for periodic tasks.  prvCalculateUtilisation() returns
+ * xWCET / xPeriod in fixed point, rounded up.  prvAdmitPeriodicTask() must be
+ * called with the scheduler suspended.  It checks the utilisation bound and,
+ * if any task in the set has a deadline shorter than its period, runs the
+ * processor demand test.  If both pass the task is added to the admitted set
+ * and pdPASS is returned, otherwise the set is left unchanged.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static uint32_t prvCalculateUtilisation( TickType_t xWCET, TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvAdmitPeriodicTask( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
+	static void prvInsertPeriodicTask( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+	static void prvRemovePeriodicTask( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Timing changes, called with the scheduler suspended.  prvChangeTaskTiming()
+ * makes the new timing of every task pending and admits the set with both the
+ * current and the new timing of each task, so the jobs released while the set
+ * moves from one to the other cannot overload it.  If the set is not
+ * schedulable nothing is changed.  prvApplyPendingTiming() is called when a
+ * task computes its next release, and gives the task its new timing from that
+ * release on.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static BaseType_t prvChangeTaskTiming( TaskHandle_t const * const pxTasks, TickType_t const * const pxPeriods, TickType_t const * const pxDeadlines, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+	static void prvApplyPendingTiming( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Quick Processor-demand Analysis (QPA, Zhang and Burns) of the admitted
+ * periodic tasks, needed when deadlines are shorter than periods.  Returns
+ * pdPASS if no deadline can be missed.  prvProcessorDemand() returns the
+ * execution time that must complete in [0, xTime], or a value greater than
+ * xTime as soon as it is known to exceed it.  prvLatestDeadlineBefore()
+ * returns the latest absolute deadline of any job that is earlier than xTime,
+ * or 0 if there is none.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static BaseType_t prvProcessorDemandTest( void ) PRIVILEGED_FUNCTION;
+	static TickType_t prvProcessorDemand( const TickType_t xTime ) PRIVILEGED_FUNCTION;
+	static TickType_t prvLatestDeadlineBefore( const TickType_t xTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Jobs run to completion, so a job can be delayed by a job of the same server
+ * with a later deadline that started before it was released.  prvJobBlockingTest() checks
+ * the admitted set still meets every deadline with that delay.
+ */
+#if ( configUSE_EDF_JOBS == 1 )
+
+	static BaseType_t prvJobBlockingTest( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Allocates the TCB and stack of a task created under EDF, in the order set by
+ * portSTACK_GROWTH.  Returns NULL if either could not be allocated.
+ * prvCreateIdleTask() creates the idle task from the heap, it is only needed
+ * when the application does not provide the idle task's memory.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	static TCB_t *prvAllocateTask( const configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+
+	#if( configSUPPORT_STATIC_ALLOCATION == 0 )
+		static BaseType_t prvCreateIdleTask( void ) PRIVILEGED_FUNCTION;
+	#endif
+
+#endif
+
+/*
+ * Used by both the dynamic and the static creation functions under EDF, once
+ * the TCB and stack are known.  prvInitialisePeriodicTask() runs the admission
+ * test and, if the task is admitted, initialises it and releases its first job.
+ * If it is not admitted errTASK_SET_NOT_SCHEDULABLE is returned, or
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if the ready heap already has a place
+ * for configEDF_MAX_READY_TASKS tasks, and the memory is left for the caller to
+ * free.  prvInitialiseIdleTask() initialises the idle
+ * task, which is not periodic, is never added to the EDF ready heap and has no
+ * deadline.  vTaskSwitchContext() selects it only when the heap is empty.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static BaseType_t prvInitialisePeriodicTask( TCB_t *pxNewTCB,
+												 TaskFunction_t pxTaskCode,
+												 const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+												 const uint32_t ulStackDepth,
+												 void * const pvParameters,
+												 UBaseType_t uxPriority,
+												 TaskHandle_t * const pxCreatedTask,
+												 TickType_t xPeriod,
+												 TickType_t xRelativeDeadline,
+												 TickType_t xWCET ) PRIVILEGED_FUNCTION;
+	static void prvInitialiseIdleTask( TCB_t *pxNewTCB, const uint32_t ulStackDepth ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Utility to ready all the lists used by the scheduler.  This is called
  * automatically upon the creation of the first task.
@@ -571,6 +1278,28 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+/*
+ * Insert a blocked task in the timing wheel, in the list of the lowest level
+ * that still reaches the wake time held in the value of pxListItem.  xFirstTick
+ * is the first tick the wheel has not processed yet.
+ */
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	static void prvTimingWheelInsert( ListItem_t * const pxListItem, const TickType_t xFirstTick ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from the tick interrupt for xTime.  Moves the tasks of any list whose
+ * span starts on xTime down the wheel, and returns the level 0 list that holds
+ * the tasks that wake on xTime.
+ */
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	static List_t * prvTimingWheelAdvance( const TickType_t xTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -613,9 +1342,70 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
 /*-----------------------------------------------------------*/
 
-#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+	BaseType_t xTaskPeriodicCreateStatic(	TaskFunction_t pxTaskCode,
+											const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const uint32_t ulStackDepth,
+											void * const pvParameters,
+											UBaseType_t uxPriority,
+											StackType_t * const puxStackBuffer,
+											StaticTask_t * const pxTaskBuffer,
+											TaskHandle_t * const pxCreatedTask,
+											TickType_t xPeriod,
+											TickType_t xRelativeDeadline,
+											TickType_t xWCET )
+	{
+	TCB_t *pxNewTCB;
+	BaseType_t xReturn;
 
-	TaskHandle_t xTaskCreateStatic(	TaskFunction_t pxTaskCode,
+		configASSERT( puxStackBuffer != NULL );
+		configASSERT( pxTaskBuffer != NULL );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticTask_t equals the size of the real task
+			structure, including the EDF members. */
+			volatile size_t xSize = sizeof( StaticTask_t );
+			configASSERT( xSize == sizeof( TCB_t ) );
+			( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+		}
+		#endif /* configASSERT_DEFINED */
+
+		/* Only constrained deadlines are supported, a job must complete
+		before the next one is released. */
+		if( ( pxTaskBuffer == NULL ) || ( puxStackBuffer == NULL ) ||
+			( xRelativeDeadline == ( TickType_t ) 0U ) || ( xRelativeDeadline > xPeriod ) )
+		{
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			/* The memory used for the task's TCB and stack are passed into this
+			function - use them.  Nothing is allocated, so the time taken only
+			depends on the stack depth and the size of the admitted task set. */
+			pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+			pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
+
+			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+			{
+				/* Tasks can be created statically or dynamically, so note this
+				task was created statically in case the task is later deleted. */
+				pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+			}
+			#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+			/* If the task is not admitted the buffers are simply not used. */
+			xReturn = prvInitialisePeriodicTask( pxNewTCB, pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxCreatedTask, xPeriod, xRelativeDeadline, xWCET );
+		}
+
+		return xReturn;
+	}
+
+#elif( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	TaskHandle_t xTaskCreateStatic(	TaskFunction_t pxTaskCode,
 									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 									const uint32_t ulStackDepth,
 									void * const pvParameters,
@@ -783,18 +1573,89 @@ BaseType_t xTaskPeriodicCreate(	TaskFunction_t pxTaskCode,
 							UBaseType_t uxPriority,
 							TaskHandle_t * const pxCreatedTask,
 							TickType_t period)
+	{
+		/* The execution time is not known, so the task does not take part in
+		the admission test. */
+		return xTaskPeriodicCreateWithDeadline( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, period, period, ( TickType_t ) 0U );
+	}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskPeriodicCreateWithWCET(	TaskFunction_t pxTaskCode,
+							const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+							const configSTACK_DEPTH_TYPE usStackDepth,
+							void * const pvParameters,
+							UBaseType_t uxPriority,
+							TaskHandle_t * const pxCreatedTask,
+							TickType_t period,
+							TickType_t xWCET )
+	{
+		/* Implicit deadline, the deadline of each job is the next release. */
+		return xTaskPeriodicCreateWithDeadline( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, period, period, xWCET );
+	}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskPeriodicCreateWithDeadline(	TaskFunction_t pxTaskCode,
+							const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+							const configSTACK_DEPTH_TYPE usStackDepth,
+							void * const pvParameters,
+							UBaseType_t uxPriority,
+							TaskHandle_t * const pxCreatedTask,
+							TickType_t period,
+							TickType_t xRelativeDeadline,
+							TickType_t xWCET )
 	{
 	TCB_t *pxNewTCB;
 	BaseType_t xReturn;
-		/* If the stack grows down then allocate the stack then the TCB so the stack
-		does not grow into the TCB.  Likewise if the stack grows up then allocate
-		the TCB then the stack. */
-		/* Edit */
-		/* Checking if the periodic value is less than Idle task periodic*/
-		if(period > initIDLEPeriod){
+
+		/* Only constrained deadlines are supported, a job must complete
+		before the next one is released. */
+		if( ( xRelativeDeadline == ( TickType_t ) 0U ) || ( xRelativeDeadline > period ) )
+		{
 			xReturn = pdFAIL;
 			return xReturn;
 		}
+
+		pxNewTCB = prvAllocateTask( usStackDepth );
+
+		if( pxNewTCB != NULL )
+		{
+			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
+			{
+				/* Tasks can be created statically or dynamically, so note this
+				task was created dynamically in case it is later deleted. */
+				pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
+			}
+			#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+			
+			/* 
+			5
+			edit 2 - 2.2 
+			adding the periodic element to the TCB and some other functions 
+			*/
+			xReturn = prvInitialisePeriodicTask( pxNewTCB, pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, period, xRelativeDeadline, xWCET );
+
+			if( xReturn != pdPASS )
+			{
+				vPortFree( pxNewTCB->pxStack );
+				vPortFree( pxNewTCB );
+			}
+		}
+		else
+		{
+			xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+		}
+
+		return xReturn;
+	}
+/*-----------------------------------------------------------*/
+
+	static TCB_t *prvAllocateTask( const configSTACK_DEPTH_TYPE usStackDepth )
+	{
+	TCB_t *pxNewTCB;
+
+		/* If the stack grows down then allocate the stack then the TCB so the stack
+		does not grow into the TCB.  Likewise if the stack grows up then allocate
+		the TCB then the stack. */
 		#if( portSTACK_GROWTH > 0 )
 		{
 			/* Allocate space for the TCB.  Where the memory comes from depends on
@@ -848,27 +1709,28 @@ BaseType_t xTaskPeriodicCreate(	TaskFunction_t pxTaskCode,
 		}
 		#endif /* portSTACK_GROWTH */
 
+		return pxNewTCB;
+	}
+/*-----------------------------------------------------------*/
+
+	#if( configSUPPORT_STATIC_ALLOCATION == 0 )
+
+	static BaseType_t prvCreateIdleTask( void )
+	{
+	TCB_t *pxNewTCB;
+	BaseType_t xReturn;
+
+		pxNewTCB = prvAllocateTask( configMINIMAL_STACK_SIZE );
+
 		if( pxNewTCB != NULL )
 		{
 			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
 			{
-				/* Tasks can be created statically or dynamically, so note this
-				task was created dynamically in case it is later deleted. */
 				pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
 			}
 			#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
-			
-			/* 
-			5
-			edit 2 - 2.2 
-			adding the periodic element to the TCB and some other functions 
-			*/
-			pxNewTCB->xTaskPeriod = period;
-			
-			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
-			
-			listSET_LIST_ITEM_VALUE( &( ( pxNewTCB )->xStateListItem ), ( pxNewTCB)->xTaskPeriod + xTaskGetTickCount());
-			prvAddNewTaskToReadyList( pxNewTCB );
+
+			prvInitialiseIdleTask( pxNewTCB, ( uint32_t ) configMINIMAL_STACK_SIZE );
 
 			xReturn = pdPASS;
 		}
@@ -880,6 +1742,8 @@ BaseType_t xTaskPeriodicCreate(	TaskFunction_t pxTaskCode,
 		return xReturn;
 	}
 
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 #else	/* configUSE_EDF_SCHEDULER == 0*/
 
 BaseType_t xTaskCreate(	TaskFunction_t pxTaskCode,
@@ -975,6 +1839,109 @@ BaseType_t xTaskCreate(	TaskFunction_t pxTaskCode,
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static BaseType_t prvInitialisePeriodicTask( TCB_t *pxNewTCB,
+												 TaskFunction_t pxTaskCode,
+												 const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+												 const uint32_t ulStackDepth,
+												 void * const pvParameters,
+												 UBaseType_t uxPriority,
+												 TaskHandle_t * const pxCreatedTask,
+												 TickType_t xPeriod,
+												 TickType_t xRelativeDeadline,
+												 TickType_t xWCET )
+	{
+	BaseType_t xReturn;
+
+		pxNewTCB->xTaskPeriod = xPeriod;
+		pxNewTCB->xTaskRelativeDeadline = xRelativeDeadline;
+		pxNewTCB->xTaskWCET = xWCET;
+		pxNewTCB->ulUtilisation = prvCalculateUtilisation( xWCET, xPeriod );
+		pxNewTCB->xPendingPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xPendingDeadline = ( TickType_t ) 0U;
+
+		/* Reject the task if the task set would no longer be schedulable.
+		The scheduler is suspended so no other task can be admitted between
+		the test and the task joining the admitted set. */
+		vTaskSuspendAll();
+		{
+			#if ( configUSE_EDF_READY_HEAP == 1 )
+			{
+				/* Every task but the idle task can be ready at the same time,
+				so each needs a place of its own in the ready heap. */
+				if( uxReadyHeapTasks < ( UBaseType_t ) configEDF_MAX_READY_TASKS )
+				{
+					xReturn = prvAdmitPeriodicTask( pxNewTCB );
+
+					if( xReturn != pdFAIL )
+					{
+						uxReadyHeapTasks++;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+				}
+			}
+			#else
+			{
+				xReturn = prvAdmitPeriodicTask( pxNewTCB );
+			}
+			#endif
+		}
+		( void ) xTaskResumeAll();
+
+		if( xReturn == errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY )
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+		else if( xReturn != pdFAIL )
+		{
+			/* The first job is released now.  The release is set first as
+			prvInitialiseNewTask() keys the event list item by the deadline. */
+			pxNewTCB->xTaskReleaseTime = xTaskGetTickCount();
+			prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+			prvAddNewTaskToReadyList( pxNewTCB );
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = errTASK_SET_NOT_SCHEDULABLE;
+		}
+
+		return xReturn;
+	}
+/*-----------------------------------------------------------*/
+
+	static void prvInitialiseIdleTask( TCB_t *pxNewTCB, const uint32_t ulStackDepth )
+	{
+		/* The idle task has no period or deadline and takes no part in the
+		admission test. */
+		pxNewTCB->xTaskPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xTaskRelativeDeadline = ( TickType_t ) 0U;
+		pxNewTCB->xTaskReleaseTime = ( TickType_t ) 0U;
+		pxNewTCB->xTaskWCET = ( TickType_t ) 0U;
+		pxNewTCB->ulUtilisation = 0UL;
+		pxNewTCB->pxNextPeriodicTCB = NULL;
+		pxNewTCB->xPendingPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xPendingDeadline = ( TickType_t ) 0U;
+
+		/* prvInitialiseNewTask() sets xIdleTaskHandle, which is how
+		prvAddNewTaskToReadyList() knows to keep the task out of the ready
+		heap. */
+		prvInitialiseNewTask( prvIdleTask, configIDLE_TASK_NAME, ulStackDepth, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), &xIdleTaskHandle, pxNewTCB, NULL );
+		prvAddNewTaskToReadyList( pxNewTCB );
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
 	
 static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
 									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
@@ -1090,6 +2057,12 @@ UBaseType_t x;
 	{
 		pxNewTCB->uxBasePriority = uxPriority;
 		pxNewTCB->uxMutexesHeld = 0;
+
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+		{
+			pxNewTCB->xInheritedDeadline = taskEDF_NO_INHERITED_DEADLINE;
+		}
+		#endif
 	}
 	#endif /* configUSE_MUTEXES */
 
@@ -1100,9 +2073,13 @@ UBaseType_t x;
 	back to	the containing TCB from a generic item in a list. */
 	listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
 
-	/* Event lists are always in priority order. */
-
-	listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+	/* Event lists are always in priority order, or in deadline order under
+	EDF in which case the value is set once the deadline is known. */
+	#if ( configUSE_EDF_SCHEDULER == 0 )
+	{
+		listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+	}
+	#endif
 	listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
 	{
@@ -1122,6 +2099,67 @@ UBaseType_t x;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		pxNewTCB->uxDeadlineMisses = ( UBaseType_t ) 0U;
+		pxNewTCB->xWorstLateness = ( TickType_t ) 0U;
+		pxNewTCB->xLastMissTick = ( TickType_t ) 0U;
+
+		#if ( configUSE_EDF_SRP == 1 )
+		{
+			pxNewTCB->xJobStarted = pdFALSE;
+		}
+		#endif
+
+		#if ( configUSE_EDF_OVERRUN_POLICY == 1 )
+		{
+			/* Keep what is needed to restart the task function if a job is
+			abandoned. */
+			pxNewTCB->uxOverrunPolicy = taskOVERRUN_CONTINUE;
+			pxNewTCB->xSkippedTicks = ( TickType_t ) 0U;
+			pxNewTCB->xRestartPending = pdFALSE;
+			pxNewTCB->pxTaskCode = pxTaskCode;
+			pxNewTCB->pvParameters = pvParameters;
+			pxNewTCB->pxFallbackCode = NULL;
+			pxNewTCB->pxInitialTopOfStack = pxTopOfStack;
+		}
+		#endif
+
+		#if ( configUSE_EDF_BUDGETS == 1 )
+		{
+			/* The WCET is set before the task is initialised. */
+			pxNewTCB->ulBudget = ( uint32_t ) pxNewTCB->xTaskWCET * ( uint32_t ) configEDF_RUN_TIME_COUNTS_PER_TICK;
+			pxNewTCB->ulBudgetUsed = 0UL;
+			pxNewTCB->xBudgetExhausted = pdFALSE;
+		}
+		#endif
+
+		#if ( configUSE_EDF_CBS == 1 )
+		{
+			/* Set by prvInitialiseCbsServer() if the task is a server. */
+			pxNewTCB->pxCbsJobs = NULL;
+			pxNewTCB->uxCbsLength = ( UBaseType_t ) 0U;
+			pxNewTCB->uxCbsHead = ( UBaseType_t ) 0U;
+			pxNewTCB->uxCbsWaiting = ( UBaseType_t ) 0U;
+		}
+		#endif
+
+		#if ( configUSE_EDF_SPORADIC == 1 )
+		{
+			/* Set by xTaskSporadicCreate() if the task is sporadic. */
+			pxNewTCB->uxSporadicState = taskSPORADIC_NONE;
+			pxNewTCB->xPendingRelease = ( TickType_t ) 0U;
+			pxNewTCB->uxEarlyReleases = ( UBaseType_t ) 0U;
+			pxNewTCB->uxDroppedReleases = ( UBaseType_t ) 0U;
+		}
+		#endif
+
+		/* Key the event list item by the deadline of the first job. */
+		pxNewTCB->ucEventListItemInUse = ( uint8_t ) pdFALSE;
+		listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), taskEVENT_LIST_ITEM_KEY( pxNewTCB ) );
+	}
+	#endif /* configUSE_EDF_SCHEDULER */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1285,14 +2323,36 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		}
 		#endif /* configUSE_TRACE_FACILITY */
 		traceTASK_CREATE( pxNewTCB );
-		/* edit */
-		#if (configUSE_EDF_SCHEDULER == 1)
+
+		#if ( configUSE_EDF_SCHEDULER == 1 )
 		{
-			listSET_LIST_ITEM_VALUE( &( ( pxNewTCB )->xStateListItem ), ( pxNewTCB)->xTaskPeriod + xTaskGetTickCount());
-		}
-		#endif
+			/* The idle task is the implicit fallback when the ready heap is
+			empty, it is never in the heap itself. */
+			if( pxNewTCB != xIdleTaskHandle )
+			{
+				prvAddTaskToReadyList( pxNewTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-		prvAddTaskToReadyList( pxNewTCB );
+			/* Start with the earliest deadline, rather than whichever task
+			was created last. */
+			if( ( xSchedulerRunning == pdFALSE ) && ( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE ) )
+			{
+				pxCurrentTCB = taskEDF_EARLIEST_READY_TASK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			prvAddTaskToReadyList( pxNewTCB );
+		}
+		#endif /* configUSE_EDF_SCHEDULER */
 
 		portSETUP_TCB( pxNewTCB );
 	}
@@ -1330,7 +2390,22 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			being deleted. */
 			pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
+			#if ( configUSE_EDF_SCHEDULER == 1 )
+			{
+				/* The task no longer takes part in the admission test. */
+				prvRemovePeriodicTask( pxTCB );
+
+				#if ( configUSE_EDF_READY_HEAP == 1 )
+				{
+					/* Nor does it need a place in the ready heap. */
+					uxReadyHeapTasks--;
+				}
+				#endif
+			}
+			#endif
+
 			/* Remove task from the ready/delayed list. */
+			taskREMOVE_FROM_READY_HEAP( pxTCB );
 			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 			{
 				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -1424,15 +2499,50 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		configASSERT( ( xTimeIncrement > 0U ) );
 		configASSERT( uxSchedulerSuspended == 0 );
 
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+		{
+			/* The deadlines and the admission test of a periodic task assume
+			it is released at its period.  A task whose period can change
+			should call xTaskWaitForNextPeriod(), which reads the period from
+			the TCB. */
+			configASSERT( ( pxCurrentTCB->xTaskPeriod == ( TickType_t ) 0U ) || ( xTimeIncrement == pxCurrentTCB->xTaskPeriod ) );
+		}
+		#endif
+
 		vTaskSuspendAll();
 		{
 			/* Minor optimisation.  The tick count cannot change in this
 			block. */
 			const TickType_t xConstTickCount = xTickCount;
 
+			#if ( configUSE_EDF_SCHEDULER == 1 )
+			{
+				/* Calling vTaskDelayUntil() marks the end of the current job
+				of a periodic task, so check it met its deadline. */
+				prvCheckForDeadlineMiss( pxCurrentTCB, xConstTickCount );
+			}
+			#endif
+
+			#if ( configUSE_EDF_BUDGETS == 1 )
+			{
+				/* The next job starts with a full budget, and with its own
+				deadline if it has already been released. */
+				prvRefillBudget();
+			}
+			#endif
+
 			/* Generate the tick time at which the task wants to wake. */
 			xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
 
+			#if ( configUSE_EDF_OVERRUN_POLICY == 1 )
+			{
+				/* Releases skipped by taskOVERRUN_SKIP_NEXT move the next
+				release on by the same number of periods. */
+				xTimeToWake += pxCurrentTCB->xSkippedTicks;
+				pxCurrentTCB->xSkippedTicks = ( TickType_t ) 0U;
+			}
+			#endif
+
 			if( xConstTickCount < *pxPreviousWakeTime )
 			{
 				/* The tick count has overflowed since this function was
@@ -1467,17 +2577,58 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			/* Update the wake time ready for the next call. */
 			*pxPreviousWakeTime = xTimeToWake;
 
-			if( xShouldDelay != pdFALSE )
+			#if ( configUSE_EDF_SCHEDULER == 1 )
 			{
-				traceTASK_DELAY_UNTIL( xTimeToWake );
+				/* The wake time is the nominal release time of the next job,
+				the deadline of that job is measured from it. */
+				pxCurrentTCB->xTaskReleaseTime = xTimeToWake;
 
-				/* prvAddCurrentTaskToDelayedList() needs the block time, not
-				the time to wake, so subtract the current tick count. */
-				prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
+				/* A pending timing change starts with the job released at
+				the release just computed, at the period of the old timing. */
+				if( pxCurrentTCB->xPendingPeriod != ( TickType_t ) 0U )
+				{
+					prvApplyPendingTiming( pxCurrentTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
+			if( xShouldDelay != pdFALSE )
+			{
+				traceTASK_DELAY_UNTIL( xTimeToWake );
+
+				#if ( configUSE_EDF_SRP == 1 )
+				{
+					/* The job is complete, the next job has to pass the
+					preemption test before it can start. */
+					pxCurrentTCB->xJobStarted = pdFALSE;
+				}
+				#endif
+
+				/* prvAddCurrentTaskToDelayedList() needs the block time, not
+				the time to wake, so subtract the current tick count. */
+				prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+			}
+			else
+			{
+				#if ( configUSE_EDF_SCHEDULER == 1 )
+				{
+					/* The previous job overran so the next job has already
+					been released.  It stays ready but gets the deadline of the
+					new job.  The scheduler is suspended so the ready heap can
+					be updated. */
+					prvReadyHeapRemove( pxCurrentTCB );
+					listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), taskEDF_READY_DEADLINE( pxCurrentTCB ) );
+					prvReadyHeapInsert( pxCurrentTCB );
+				}
+				#else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				#endif
 			}
 		}
 		xAlreadyYielded = xTaskResumeAll();
@@ -1497,6 +2648,242 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	BaseType_t xTaskWaitForNextPeriod( void )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+	TickType_t xTimeNow;
+	BaseType_t xWaited;
+
+		configASSERT( pxTCB->xTaskPeriod != ( TickType_t ) 0U );
+		configASSERT( taskEDF_IS_CBS_SERVER( pxTCB ) == pdFALSE );
+		configASSERT( taskEDF_IS_JOB_SERVER( pxTCB ) == pdFALSE );
+		configASSERT( uxSchedulerSuspended == 0 );
+
+		#if ( configUSE_EDF_SPORADIC == 1 )
+		{
+			configASSERT( pxTCB->uxSporadicState == taskSPORADIC_NONE );
+		}
+		#endif
+
+		/* Unlike vTaskDelayUntil() the scheduler is not suspended.  The end
+		of the job and the release of the next are done with interrupts masked
+		so the tick cannot come in between, and there are no pending ready
+		tasks for xTaskResumeAll() to move afterwards. */
+		taskENTER_CRITICAL();
+		{
+			xTimeNow = xTickCount;
+
+			/* Calling xTaskWaitForNextPeriod() marks the end of the current
+			job. */
+			prvCheckForDeadlineMiss( pxTCB, xTimeNow );
+
+			#if ( configUSE_EDF_BUDGETS == 1 )
+			{
+				prvRefillBudget();
+			}
+			#endif
+
+			/* The next job is released one period after the nominal release
+			of this one.  A job moved on by taskOVERRUN_SKIP_NEXT already has
+			the release of the job it replaced, so the skipped ticks that
+			vTaskDelayUntil() adds are not needed. */
+			pxTCB->xTaskReleaseTime += pxTCB->xTaskPeriod;
+
+			#if ( configUSE_EDF_OVERRUN_POLICY == 1 )
+			{
+				pxTCB->xSkippedTicks = ( TickType_t ) 0U;
+			}
+			#endif
+
+			/* A pending timing change starts with the job just released, at
+			the period of the old timing. */
+			if( pxTCB->xPendingPeriod != ( TickType_t ) 0U )
+			{
+				prvApplyPendingTiming( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( taskEDF_TIME_BEFORE( xTimeNow, pxTCB->xTaskReleaseTime ) )
+			{
+				traceTASK_DELAY_UNTIL( pxTCB->xTaskReleaseTime );
+
+				#if ( configUSE_EDF_SRP == 1 )
+				{
+					/* The next job has to pass the preemption test before it
+					can start. */
+					pxTCB->xJobStarted = pdFALSE;
+				}
+				#endif
+
+				prvAddCurrentTaskToDelayedList( pxTCB->xTaskReleaseTime - xTimeNow, pdFALSE );
+				portYIELD_WITHIN_API();
+				xWaited = pdTRUE;
+			}
+			else
+			{
+				/* The job overran so the next job has already been released.
+				It stays ready with the deadline of the new job, which may let
+				another job run first. */
+				prvReadyHeapRemove( pxTCB );
+				listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), taskEDF_READY_DEADLINE( pxTCB ) );
+				prvReadyHeapInsert( pxTCB );
+
+				if( taskEDF_EARLIEST_READY_TASK() != pxTCB )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xWaited = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xWaited;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SPORADIC == 1 )
+
+	void vTaskSporadicWait( void )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+	TickType_t xTimeNow, xTicksToRelease;
+	BaseType_t xAlreadyYielded, xJobCompleted = pdFALSE, xReleased = pdFALSE;
+
+		configASSERT( pxTCB->uxSporadicState != taskSPORADIC_NONE );
+		configASSERT( uxSchedulerSuspended == 0 );
+
+		/* Runs until the next job has been released and its release time has
+		been reached.  The task can run more than once before then, if it was
+		made ready early for a deferred job or resumed while it waited. */
+		while( xReleased == pdFALSE )
+		{
+			vTaskSuspendAll();
+			{
+				xTimeNow = xTickCount;
+
+				if( xJobCompleted == pdFALSE )
+				{
+					/* Calling vTaskSporadicWait() marks the end of the
+					current job. */
+					prvCheckForDeadlineMiss( pxTCB, xTimeNow );
+
+					#if ( configUSE_EDF_BUDGETS == 1 )
+					{
+						prvRefillBudget();
+					}
+					#endif
+
+					/* A pending timing change starts with the next job. */
+					if( pxTCB->xPendingPeriod != ( TickType_t ) 0U )
+					{
+						prvApplyPendingTiming( pxTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Releases come from interrupts, so the state is checked and
+				the task blocked with interrupts masked, otherwise a release in
+				between would be lost. */
+				taskENTER_CRITICAL();
+				{
+					if( xJobCompleted == pdFALSE )
+					{
+						if( pxTCB->uxSporadicState == taskSPORADIC_PENDING )
+						{
+							/* The next job was released while this one ran. */
+							pxTCB->xTaskReleaseTime = pxTCB->xPendingRelease;
+							pxTCB->uxSporadicState = taskSPORADIC_RUNNING;
+						}
+						else
+						{
+							pxTCB->uxSporadicState = taskSPORADIC_WAITING;
+						}
+
+						xJobCompleted = pdTRUE;
+					}
+					else
+					{
+						/* Either still waiting, or released while blocked. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* A deferred release is no more than one inter-arrival
+					time ahead, a release that has been reached gives 0 or
+					wraps. */
+					xTicksToRelease = pxTCB->xTaskReleaseTime - xTimeNow;
+
+					if( pxTCB->uxSporadicState == taskSPORADIC_WAITING )
+					{
+						prvAddCurrentTaskToDelayedList( portMAX_DELAY, pdTRUE );
+					}
+					else if( ( xTicksToRelease != ( TickType_t ) 0U ) && ( xTicksToRelease <= pxTCB->xTaskPeriod ) )
+					{
+						prvAddCurrentTaskToDelayedList( xTicksToRelease, pdFALSE );
+					}
+					else
+					{
+						/* The job has been released, it stays ready with its
+						own deadline. */
+						prvReadyHeapRemove( pxTCB );
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), taskEDF_READY_DEADLINE( pxTCB ) );
+						prvReadyHeapInsert( pxTCB );
+						xReleased = pdTRUE;
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				#if ( configUSE_EDF_SRP == 1 )
+				{
+					/* The next job has to pass the preemption test before it
+					can start. */
+					if( xReleased == pdFALSE )
+					{
+						pxTCB->xJobStarted = pdFALSE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
+			}
+			xAlreadyYielded = xTaskResumeAll();
+
+			/* Force a reschedule if xTaskResumeAll has not already done so,
+			the task may have blocked or have a later deadline. */
+			if( xAlreadyYielded == pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+#endif /* configUSE_EDF_SPORADIC */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 
 	void vTaskDelay( const TickType_t xTicksToDelay )
@@ -1547,7 +2934,10 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	eTaskState eTaskGetState( TaskHandle_t xTask )
 	{
 	eTaskState eReturn;
-	List_t const * pxStateList, *pxDelayedList, *pxOverflowedDelayedList;
+	List_t const * pxStateList;
+	#if ( configUSE_TIMING_WHEEL == 0 )
+		List_t const * pxDelayedList, *pxOverflowedDelayedList;
+	#endif
 	const TCB_t * const pxTCB = xTask;
 
 		configASSERT( pxTCB );
@@ -1557,17 +2947,33 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			/* The task calling this function is querying its own state. */
 			eReturn = eRunning;
 		}
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+			else if( pxTCB == xIdleTaskHandle )
+			{
+				/* The idle task is not in any list under EDF, but is always
+				able to run. */
+				eReturn = eReady;
+			}
+		#endif
 		else
 		{
 			taskENTER_CRITICAL();
 			{
 				pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-				pxDelayedList = pxDelayedTaskList;
-				pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+				#if ( configUSE_TIMING_WHEEL == 0 )
+				{
+					pxDelayedList = pxDelayedTaskList;
+					pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+				}
+				#endif
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+			#if ( configUSE_TIMING_WHEEL == 1 )
+				if( ( pxStateList >= &( xTimingWheel[ 0 ] ) ) && ( pxStateList <= taskWHEEL_FAR_LIST ) )
+			#else
+				if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+			#endif
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1803,15 +3209,20 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				#endif
 
 				/* Only reset the event list item value if the value is not
-				being used for anything else. */
-				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-				{
-					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-				}
-				else
+				being used for anything else.  Under EDF the value holds a
+				deadline, which the priority does not change. */
+				#if ( configUSE_EDF_SCHEDULER == 0 )
 				{
-					mtCOVERAGE_TEST_MARKER();
+					if( taskEVENT_LIST_ITEM_IS_FREE( pxTCB ) )
+					{
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
+				#endif
 
 				/* If the task is in the blocked or suspended list we need do
 				nothing more than change its priority variable. However, if
@@ -1877,6 +3288,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			/* Remove task from the ready/delayed list and place in the
 			suspended list. */
+			taskREMOVE_FROM_READY_HEAP( pxTCB );
 			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 			{
 				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -2148,6 +3560,26 @@ BaseType_t xReturn;
 		/* The Idle task is created using user provided RAM - obtain the
 		address of the RAM then create the idle task. */
 		vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+		{
+		TCB_t *pxIdleTCB = ( TCB_t * ) pxIdleTaskTCBBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment. */
+
+			/* The idle task is not periodic, it is kept out of the EDF ready
+			heap and only runs when the heap is empty. */
+			configASSERT( pxIdleTaskTCBBuffer != NULL );
+			configASSERT( pxIdleTaskStackBuffer != NULL );
+			pxIdleTCB->pxStack = pxIdleTaskStackBuffer;
+
+			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+			{
+				pxIdleTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+			}
+			#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+			prvInitialiseIdleTask( pxIdleTCB, ulIdleTaskStackSize );
+		}
+		#else
 		xIdleTaskHandle = xTaskCreateStatic(	prvIdleTask,
 												configIDLE_TASK_NAME,
 												ulIdleTaskStackSize,
@@ -2155,6 +3587,7 @@ BaseType_t xReturn;
 												portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
 												pxIdleTaskStackBuffer,
 												pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+		#endif
 
 		if( xIdleTaskHandle != NULL )
 		{
@@ -2168,11 +3601,9 @@ BaseType_t xReturn;
 	
 	#elif (configUSE_EDF_SCHEDULER == 1)
 	{
-	/*edit 
-	Initializing the idle task with the new create function and
-	and passing the biggest periodic value in the code
-	*/
-		xReturn = xTaskPeriodicCreate( prvIdleTask, configIDLE_TASK_NAME, configMINIMAL_STACK_SIZE, (void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), &xIdleTaskHandle,	initIDLEPeriod );
+		/* The idle task is not periodic, it is kept out of the EDF ready heap
+		and only runs when the heap is empty. */
+		xReturn = prvCreateIdleTask();
 	}
 	#else
 	{
@@ -2301,6 +3732,35 @@ void vTaskSuspendAll( void )
 
 #if ( configUSE_TICKLESS_IDLE != 0 )
 
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static TickType_t prvGetExpectedIdleTime( void )
+	{
+	TickType_t xReturn;
+
+		/* Under EDF the idle task is only the running task when no other
+		task is ready.  Periodic tasks wait for their next release in the
+		delayed list, so the earliest pending release is also the next unblock
+		time, and nothing can need the processor before then. */
+		if( pxCurrentTCB != xIdleTaskHandle )
+		{
+			xReturn = 0;
+		}
+		else if( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE )
+		{
+			/* A task is ready and is about to preempt the idle task. */
+			xReturn = 0;
+		}
+		else
+		{
+			xReturn = xNextTaskUnblockTime - xTickCount;
+		}
+
+		return xReturn;
+	}
+
+	#else
+
 	static TickType_t prvGetExpectedIdleTime( void )
 	{
 	TickType_t xReturn;
@@ -2359,6 +3819,8 @@ void vTaskSuspendAll( void )
 		return xReturn;
 	}
 
+	#endif /* configUSE_EDF_SCHEDULER */
+
 #endif /* configUSE_TICKLESS_IDLE */
 /*----------------------------------------------------------*/
 
@@ -2384,26 +3846,100 @@ BaseType_t xAlreadyYielded = pdFALSE;
 		{
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
 			{
-				/* Move any readied tasks from the pending list into the
-				appropriate ready list. */
-				while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+				#if ( configUSE_EDF_SCHEDULER == 1 )
 				{
-					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
+				#if ( configUSE_EDF_READY_HEAP == 1 )
+					const UBaseType_t uxFirstAppended = uxReadyHeapLength;
+				#endif
+				BaseType_t xSwitchRequired = pdFALSE;
 
-					/* If the moved task has a priority higher than the current
-					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					/* Move the readied tasks from the pending list in one
+					batch.  Each is appended to the ready heap out of order and
+					the order is restored once all have been moved, rather than
+					with a sorted insert for each. */
+					while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
 					{
-						xYieldPending = pdTRUE;
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+						traceMOVED_TASK_TO_READY_STATE( pxTCB );
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), taskEDF_READY_DEADLINE( pxTCB ) );
+
+						#if ( configUSE_EDF_READY_HEAP == 1 )
+						{
+							vListInsertEnd( &( xReadyTasksListEDF ), &( pxTCB->xStateListItem ) );
+							prvReadyHeapAppend( pxTCB );
+						}
+						#else
+						{
+							/* The ready list has to stay in order, so each
+							task is inserted in turn. */
+							prvReadyHeapInsert( pxTCB );
+						}
+						#endif
+
+						tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );
+
+						/* Only the key of the running task is needed to
+						decide, and that is not moved by the rebuild. */
+						if( taskEDF_PREEMPTS_CURRENT( pxTCB ) != pdFALSE )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 					}
-					else
+
+					#if ( configUSE_EDF_READY_HEAP == 1 )
 					{
-						mtCOVERAGE_TEST_MARKER();
+						if( uxReadyHeapLength != uxFirstAppended )
+						{
+							prvReadyHeapRebuild( uxFirstAppended );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 					}
-				}
+					#endif
+
+					/* One switch decision for the whole batch. */
+					if( xSwitchRequired != pdFALSE )
+					{
+						xYieldPending = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#else
+				{
+					/* Move any readied tasks from the pending list into the
+					appropriate ready list. */
+					while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+					{
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						prvAddTaskToReadyList( pxTCB );
+
+						/* If the moved task has a priority higher than the
+						current task then a yield must be performed. */
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							xYieldPending = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+				}
+				#endif /* configUSE_EDF_SCHEDULER */
 
 				if( pxTCB != NULL )
 				{
@@ -2612,6 +4148,9 @@ TCB_t *pxTCB;
 	{
 	UBaseType_t uxQueue = configMAX_PRIORITIES;
 	TCB_t* pxTCB;
+	#if ( configUSE_TIMING_WHEEL == 1 )
+		UBaseType_t uxList;
+	#endif
 
 		/* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
 		configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
@@ -2633,15 +4172,26 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
+			#if ( configUSE_TIMING_WHEEL == 1 )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				for( uxList = ( UBaseType_t ) 0U; ( uxList < taskWHEEL_LISTS ) && ( pxTCB == NULL ); uxList++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xTimingWheel[ uxList ] ), pcNameToQuery );
+				}
 			}
-
-			if( pxTCB == NULL )
+			#else
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				}
+
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				}
 			}
+			#endif /* configUSE_TIMING_WHEEL */
 
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
@@ -2671,1529 +4221,4511 @@ TCB_t *pxTCB;
 #endif /* INCLUDE_xTaskGetHandle */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	void vTaskGetDeadlineMissInfo( TaskHandle_t xTask, UBaseType_t * const puxMisses, TickType_t * const pxWorstLateness, TickType_t * const pxLastMissTick )
 	{
-	UBaseType_t uxTask = 0;
-	#if (configUSE_EDF_SCHEDULER == 0)
-	uxQueue = configMAX_PRIORITIES;
-	#endif
+	TCB_t *pxTCB;
 
-		vTaskSuspendAll();
+		/* If null is passed in here then the calling task's counters are
+		returned.  Any of the output pointers can be NULL if that value is not
+		required. */
+		taskENTER_CRITICAL();
 		{
-			/* Is there a space in the array for each task in the system? */
-			if( uxArraySize >= uxCurrentNumberOfTasks )
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			if( puxMisses != NULL )
 			{
-				/* Fill in an TaskStatus_t structure with information on each
-				task in the Ready state. */
-				#if (configUSE_EDF_SCHEDULER == 0)
-				do
-				{
-					uxQueue--;
-					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
+				*puxMisses = pxTCB->uxDeadlineMisses;
+			}
 
-				} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-				#else
-					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xReadyTasksListEDF ), eReady );
-				#endif
-				/* Fill in an TaskStatus_t structure with information on each
-				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+			if( pxWorstLateness != NULL )
+			{
+				*pxWorstLateness = pxTCB->xWorstLateness;
+			}
 
-				#if( INCLUDE_vTaskDelete == 1 )
-				{
-					/* Fill in an TaskStatus_t structure with information on
-					each task that has been deleted but not yet cleaned up. */
-					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
-				}
-				#endif
+			if( pxLastMissTick != NULL )
+			{
+				*pxLastMissTick = pxTCB->xLastMissTick;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
 
-				#if ( INCLUDE_vTaskSuspend == 1 )
-				{
-					/* Fill in an TaskStatus_t structure with information on
-					each task in the Suspended state. */
-					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
-				}
-				#endif
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
 
-				#if ( configGENERATE_RUN_TIME_STATS == 1)
-				{
-					if( pulTotalRunTime != NULL )
-					{
-						#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-							portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
-						#else
-							*pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-						#endif
-					}
-				}
-				#else
-				{
-					if( pulTotalRunTime != NULL )
-					{
-						*pulTotalRunTime = 0;
-					}
-				}
-				#endif
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	UBaseType_t uxTaskGetAvoidedContextSwitches( void )
+	{
+		/* The number of ticks that made jobs ready without requesting a
+		context switch, as the running task still had the earliest deadline. */
+		return uxAvoidedContextSwitches;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SRP == 1 )
+
+	TickType_t xTaskSrpLock( TickType_t xResourceCeiling )
+	{
+	TickType_t xPreviousCeiling;
+
+		taskENTER_CRITICAL();
+		{
+			/* The ceiling of a resource is the shortest relative deadline of
+			the tasks that use it, so it cannot be below the preemption level
+			of a task that uses it. */
+			configASSERT( xResourceCeiling <= pxCurrentTCB->xTaskRelativeDeadline );
+
+			/* Resources are unlocked in the reverse order to which they were
+			locked, so the system ceiling is restored from the value returned
+			here rather than recalculated from every locked resource. */
+			xPreviousCeiling = xSrpSystemCeiling;
+
+			if( xResourceCeiling < xSrpSystemCeiling )
+			{
+				xSrpSystemCeiling = xResourceCeiling;
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		( void ) xTaskResumeAll();
+		taskEXIT_CRITICAL();
 
-		return uxTask;
+		/* Raising the ceiling can only hold other jobs back, so never needs a
+		context switch. */
+		return xPreviousCeiling;
 	}
 
-#endif /* configUSE_TRACE_FACILITY */
-/*----------------------------------------------------------*/
+#endif /* configUSE_EDF_SRP */
+/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( configUSE_EDF_SRP == 1 )
 
-	TaskHandle_t xTaskGetIdleTaskHandle( void )
+	void vTaskSrpUnlock( TickType_t xPreviousCeiling )
 	{
-		/* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-		started, then xIdleTaskHandle will be NULL. */
-		configASSERT( ( xIdleTaskHandle != NULL ) );
-		return xIdleTaskHandle;
+		taskENTER_CRITICAL();
+		{
+			xSrpSystemCeiling = xPreviousCeiling;
+
+			/* Jobs held back by the ceiling may now be able to start, and the
+			earliest of them has an earlier deadline than the calling task if
+			the calling task is no longer at the root of the ready heap. */
+			if( taskEDF_EARLIEST_READY_TASK() != pxCurrentTCB )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
 	}
 
-#endif /* INCLUDE_xTaskGetIdleTaskHandle */
-/*----------------------------------------------------------*/
+#endif /* configUSE_EDF_SRP */
+/*-----------------------------------------------------------*/
 
-/* This conditional compilation should use inequality to 0, not equality to 1.
-This is to ensure vTaskStepTick() is available when user defined low power mode
-implementations require configUSE_TICKLESS_IDLE to be set to a value other than
-1. */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( configUSE_EDF_OVERRUN_POLICY == 1 )
 
-	void vTaskStepTick( const TickType_t xTicksToJump )
+	void vTaskSetOverrunPolicy( TaskHandle_t xTask, UBaseType_t uxPolicy, TaskFunction_t pxFallbackCode )
 	{
-		/* Correct the tick count value after a period during which the tick
-		was suppressed.  Note this does *not* call the tick hook function for
-		each stepped tick. */
-		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
-		xTickCount += xTicksToJump;
-		traceINCREASE_TICK_COUNT( xTicksToJump );
-	}
+	TCB_t *pxTCB;
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
+		configASSERT( uxPolicy <= taskOVERRUN_DEGRADE );
+		configASSERT( ( uxPolicy != taskOVERRUN_DEGRADE ) || ( pxFallbackCode != NULL ) );
 
-BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
-{
-BaseType_t xYieldRequired = pdFALSE;
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then the policy of the calling task
+			is set.  Normally called straight after the task is created. */
+			pxTCB = prvGetTCBFromHandle( xTask );
 
-	/* Must not be called with the scheduler suspended as the implementation
-	relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-	configASSERT( uxSchedulerSuspended == 0 );
+			#if ( configUSE_EDF_SPORADIC == 1 )
+			{
+				/* The other policies move the job on to the next periodic
+				release, which a sporadic task does not have. */
+				configASSERT( ( uxPolicy == taskOVERRUN_CONTINUE ) || ( pxTCB->uxSporadicState == taskSPORADIC_NONE ) );
+			}
+			#endif
 
-	/* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
-	the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
-	vTaskSuspendAll();
-	xPendedTicks += xTicksToCatchUp;
-	xYieldRequired = xTaskResumeAll();
+			pxTCB->uxOverrunPolicy = uxPolicy;
+			pxTCB->pxFallbackCode = pxFallbackCode;
+		}
+		taskEXIT_CRITICAL();
+	}
 
-	return xYieldRequired;
-}
-/*----------------------------------------------------------*/
+#endif /* configUSE_EDF_OVERRUN_POLICY */
+/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskAbortDelay == 1 )
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-	BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+	BaseType_t xTaskModeChange( TaskHandle_t const * const pxTasks, TickType_t const * const pxPeriods, TickType_t const * const pxDeadlines, UBaseType_t uxCount )
 	{
-	TCB_t *pxTCB = xTask;
 	BaseType_t xReturn;
 
-		configASSERT( pxTCB );
+		configASSERT( pxTasks != NULL );
+		configASSERT( pxPeriods != NULL );
 
+		/* Each task moves to its new timing at the next release it computes
+		in xTaskWaitForNextPeriod() or vTaskDelayUntil().  pxDeadlines can be
+		NULL, in which case every deadline equals the new period.  Either every
+		task changes or, if the set would not be schedulable during or after
+		the change, none do. */
 		vTaskSuspendAll();
 		{
-			/* A task can only be prematurely removed from the Blocked state if
-			it is actually in the Blocked state. */
-			if( eTaskGetState( xTask ) == eBlocked )
-			{
-				xReturn = pdPASS;
+			xReturn = prvChangeTaskTiming( pxTasks, pxPeriods, pxDeadlines, uxCount );
+		}
+		( void ) xTaskResumeAll();
 
-				/* Remove the reference to the task from the blocked list.  An
-				interrupt won't touch the xStateListItem because the
-				scheduler is suspended. */
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+		return xReturn;
+	}
 
-				/* Is the task waiting on an event also?  If so remove it from
-				the event list too.  Interrupts can touch the event list item,
-				even though the scheduler is suspended, so a critical section
-				is used. */
-				taskENTER_CRITICAL();
-				{
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-					{
-						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
 
-						/* This lets the task know it was forcibly removed from the
-						blocked state so it should not re-evaluate its block time and
-						then block again. */
-						pxTCB->ucDelayAborted = pdTRUE;
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-				}
-				taskEXIT_CRITICAL();
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-				/* Place the unblocked task into the appropriate ready list. */
-				prvAddTaskToReadyList( pxTCB );
+	BaseType_t xTaskSetPeriod( TaskHandle_t xTask, TickType_t xPeriod )
+	{
+	TCB_t *pxTCB;
+	TickType_t xDeadline;
+	BaseType_t xReturn;
 
-				/* A task being unblocked cannot cause an immediate context
-				switch if preemption is turned off. */
-				#if (  configUSE_PREEMPTION == 1 )
-				{
-					/* Preemption is on, but a context switch should only be
-					performed if the unblocked task has a priority that is
-					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-					{
-						/* Pend the yield to be performed when the scheduler
-						is unsuspended. */
-						xYieldPending = pdTRUE;
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-				}
-				#endif /* configUSE_PREEMPTION */
+		vTaskSuspendAll();
+		{
+			/* A deadline equal to the period moves with the period, a shorter
+			deadline is kept. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			if( pxTCB->xTaskRelativeDeadline == pxTCB->xTaskPeriod )
+			{
+				xDeadline = xPeriod;
 			}
 			else
 			{
-				xReturn = pdFAIL;
+				xDeadline = pxTCB->xTaskRelativeDeadline;
 			}
+
+			xReturn = prvChangeTaskTiming( &xTask, &xPeriod, &xDeadline, ( UBaseType_t ) 1U );
 		}
 		( void ) xTaskResumeAll();
 
 		return xReturn;
 	}
 
-#endif /* INCLUDE_xTaskAbortDelay */
-/*----------------------------------------------------------*/
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
 
-BaseType_t xTaskIncrementTick( void )
-{
-TCB_t * pxTCB;
-TickType_t xItemValue;
-BaseType_t xSwitchRequired = pdFALSE;
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-	/* Called by the portable layer each time a tick interrupt occurs.
-	Increments the tick then checks to see if the new tick value will cause any
-	tasks to be unblocked. */
-	traceTASK_INCREMENT_TICK( xTickCount );
-	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	BaseType_t xTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline )
 	{
-		/* Minor optimisation.  The tick count cannot change in this
-		block. */
-		const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+	TCB_t *pxTCB;
+	TickType_t xPeriod;
+	BaseType_t xReturn;
 
-		/* Increment the RTOS tick, switching the delayed and overflowed
-		delayed lists if it wraps to 0. */
-		xTickCount = xConstTickCount;
-		
-		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+		vTaskSuspendAll();
 		{
-			taskSWITCH_DELAYED_LISTS();
+			pxTCB = prvGetTCBFromHandle( xTask );
+			xPeriod = pxTCB->xTaskPeriod;
+
+			xReturn = prvChangeTaskTiming( &xTask, &xPeriod, &xRelativeDeadline, ( UBaseType_t ) 1U );
 		}
-		else
+		( void ) xTaskResumeAll();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_CBS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	BaseType_t xTaskCbsCreate(	const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+								const configSTACK_DEPTH_TYPE usStackDepth,
+								UBaseType_t uxPriority,
+								UBaseType_t uxQueueLength,
+								TickType_t xBudget,
+								TickType_t xServerPeriod,
+								TaskHandle_t * const pxCreatedTask )
+	{
+	CbsJob_t *pxJobs;
+	TaskHandle_t xServer = NULL;
+	BaseType_t xReturn;
+
+		/* A server with no budget could never run a job. */
+		if( ( uxQueueLength == ( UBaseType_t ) 0U ) || ( xBudget == ( TickType_t ) 0U ) )
 		{
-			mtCOVERAGE_TEST_MARKER();
+			xReturn = pdFAIL;
 		}
-
-		/* See if this tick has made a timeout expire.  Tasks are stored in
-		the	queue in the order of their wake time - meaning once one task
-		has been found whose block time has not expired there is no need to
-		look any further down the list. */
-		if( xConstTickCount >= xNextTaskUnblockTime )
+		else
 		{
-			for( ;; )
+			pxJobs = ( CbsJob_t * ) pvPortMalloc( ( size_t ) uxQueueLength * sizeof( CbsJob_t ) );
+
+			if( pxJobs != NULL )
 			{
-				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-				{
-					/* The delayed list is empty.  Set xNextTaskUnblockTime
-					to the maximum possible value so it is extremely
-					unlikely that the
-					if( xTickCount >= xNextTaskUnblockTime ) test will pass
-					next time through. */
-					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					break;
-				}
-				else
+				/* The scheduler is suspended so the server cannot run before
+				it has its job queue. */
+				vTaskSuspendAll();
 				{
-					/* The delayed list is not empty, get the value of the
-					item at the head of the delayed list.  This is the time
-					at which the task at the head of the delayed list must
-					be removed from the Blocked state. */
-					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-					xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+					xReturn = xTaskPeriodicCreateWithDeadline( prvCbsServerTask, pcName, usStackDepth, NULL, uxPriority, &xServer, xServerPeriod, xServerPeriod, xBudget );
 
-					if( xConstTickCount < xItemValue )
+					if( xReturn == pdPASS )
 					{
-						/* It is not time to unblock this item yet, but the
-						item value is the time at which the task at the head
-						of the blocked list must be removed from the Blocked
-						state -	so record the item value in
-						xNextTaskUnblockTime. */
-						xNextTaskUnblockTime = xItemValue;
-						break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
+						prvInitialiseCbsServer( xServer, pxJobs, uxQueueLength );
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
+				}
+				( void ) xTaskResumeAll();
 
-					/* It is time to remove the item from the Blocked state. */
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-
-					/* Is the task waiting on an event also?  If so remove
-					it from the event list. */
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+				if( xReturn == pdPASS )
+				{
+					if( pxCreatedTask != NULL )
 					{
-						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						*pxCreatedTask = xServer;
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
-
-					/* Place the unblocked task into the appropriate ready
-					list. */
-					
-					/* edit here */
-					/* In every tick increment, calculate the new task deadline and insert it in the correct position in the EDF ready list
-							turn on the flag xSwitchRequired to force the system to check which task got the (highest priority/lowest deadline) */
-					#if (configUSE_EDF_SCHEDULER == 1)
-					{
-						listSET_LIST_ITEM_VALUE( & ((pxTCB)->xStateListItem), (pxTCB)->xTaskPeriod + xTaskGetTickCount() );
-						xSwitchRequired = pdTRUE;
-					}
-					#endif /* configUSE_EDF_SCHEDULER */
-					prvAddTaskToReadyList( pxTCB );
-					/* A task being unblocked cannot cause an immediate
-					context switch if preemption is turned off. */
-
-					#if (  configUSE_PREEMPTION == 1 )
-					{
-						/* Preemption is on, but a context switch should
-						only be performed if the unblocked task has a
-						priority that is equal to or higher than the
-						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-						{
-							xSwitchRequired = pdTRUE;
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-					}
-					#endif /* configUSE_PREEMPTION */
 				}
-			}
-		}
-
-		/* Tasks of equal priority to the currently running task will share
-		processing time (time slice) if preemption is on, and the application
-		writer has not explicitly turned time slicing off. */
-		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
-		{
-			/*edit 
-			it will not enter here because it's not bossible to have 
-			the same periority with other tasks in EDF */
-			#if (configUSE_EDF_SCHEDULER == 0)
-			{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
-			{
-				xSwitchRequired = pdTRUE;
+				else
+				{
+					vPortFree( pxJobs );
+				}
 			}
 			else
-			#endif /* configUSE_EDF_SCHEDULER == 0 */
 			{
-				mtCOVERAGE_TEST_MARKER();
+				xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
 			}
 		}
-		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
-		#if ( configUSE_TICK_HOOK == 1 )
+		return xReturn;
+	}
+
+#endif /* ( configUSE_EDF_CBS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_CBS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	BaseType_t xTaskCbsCreateStatic(	const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+										const uint32_t ulStackDepth,
+										UBaseType_t uxPriority,
+										UBaseType_t uxQueueLength,
+										TickType_t xBudget,
+										TickType_t xServerPeriod,
+										StackType_t * const puxStackBuffer,
+										StaticTask_t * const pxTaskBuffer,
+										StaticCbsJob_t * const pxJobBuffer,
+										TaskHandle_t * const pxCreatedTask )
+	{
+	TaskHandle_t xServer = NULL;
+	BaseType_t xReturn;
+
+		configASSERT( pxJobBuffer != NULL );
+
+		#if( configASSERT_DEFINED == 1 )
 		{
-			/* Guard against the tick hook being called when the pended tick
-			count is being unwound (when the scheduler is being unlocked). */
-			if( xPendedTicks == ( TickType_t ) 0 )
-			{
-				vApplicationTickHook();
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+			/* Sanity check that the size of the structure used to declare the
+			job buffer equals the size of the real job structure. */
+			volatile size_t xSize = sizeof( StaticCbsJob_t );
+			configASSERT( xSize == sizeof( CbsJob_t ) );
+			( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
 		}
-		#endif /* configUSE_TICK_HOOK */
+		#endif /* configASSERT_DEFINED */
 
-		#if ( configUSE_PREEMPTION == 1 )
+		if( ( pxJobBuffer == NULL ) || ( uxQueueLength == ( UBaseType_t ) 0U ) || ( xBudget == ( TickType_t ) 0U ) )
 		{
-			if( xYieldPending != pdFALSE )
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			vTaskSuspendAll();
 			{
-				xSwitchRequired = pdTRUE;
+				xReturn = xTaskPeriodicCreateStatic( prvCbsServerTask, pcName, ulStackDepth, NULL, uxPriority, puxStackBuffer, pxTaskBuffer, &xServer, xServerPeriod, xServerPeriod, xBudget );
+
+				if( xReturn == pdPASS )
+				{
+					prvInitialiseCbsServer( xServer, ( CbsJob_t * ) pxJobBuffer, uxQueueLength ); /*lint !e740 !e9087 Unusual cast is ok as the structures have the same alignment, and the size is checked by an assert. */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			( void ) xTaskResumeAll();
+
+			if( ( xReturn == pdPASS ) && ( pxCreatedTask != NULL ) )
+			{
+				*pxCreatedTask = xServer;
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		#endif /* configUSE_PREEMPTION */
-	}
-	else
-	{
-		++xPendedTicks;
 
-		/* The tick hook gets called at regular intervals, even if the
-		scheduler is locked. */
-		#if ( configUSE_TICK_HOOK == 1 )
-		{
-			vApplicationTickHook();
-		}
-		#endif
+		return xReturn;
 	}
 
-	return xSwitchRequired;
-}
+#endif /* ( configUSE_EDF_CBS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configUSE_EDF_CBS == 1 )
 
-	void vTaskSetApplicationTaskTag( TaskHandle_t xTask, TaskHookFunction_t pxHookFunction )
+	BaseType_t xTaskCbsSubmit( TaskHandle_t xServer, TaskFunction_t pxJobCode, void *pvParameters )
 	{
-	TCB_t *xTCB;
+	TCB_t * const pxTCB = xServer;
+	BaseType_t xReturn;
 
-		/* If xTask is NULL then it is the task hook of the calling task that is
-		getting set. */
-		if( xTask == NULL )
-		{
-			xTCB = ( TCB_t * ) pxCurrentTCB;
-		}
-		else
-		{
-			xTCB = xTask;
-		}
+		configASSERT( pxTCB );
+		configASSERT( pxJobCode );
 
-		/* Save the hook function in the TCB.  A critical section is required as
-		the value can be accessed from an interrupt. */
 		taskENTER_CRITICAL();
 		{
-			xTCB->pxTaskTag = pxHookFunction;
+			xReturn = prvCbsQueueJob( pxTCB, pxJobCode, pvParameters );
 		}
 		taskEXIT_CRITICAL();
-	}
-
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
-
-	TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
-	{
-	TCB_t *pxTCB;
-	TaskHookFunction_t xReturn;
-
-		/* If xTask is NULL then set the calling task's hook. */
-		pxTCB = prvGetTCBFromHandle( xTask );
 
-		/* Save the hook function in the TCB.  A critical section is required as
-		the value can be accessed from an interrupt. */
-		taskENTER_CRITICAL();
+		if( xReturn == pdPASS )
 		{
-			xReturn = pxTCB->pxTaskTag;
+			/* Wakes the server if it is waiting for a job.  It then preempts
+			the calling task if its deadline is earlier. */
+			( void ) xTaskGenericNotify( xServer, 0UL, eIncrement, NULL );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
 		}
-		taskEXIT_CRITICAL();
 
 		return xReturn;
 	}
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* configUSE_EDF_CBS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configUSE_EDF_CBS == 1 )
 
-	TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+	BaseType_t xTaskCbsSubmitFromISR( TaskHandle_t xServer, TaskFunction_t pxJobCode, void *pvParameters, BaseType_t *pxHigherPriorityTaskWoken )
 	{
-	TCB_t *pxTCB;
-	TaskHookFunction_t xReturn;
+	TCB_t * const pxTCB = xServer;
+	BaseType_t xReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
-		/* If xTask is NULL then set the calling task's hook. */
-		pxTCB = prvGetTCBFromHandle( xTask );
+		configASSERT( pxTCB );
+		configASSERT( pxJobCode );
+
+		/* See the comments in xTaskGenericNotifyFromISR() about interrupt
+		priorities. */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		/* Save the hook function in the TCB.  A critical section is required as
-		the value can be accessed from an interrupt. */
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			xReturn = pxTCB->pxTaskTag;
+			xReturn = prvCbsQueueJob( pxTCB, pxJobCode, pvParameters );
 		}
 		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
+		if( xReturn == pdPASS )
+		{
+			/* *pxHigherPriorityTaskWoken is set if the server was woken with
+			an earlier deadline than the interrupted task. */
+			vTaskNotifyGiveFromISR( xServer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
 		return xReturn;
 	}
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* configUSE_EDF_CBS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( ( configUSE_EDF_SPORADIC == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-	BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParameter )
+	BaseType_t xTaskSporadicCreate(	TaskFunction_t pxTaskCode,
+									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const configSTACK_DEPTH_TYPE usStackDepth,
+									void * const pvParameters,
+									UBaseType_t uxPriority,
+									TaskHandle_t * const pxCreatedTask,
+									TickType_t xMinInterArrival,
+									TickType_t xRelativeDeadline,
+									TickType_t xWCET )
 	{
-	TCB_t *xTCB;
+	TaskHandle_t xTask = NULL;
 	BaseType_t xReturn;
 
-		/* If xTask is NULL then we are calling our own task hook. */
-		if( xTask == NULL )
-		{
-			xTCB = pxCurrentTCB;
-		}
-		else
+		/* Jobs released at the minimum inter-arrival time are the worst case
+		for the rest of the set, so the task is admitted as a periodic task with
+		that period.  The scheduler is suspended so the task cannot run before
+		it is sporadic.  Its first job is released now, as for a periodic
+		task. */
+		vTaskSuspendAll();
 		{
-			xTCB = xTask;
-		}
+			xReturn = xTaskPeriodicCreateWithDeadline( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, &xTask, xMinInterArrival, xRelativeDeadline, xWCET );
 
-		if( xTCB->pxTaskTag != NULL )
-		{
-			xReturn = xTCB->pxTaskTag( pvParameter );
+			if( xReturn == pdPASS )
+			{
+				xTask->uxSporadicState = taskSPORADIC_RUNNING;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		if( ( xReturn == pdPASS ) && ( pxCreatedTask != NULL ) )
+		{
+			*pxCreatedTask = xTask;
 		}
 		else
 		{
-			xReturn = pdFAIL;
+			mtCOVERAGE_TEST_MARKER();
 		}
 
 		return xReturn;
 	}
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* ( configUSE_EDF_SPORADIC == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
-{
-	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+#if ( ( configUSE_EDF_SPORADIC == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	BaseType_t xTaskSporadicCreateStatic(	TaskFunction_t pxTaskCode,
+											const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const uint32_t ulStackDepth,
+											void * const pvParameters,
+											UBaseType_t uxPriority,
+											StackType_t * const puxStackBuffer,
+											StaticTask_t * const pxTaskBuffer,
+											TaskHandle_t * const pxCreatedTask,
+											TickType_t xMinInterArrival,
+											TickType_t xRelativeDeadline,
+											TickType_t xWCET )
 	{
-		/* The scheduler is currently suspended - do not allow a context
-		switch. */
-		xYieldPending = pdTRUE;
-	}
-	else
-	{
-		xYieldPending = pdFALSE;
-		traceTASK_SWITCHED_OUT();
+	TaskHandle_t xTask = NULL;
+	BaseType_t xReturn;
 
-		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		/* As xTaskSporadicCreate(). */
+		vTaskSuspendAll();
 		{
-			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-			#else
-				ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-			#endif
+			xReturn = xTaskPeriodicCreateStatic( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, &xTask, xMinInterArrival, xRelativeDeadline, xWCET );
 
-			/* Add the amount of time the task has been running to the
-			accumulated time so far.  The time the task started running was
-			stored in ulTaskSwitchedInTime.  Note that there is no overflow
-			protection here so count values are only valid until the timer
-			overflows.  The guard against negative values is to protect
-			against suspect run time stat counter implementations - which
-			are provided by the application, not the kernel. */
-			if( ulTotalRunTime > ulTaskSwitchedInTime )
+			if( xReturn == pdPASS )
 			{
-				pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+				xTask->uxSporadicState = taskSPORADIC_RUNNING;
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
-			ulTaskSwitchedInTime = ulTotalRunTime;
-		}
-		#endif /* configGENERATE_RUN_TIME_STATS */
-
-		/* Check for stack overflow, if configured. */
-		taskCHECK_FOR_STACK_OVERFLOW();
-
-		/* Before the currently running task is switched out, save its errno. */
-		#if( configUSE_POSIX_ERRNO == 1 )
-		{
-			pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
 		}
-		#endif
+		( void ) xTaskResumeAll();
 
-		/* Select a new task to run using either the generic C or port
-		optimised asm code. */
-		#if (configUSE_EDF_SCHEDULER == 0)
-		{
-			taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		}
-		#else
-		/* edit */
-		/* Get the highest priority of the new EDF list */
+		if( ( xReturn == pdPASS ) && ( pxCreatedTask != NULL ) )
 		{
-			pxCurrentTCB = (TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &(xReadyTasksListEDF ) );
+			*pxCreatedTask = xTask;
 		}
-		#endif
-		traceTASK_SWITCHED_IN();
-
-		/* After the new task is switched in, update the global errno. */
-		#if( configUSE_POSIX_ERRNO == 1 )
+		else
 		{
-			FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif
 
-		#if ( configUSE_NEWLIB_REENTRANT == 1 )
-		{
-			/* Switch Newlib's _impure_ptr variable to point to the _reent
-			structure specific to this task.
-			See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-			for additional information. */
-			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
-		}
-		#endif /* configUSE_NEWLIB_REENTRANT */
+		return xReturn;
 	}
-}
-/*-----------------------------------------------------------*/
-
-void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
-{
-	configASSERT( pxEventList );
 
-	/* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-	SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+#endif /* ( configUSE_EDF_SPORADIC == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
 
-	/* Place the event list item of the TCB in the appropriate event list.
-	This is placed in the list in priority order so the highest priority task
-	is the first to be woken by the event.  The queue that contains the event
-	list is locked, preventing simultaneous access from interrupts. */
-	vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+#if ( configUSE_EDF_SPORADIC == 1 )
 
-	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
-/*-----------------------------------------------------------*/
+	BaseType_t xTaskSporadicRelease( TaskHandle_t xTask )
+	{
+	TCB_t * const pxTCB = xTask;
+	BaseType_t xReturn, xYieldRequired;
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait )
-{
-	configASSERT( pxEventList );
+		configASSERT( pxTCB );
 
-	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-	the event groups implementation. */
-	configASSERT( uxSchedulerSuspended != 0 );
+		taskENTER_CRITICAL();
+		{
+			xReturn = prvSporadicRelease( pxTCB, &xYieldRequired );
 
-	/* Store the item value in the event list item.  It is safe to access the
-	event list item here as interrupts won't access the event list item of a
-	task that is not in the Blocked state. */
-	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+			if( xYieldRequired != pdFALSE )
+			{
+				/* The released job has an earlier deadline than the calling
+				task. */
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
 
-	/* Place the event list item of the TCB at the end of the appropriate event
-	list.  It is safe to access the event list here because it is part of an
-	event group implementation - and interrupts don't access event groups
-	directly (instead they access them indirectly by pending function calls to
-	the task level). */
-	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+		return xReturn;
+	}
 
-	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
+#endif /* configUSE_EDF_SPORADIC */
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TIMERS == 1 )
+#if ( configUSE_EDF_SPORADIC == 1 )
 
-	void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely )
+	BaseType_t xTaskSporadicReleaseFromISR( TaskHandle_t xTask, BaseType_t *pxHigherPriorityTaskWoken )
 	{
-		configASSERT( pxEventList );
-
-		/* This function should not be called by application code hence the
-		'Restricted' in its name.  It is not part of the public API.  It is
-		designed for use by kernel code, and has special calling requirements -
-		it should be called with the scheduler suspended. */
+	TCB_t * const pxTCB = xTask;
+	BaseType_t xReturn, xYieldRequired;
+	UBaseType_t uxSavedInterruptStatus;
 
+		configASSERT( pxTCB );
 
-		/* Place the event list item of the TCB in the appropriate event list.
-		In this case it is assume that this is the only task that is going to
-		be waiting on this event list, so the faster vListInsertEnd() function
-		can be used in place of vListInsert. */
-		vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+		/* See the comments in xTaskGenericNotifyFromISR() about interrupt
+		priorities. */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		/* If the task should block indefinitely then set the block time to a
-		value that will be recognised as an indefinite delay inside the
-		prvAddCurrentTaskToDelayedList() function. */
-		if( xWaitIndefinitely != pdFALSE )
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			xTicksToWait = portMAX_DELAY;
+			xReturn = prvSporadicRelease( pxTCB, &xYieldRequired );
+
+			if( xYieldRequired != pdFALSE )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+
+				/* Mark that a yield is pending in case the user is not using
+				the "xHigherPriorityTaskWoken" parameter, as when called from
+				the tick hook. */
+				xYieldPending = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-		traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
-		prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+		return xReturn;
 	}
 
-#endif /* configUSE_TIMERS */
+#endif /* configUSE_EDF_SPORADIC */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
-{
-TCB_t *pxUnblockedTCB;
-BaseType_t xReturn;
+#if ( configUSE_EDF_SPORADIC == 1 )
 
-	/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
-	called from a critical section within an ISR. */
+	void vTaskGetSporadicReleaseInfo( TaskHandle_t xTask, UBaseType_t * const puxEarlyReleases, UBaseType_t * const puxDroppedReleases )
+	{
+	TCB_t *pxTCB;
 
-	/* The event list is sorted in priority order, so the first in the list can
-	be removed as it is known to be the highest priority.  Remove the TCB from
-	the delayed list, and add it to the ready list.
+		/* If null is passed in here then the calling task's counters are
+		returned.  Either output pointer can be NULL if that value is not
+		required. */
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
 
-	If an event is for a queue that is locked then this function will never
-	get called - the lock count on the queue will get modified instead.  This
-	means exclusive access to the event list is guaranteed here.
+			if( puxEarlyReleases != NULL )
+			{
+				*puxEarlyReleases = pxTCB->uxEarlyReleases;
+			}
 
-	This function assumes that a check has already been made to ensure that
-	pxEventList is not empty. */
-	pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-	configASSERT( pxUnblockedTCB );
-	( void ) uxListRemove( &( pxUnblockedTCB->xEventListItem ) );
+			if( puxDroppedReleases != NULL )
+			{
+				*puxDroppedReleases = pxTCB->uxDroppedReleases;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
 
-	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+#endif /* configUSE_EDF_SPORADIC */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_JOBS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	BaseType_t xTaskJobServerCreate(	const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+										const configSTACK_DEPTH_TYPE usStackDepth,
+										UBaseType_t uxPriority,
+										TickType_t xRelativeDeadline,
+										TaskHandle_t * const pxCreatedTask )
 	{
-		( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
-		prvAddTaskToReadyList( pxUnblockedTCB );
+	JobServer_t *pxServer;
+	TaskHandle_t xServer = NULL;
+	BaseType_t xReturn;
 
-		#if( configUSE_TICKLESS_IDLE != 0 )
+		/* Every job of a preemption level runs on the one server stack. */
+		if( ( uxJobServers >= ( UBaseType_t ) configEDF_JOB_SERVERS ) || ( prvFindJobServer( xRelativeDeadline ) != NULL ) )
 		{
-			/* If a task is blocked on a kernel object then xNextTaskUnblockTime
-			might be set to the blocked task's time out time.  If the task is
-			unblocked for a reason other than a timeout xNextTaskUnblockTime is
-			normally left unchanged, because it is automatically reset to a new
-			value when the tick count equals xNextTaskUnblockTime.  However if
-			tickless idling is used it might be more important to enter sleep mode
-			at the earliest possible time - so reset xNextTaskUnblockTime here to
-			ensure it is updated at the earliest possible time. */
-			prvResetNextTaskUnblockTime();
+			xReturn = pdFAIL;
 		}
-		#endif
-	}
-	else
-	{
-		/* The delayed and ready lists cannot be accessed, so hold this task
-		pending until the scheduler is resumed. */
-		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
-	}
+		else
+		{
+			/* The server has no WCET of its own, each job is admitted when it
+			is created.  Its first run is due straight away, and finds no job
+			released yet.  The scheduler is suspended until the server has
+			been added, so it cannot run before. */
+			pxServer = &( xJobServers[ uxJobServers ] );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
-	{
-		/* Return true if the task removed from the event list has a higher
-		priority than the calling task.  This allows the calling task to know if
-		it should force a context switch now. */
-		xReturn = pdTRUE;
+			vTaskSuspendAll();
+			{
+				xReturn = xTaskPeriodicCreateWithDeadline( prvJobServerTask, pcName, usStackDepth, ( void * ) pxServer, uxPriority, &xServer, ( TickType_t ) 1U, ( TickType_t ) 1U, ( TickType_t ) 0U );
 
-		/* Mark that a yield is pending in case the user is not using the
-		"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-		xYieldPending = pdTRUE;
-	}
-	else
-	{
-		xReturn = pdFALSE;
+				if( xReturn == pdPASS )
+				{
+					pxServer->pxTCB = xServer;
+					pxServer->xRelativeDeadline = xRelativeDeadline;
+					uxJobServers++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			( void ) xTaskResumeAll();
+
+			if( ( xReturn == pdPASS ) && ( pxCreatedTask != NULL ) )
+			{
+				*pxCreatedTask = xServer;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xReturn;
 	}
 
-	return xReturn;
-}
+#endif /* ( configUSE_EDF_JOBS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue )
-{
-TCB_t *pxUnblockedTCB;
+#if ( ( configUSE_EDF_JOBS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
-	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-	the event flags implementation. */
-	configASSERT( uxSchedulerSuspended != pdFALSE );
+	BaseType_t xTaskJobServerCreateStatic(	const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const uint32_t ulStackDepth,
+											UBaseType_t uxPriority,
+											TickType_t xRelativeDeadline,
+											StackType_t * const puxStackBuffer,
+											StaticTask_t * const pxTaskBuffer,
+											TaskHandle_t * const pxCreatedTask )
+	{
+	JobServer_t *pxServer;
+	TaskHandle_t xServer = NULL;
+	BaseType_t xReturn;
 
-	/* Store the new item value in the event list. */
-	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+		if( ( uxJobServers >= ( UBaseType_t ) configEDF_JOB_SERVERS ) || ( prvFindJobServer( xRelativeDeadline ) != NULL ) )
+		{
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			pxServer = &( xJobServers[ uxJobServers ] );
 
-	/* Remove the event list form the event flag.  Interrupts do not access
-	event flags. */
-	pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-	configASSERT( pxUnblockedTCB );
-	( void ) uxListRemove( pxEventListItem );
+			vTaskSuspendAll();
+			{
+				xReturn = xTaskPeriodicCreateStatic( prvJobServerTask, pcName, ulStackDepth, ( void * ) pxServer, uxPriority, puxStackBuffer, pxTaskBuffer, &xServer, ( TickType_t ) 1U, ( TickType_t ) 1U, ( TickType_t ) 0U );
 
-	#if( configUSE_TICKLESS_IDLE != 0 )
+				if( xReturn == pdPASS )
+				{
+					pxServer->pxTCB = xServer;
+					pxServer->xRelativeDeadline = xRelativeDeadline;
+					uxJobServers++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			( void ) xTaskResumeAll();
+
+			if( ( xReturn == pdPASS ) && ( pxCreatedTask != NULL ) )
+			{
+				*pxCreatedTask = xServer;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( configUSE_EDF_JOBS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_JOBS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	BaseType_t xTaskJobCreate(	TaskFunction_t pxJobCode,
+								void * const pvParameters,
+								TickType_t xPeriod,
+								TickType_t xRelativeDeadline,
+								TickType_t xWCET )
 	{
-		/* If a task is blocked on a kernel object then xNextTaskUnblockTime
-		might be set to the blocked task's time out time.  If the task is
-		unblocked for a reason other than a timeout xNextTaskUnblockTime is
-		normally left unchanged, because it is automatically reset to a new
-		value when the tick count equals xNextTaskUnblockTime.  However if
-		tickless idling is used it might be more important to enter sleep mode
-		at the earliest possible time - so reset xNextTaskUnblockTime here to
-		ensure it is updated at the earliest possible time. */
-		prvResetNextTaskUnblockTime();
+	Job_t *pxNewJob;
+	BaseType_t xReturn;
+
+		pxNewJob = ( Job_t * ) pvPortMalloc( sizeof( Job_t ) );
+
+		if( pxNewJob != NULL )
+		{
+			xReturn = prvInitialiseJob( pxNewJob, pxJobCode, pvParameters, xPeriod, xRelativeDeadline, xWCET );
+
+			if( xReturn != pdPASS )
+			{
+				vPortFree( pxNewJob );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+		}
+
+		return xReturn;
 	}
-	#endif
 
-	/* Remove the task from the delayed list and add it to the ready list.  The
-	scheduler is suspended so interrupts will not be accessing the ready
-	lists. */
-	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
-	prvAddTaskToReadyList( pxUnblockedTCB );
+#endif /* ( configUSE_EDF_JOBS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+#if ( ( configUSE_EDF_JOBS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	BaseType_t xTaskJobCreateStatic(	TaskFunction_t pxJobCode,
+										void * const pvParameters,
+										TickType_t xPeriod,
+										TickType_t xRelativeDeadline,
+										TickType_t xWCET,
+										StaticJob_t * const pxJobBuffer )
 	{
-		/* The unblocked task has a priority above that of the calling task, so
-		a context switch is required.  This function is called with the
-		scheduler suspended so xYieldPending is set so the context switch
-		occurs immediately that the scheduler is resumed (unsuspended). */
-		xYieldPending = pdTRUE;
+	BaseType_t xReturn;
+
+		configASSERT( pxJobBuffer != NULL );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare the
+			job buffer equals the size of the real job structure. */
+			volatile size_t xSize = sizeof( StaticJob_t );
+			configASSERT( xSize == sizeof( Job_t ) );
+			( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+		}
+		#endif /* configASSERT_DEFINED */
+
+		if( pxJobBuffer != NULL )
+		{
+			xReturn = prvInitialiseJob( ( Job_t * ) pxJobBuffer, pxJobCode, pvParameters, xPeriod, xRelativeDeadline, xWCET ); /*lint !e740 !e9087 Unusual cast is ok as the structures have the same alignment, and the size is checked by an assert. */
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
 	}
-}
+
+#endif /* ( configUSE_EDF_JOBS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
-void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-	configASSERT( pxTimeOut );
-	taskENTER_CRITICAL();
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	uint32_t ulTaskGetTotalUtilisation( void )
 	{
-		pxTimeOut->xOverflowCount = xNumOfOverflows;
-		pxTimeOut->xTimeOnEntering = xTickCount;
+		/* A 32-bit read, so no critical section is needed on the 32-bit
+		architectures this scheduler targets.  The value is in units of
+		1 / 65536, so 65536 is a utilisation of 1.0. */
+		return ulTotalUtilisation;
 	}
-	taskEXIT_CRITICAL();
-}
+
+#endif /* configUSE_EDF_SCHEDULER */
 /*-----------------------------------------------------------*/
 
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	{
+	UBaseType_t uxTask = 0;
+	#if (configUSE_EDF_SCHEDULER == 0)
+	uxQueue = configMAX_PRIORITIES;
+	#endif
+	#if ( configUSE_TIMING_WHEEL == 1 )
+		UBaseType_t uxList;
+	#endif
+
+		vTaskSuspendAll();
+		{
+			/* Is there a space in the array for each task in the system? */
+			if( uxArraySize >= uxCurrentNumberOfTasks )
+			{
+				/* Fill in an TaskStatus_t structure with information on each
+				task in the Ready state. */
+				#if (configUSE_EDF_SCHEDULER == 0)
+				do
+				{
+					uxQueue--;
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
+
+				} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				#else
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xReadyTasksListEDF ), eReady );
+
+					/* The idle task is ready but not in the EDF ready list. */
+					if( xIdleTaskHandle != NULL )
+					{
+						vTaskGetInfo( xIdleTaskHandle, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eReady );
+						uxTask++;
+					}
+				#endif
+				/* Fill in an TaskStatus_t structure with information on each
+				task in the Blocked state. */
+				#if ( configUSE_TIMING_WHEEL == 1 )
+				{
+					for( uxList = ( UBaseType_t ) 0U; uxList < taskWHEEL_LISTS; uxList++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xTimingWheel[ uxList ] ), eBlocked );
+					}
+				}
+				#else
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#endif /* configUSE_TIMING_WHEEL */
+
+				#if( INCLUDE_vTaskDelete == 1 )
+				{
+					/* Fill in an TaskStatus_t structure with information on
+					each task that has been deleted but not yet cleaned up. */
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
+				}
+				#endif
+
+				#if ( INCLUDE_vTaskSuspend == 1 )
+				{
+					/* Fill in an TaskStatus_t structure with information on
+					each task in the Suspended state. */
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
+				}
+				#endif
+
+				#if ( configGENERATE_RUN_TIME_STATS == 1)
+				{
+					if( pulTotalRunTime != NULL )
+					{
+						#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+							portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+						#else
+							*pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+						#endif
+					}
+				}
+				#else
+				{
+					if( pulTotalRunTime != NULL )
+					{
+						*pulTotalRunTime = 0;
+					}
+				}
+				#endif
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxTask;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+	TaskHandle_t xTaskGetIdleTaskHandle( void )
+	{
+		/* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+		started, then xIdleTaskHandle will be NULL. */
+		configASSERT( ( xIdleTaskHandle != NULL ) );
+		return xIdleTaskHandle;
+	}
+
+#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+/*----------------------------------------------------------*/
+
+/* This conditional compilation should use inequality to 0, not equality to 1.
+This is to ensure vTaskStepTick() is available when user defined low power mode
+implementations require configUSE_TICKLESS_IDLE to be set to a value other than
+1. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	void vTaskStepTick( const TickType_t xTicksToJump )
+	{
+		/* Correct the tick count value after a period during which the tick
+		was suppressed.  Note this does *not* call the tick hook function for
+		each stepped tick. */
+		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		xTickCount += xTicksToJump;
+		traceINCREASE_TICK_COUNT( xTicksToJump );
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 {
-	/* For internal use only as it does not use a critical section. */
-	pxTimeOut->xOverflowCount = xNumOfOverflows;
-	pxTimeOut->xTimeOnEntering = xTickCount;
+BaseType_t xYieldRequired = pdFALSE;
+
+	/* Must not be called with the scheduler suspended as the implementation
+	relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
+	configASSERT( uxSchedulerSuspended == 0 );
+
+	/* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
+	the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
+	vTaskSuspendAll();
+	xPendedTicks += xTicksToCatchUp;
+	xYieldRequired = xTaskResumeAll();
+
+	return xYieldRequired;
 }
-/*-----------------------------------------------------------*/
+/*----------------------------------------------------------*/
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const pxTicksToWait )
-{
-BaseType_t xReturn;
+#if ( INCLUDE_xTaskAbortDelay == 1 )
 
-	configASSERT( pxTimeOut );
-	configASSERT( pxTicksToWait );
+	BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB = xTask;
+	BaseType_t xReturn;
+
+		configASSERT( pxTCB );
+
+		vTaskSuspendAll();
+		{
+			/* A task can only be prematurely removed from the Blocked state if
+			it is actually in the Blocked state. */
+			if( eTaskGetState( xTask ) == eBlocked )
+			{
+				xReturn = pdPASS;
+
+				/* Remove the reference to the task from the blocked list.  An
+				interrupt won't touch the xStateListItem because the
+				scheduler is suspended. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+				/* Is the task waiting on an event also?  If so remove it from
+				the event list too.  Interrupts can touch the event list item,
+				even though the scheduler is suspended, so a critical section
+				is used. */
+				taskENTER_CRITICAL();
+				{
+					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+						/* This lets the task know it was forcibly removed from the
+						blocked state so it should not re-evaluate its block time and
+						then block again. */
+						pxTCB->ucDelayAborted = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				/* Place the unblocked task into the appropriate ready list. */
+				prvAddTaskToReadyList( pxTCB );
+
+				/* A task being unblocked cannot cause an immediate context
+				switch if preemption is turned off. */
+				#if (  configUSE_PREEMPTION == 1 )
+				{
+					/* Preemption is on, but a context switch should only be
+					performed if the unblocked task has a priority that is
+					equal to or higher than the currently executing task. */
+					if( taskUNBLOCKED_TASK_PREEMPTS( pxTCB ) != pdFALSE )
+					{
+						/* Pend the yield to be performed when the scheduler
+						is unsuspended. */
+						xYieldPending = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_PREEMPTION */
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_xTaskAbortDelay */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskIncrementTick( void )
+{
+TCB_t * pxTCB;
+#if ( configUSE_TIMING_WHEEL == 0 )
+	TickType_t xItemValue;
+#endif
+BaseType_t xSwitchRequired = pdFALSE;
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	BaseType_t xJobReleased = pdFALSE;
+#endif
+
+	/* Called by the portable layer each time a tick interrupt occurs.
+	Increments the tick then checks to see if the new tick value will cause any
+	tasks to be unblocked. */
+	traceTASK_INCREMENT_TICK( xTickCount );
+	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	{
+		/* Minor optimisation.  The tick count cannot change in this
+		block. */
+		const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+
+		/* Increment the RTOS tick, switching the delayed and overflowed
+		delayed lists if it wraps to 0. */
+		xTickCount = xConstTickCount;
+		
+		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+		{
+			taskSWITCH_DELAYED_LISTS();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if ( configUSE_EDF_JOBS == 1 )
+		{
+		UBaseType_t uxServer;
+		JobServer_t *pxServer;
+
+			/* Jobs have no task of their own to put in the delayed lists, so
+			they are released here.  This is done first so a job server that
+			waits for this release gets the deadline of the job, rather than
+			being woken by its timeout with the deadline it blocked with. */
+			for( uxServer = ( UBaseType_t ) 0U; uxServer < uxJobServers; uxServer++ )
+			{
+				pxServer = &( xJobServers[ uxServer ] );
+
+				if( ( listLIST_IS_EMPTY( &( pxServer->xPendingJobsList ) ) == pdFALSE ) &&
+					( taskEDF_TIME_BEFORE( xConstTickCount, pxServer->xNextRelease ) == pdFALSE ) )
+				{
+					if( prvReleaseJobs( pxServer, xConstTickCount ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		#endif /* configUSE_EDF_JOBS */
+
+		/* See if this tick has made a timeout expire.  Tasks are stored in
+		the	queue in the order of their wake time - meaning once one task
+		has been found whose block time has not expired there is no need to
+		look any further down the list. */
+		if( xConstTickCount >= xNextTaskUnblockTime )
+		{
+			#if ( configUSE_TIMING_WHEEL == 1 )
+				/* Every task in the level 0 list of this tick wakes now, once
+				the levels above have been moved down onto it. */
+				List_t * const pxWakeList = prvTimingWheelAdvance( xConstTickCount );
+			#else
+				List_t * const pxWakeList = pxDelayedTaskList;
+			#endif
+
+			for( ;; )
+			{
+				if( listLIST_IS_EMPTY( pxWakeList ) != pdFALSE )
+				{
+					#if ( configUSE_TIMING_WHEEL == 1 )
+					{
+						/* All the tasks that wake on this tick are ready.
+						Find the next tick the wheel has work on. */
+						prvResetNextTaskUnblockTime();
+					}
+					#else
+					{
+						/* The delayed list is empty.  Set xNextTaskUnblockTime
+						to the maximum possible value so it is extremely
+						unlikely that the
+						if( xTickCount >= xNextTaskUnblockTime ) test will pass
+						next time through. */
+						xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					}
+					#endif /* configUSE_TIMING_WHEEL */
+					break;
+				}
+				else
+				{
+					/* The delayed list is not empty, get the value of the
+					item at the head of the delayed list.  This is the time
+					at which the task at the head of the delayed list must
+					be removed from the Blocked state. */
+					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxWakeList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+					#if ( configUSE_TIMING_WHEEL == 0 )
+					{
+						xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+						if( xConstTickCount < xItemValue )
+						{
+							/* It is not time to unblock this item yet, but the
+							item value is the time at which the task at the head
+							of the blocked list must be removed from the Blocked
+							state -	so record the item value in
+							xNextTaskUnblockTime. */
+							xNextTaskUnblockTime = xItemValue;
+							break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_TIMING_WHEEL */
+
+					/* It is time to remove the item from the Blocked state. */
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+					/* Is the task waiting on an event also?  If so remove
+					it from the event list. */
+					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Place the unblocked task into the appropriate ready
+					list. */
+					
+					/* edit here */
+					/* prvAddTaskToReadyList sets the deadline from the release time of the job and inserts it in the correct position in the EDF ready heap */
+					prvAddTaskToReadyList( pxTCB );
+					/* A task being unblocked cannot cause an immediate
+					context switch if preemption is turned off. */
+
+					#if (  configUSE_PREEMPTION == 1 )
+					{
+						#if ( configUSE_EDF_SCHEDULER == 1 )
+						{
+							/* Only switch if the released job has an earlier
+							deadline than the running task, otherwise the
+							scheduler would select the running task again. */
+							xJobReleased = pdTRUE;
+
+							if( taskEDF_PREEMPTS_CURRENT( pxTCB ) != pdFALSE )
+							{
+								xSwitchRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#else
+						{
+							/* Preemption is on, but a context switch should
+							only be performed if the unblocked task has a
+							priority that is equal to or higher than the
+							currently executing task. */
+							if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+							{
+								xSwitchRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_EDF_SCHEDULER */
+					}
+					#endif /* configUSE_PREEMPTION */
+				}
+			}
+		}
+
+		#if ( configUSE_EDF_OVERRUN_POLICY == 1 )
+		{
+			/* A job that is abandoned or gets a later deadline needs a switch
+			even if preemption is off. */
+			if( prvEnforceOverrunPolicy( xConstTickCount ) != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_OVERRUN_POLICY */
+
+		#if ( configUSE_EDF_BUDGETS == 1 )
+		{
+			/* A job that has just used its budget in the background lets the
+			jobs that still have budget run. */
+			if( prvUpdateRunTime() != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_BUDGETS */
+
+		/* Tasks of equal priority to the currently running task will share
+		processing time (time slice) if preemption is on, and the application
+		writer has not explicitly turned time slicing off. */
+		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		{
+			/*edit 
+			it will not enter here because it's not bossible to have 
+			the same periority with other tasks in EDF */
+			#if (configUSE_EDF_SCHEDULER == 0)
+			{
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			#endif /* configUSE_EDF_SCHEDULER == 0 */
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+		#if ( configUSE_TICK_HOOK == 1 )
+		{
+			/* Guard against the tick hook being called when the pended tick
+			count is being unwound (when the scheduler is being unlocked). */
+			if( xPendedTicks == ( TickType_t ) 0 )
+			{
+				vApplicationTickHook();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TICK_HOOK */
+
+		#if ( configUSE_PREEMPTION == 1 )
+		{
+			if( xYieldPending != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_PREEMPTION */
+
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+		{
+			if( ( xJobReleased != pdFALSE ) && ( xSwitchRequired == pdFALSE ) )
+			{
+				uxAvoidedContextSwitches++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_EDF_SCHEDULER */
+	}
+	else
+	{
+		++xPendedTicks;
+
+		/* The tick hook gets called at regular intervals, even if the
+		scheduler is locked. */
+		#if ( configUSE_TICK_HOOK == 1 )
+		{
+			vApplicationTickHook();
+		}
+		#endif
+	}
+
+	return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	void vTaskSetApplicationTaskTag( TaskHandle_t xTask, TaskHookFunction_t pxHookFunction )
+	{
+	TCB_t *xTCB;
+
+		/* If xTask is NULL then it is the task hook of the calling task that is
+		getting set. */
+		if( xTask == NULL )
+		{
+			xTCB = ( TCB_t * ) pxCurrentTCB;
+		}
+		else
+		{
+			xTCB = xTask;
+		}
+
+		/* Save the hook function in the TCB.  A critical section is required as
+		the value can be accessed from an interrupt. */
+		taskENTER_CRITICAL();
+		{
+			xTCB->pxTaskTag = pxHookFunction;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	TaskHookFunction_t xReturn;
+
+		/* If xTask is NULL then set the calling task's hook. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		/* Save the hook function in the TCB.  A critical section is required as
+		the value can be accessed from an interrupt. */
+		taskENTER_CRITICAL();
+		{
+			xReturn = pxTCB->pxTaskTag;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	TaskHookFunction_t xReturn;
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* If xTask is NULL then set the calling task's hook. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		/* Save the hook function in the TCB.  A critical section is required as
+		the value can be accessed from an interrupt. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xReturn = pxTCB->pxTaskTag;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParameter )
+	{
+	TCB_t *xTCB;
+	BaseType_t xReturn;
+
+		/* If xTask is NULL then we are calling our own task hook. */
+		if( xTask == NULL )
+		{
+			xTCB = pxCurrentTCB;
+		}
+		else
+		{
+			xTCB = xTask;
+		}
+
+		if( xTCB->pxTaskTag != NULL )
+		{
+			xReturn = xTCB->pxTaskTag( pvParameter );
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static BaseType_t prvUpdateRunTime( void )
+	{
+	BaseType_t xSwitchRequired = pdFALSE;
+	uint32_t ulRunTime;
+
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+		#else
+			ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
+
+		/* Add the amount of time the task has been running to the
+		accumulated time so far.  The time the task started running, or was
+		last charged from the tick, was stored in ulTaskSwitchedInTime.  Note
+		that there is no overflow protection here so count values are only
+		valid until the timer overflows.  The guard against negative values is
+		to protect against suspect run time stat counter implementations -
+		which are provided by the application, not the kernel. */
+		if( ulTotalRunTime > ulTaskSwitchedInTime )
+		{
+			ulRunTime = ulTotalRunTime - ulTaskSwitchedInTime;
+			pxCurrentTCB->ulRunTimeCounter += ulRunTime;
+
+			#if ( configUSE_EDF_BUDGETS == 1 )
+			{
+				if( ( pxCurrentTCB->ulBudget != 0UL ) && ( pxCurrentTCB->xBudgetExhausted == pdFALSE ) )
+				{
+					pxCurrentTCB->ulBudgetUsed += ulRunTime;
+
+					if( pxCurrentTCB->ulBudgetUsed > pxCurrentTCB->ulBudget )
+					{
+						#if ( configUSE_EDF_CBS == 1 )
+						if( pxCurrentTCB->pxCbsJobs != NULL )
+						{
+							/* A server gets a full budget straight away but
+							its deadline is put back by a server period, so it
+							never uses more than its bandwidth. */
+							do
+							{
+								pxCurrentTCB->ulBudgetUsed -= pxCurrentTCB->ulBudget;
+								pxCurrentTCB->xTaskReleaseTime += pxCurrentTCB->xTaskPeriod;
+							} while( pxCurrentTCB->ulBudgetUsed > pxCurrentTCB->ulBudget );
+						}
+						else
+						#endif /* configUSE_EDF_CBS */
+						{
+							/* The job keeps its absolute deadline, so a late
+							completion is still recorded as a miss, but it
+							only runs when no job with budget left is
+							ready. */
+							pxCurrentTCB->xBudgetExhausted = pdTRUE;
+							traceTASK_BUDGET_EXHAUSTED( pxCurrentTCB );
+						}
+
+						if( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE )
+						{
+							prvReadyHeapRemove( pxCurrentTCB );
+							listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), taskEDF_READY_DEADLINE( pxCurrentTCB ) );
+							prvReadyHeapInsert( pxCurrentTCB );
+
+							if( taskEDF_EARLIEST_READY_TASK() != pxCurrentTCB )
+							{
+								xSwitchRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_BUDGETS */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+		ulTaskSwitchedInTime = ulTotalRunTime;
+
+		return xSwitchRequired;
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_BUDGETS == 1 )
+
+	static void prvRefillBudget( void )
+	{
+		/* Charge the job that is ending first, so none of its run time is
+		taken from the budget of the next job. */
+		( void ) prvUpdateRunTime();
+
+		pxCurrentTCB->ulBudgetUsed = 0UL;
+		pxCurrentTCB->xBudgetExhausted = pdFALSE;
+	}
+
+#endif /* configUSE_EDF_BUDGETS */
+/*-----------------------------------------------------------*/
+
+void vTaskSwitchContext( void )
+{
+	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+	{
+		/* The scheduler is currently suspended - do not allow a context
+		switch. */
+		xYieldPending = pdTRUE;
+	}
+	else
+	{
+		xYieldPending = pdFALSE;
+		traceTASK_SWITCHED_OUT();
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			/* A job that has used its budget is moved down the ready heap
+			before the next task is selected. */
+			( void ) prvUpdateRunTime();
+		}
+		#endif /* configGENERATE_RUN_TIME_STATS */
+
+		/* Check for stack overflow, if configured. */
+		taskCHECK_FOR_STACK_OVERFLOW();
+
+		/* Before the currently running task is switched out, save its errno. */
+		#if( configUSE_POSIX_ERRNO == 1 )
+		{
+			pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+		}
+		#endif
+
+		/* Select a new task to run using either the generic C or port
+		optimised asm code. */
+		#if (configUSE_EDF_SCHEDULER == 0)
+		{
+			taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		}
+		#else
+		/* edit */
+		/* Get the earliest deadline task, at the root of the ready heap or the
+		head of the ready list.  The idle task is never in either and only runs
+		when they are empty. */
+		{
+			if( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE )
+			{
+				#if ( configUSE_EDF_SRP == 1 )
+				{
+					pxCurrentTCB = prvSrpSelectTask();
+					pxCurrentTCB->xJobStarted = pdTRUE;
+				}
+				#else
+				{
+					pxCurrentTCB = taskEDF_EARLIEST_READY_TASK();
+				}
+				#endif
+			}
+			else
+			{
+				pxCurrentTCB = xIdleTaskHandle;
+			}
+
+			#if ( configUSE_EDF_OVERRUN_POLICY == 1 )
+			{
+				/* The job of the selected task was abandoned while it was
+				switched out, so its saved context is no longer needed. */
+				if( pxCurrentTCB->xRestartPending != pdFALSE )
+				{
+					prvRestartJob( pxCurrentTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+		}
+		#endif
+		traceTASK_SWITCHED_IN();
+
+		/* After the new task is switched in, update the global errno. */
+		#if( configUSE_POSIX_ERRNO == 1 )
+		{
+			FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+		}
+		#endif
+
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		{
+			/* Switch Newlib's _impure_ptr variable to point to the _reent
+			structure specific to this task.
+			See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+			for additional information. */
+			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+		}
+		#endif /* configUSE_NEWLIB_REENTRANT */
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
+{
+	configASSERT( pxEventList );
+
+	/* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+	SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+	/* Place the event list item of the TCB in the appropriate event list.
+	This is placed in the list in priority order so the highest priority task
+	is the first to be woken by the event.  The queue that contains the event
+	list is locked, preventing simultaneous access from interrupts. */
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		/* Under EDF every task has the same priority, so the list is kept in
+		deadline order instead and the most urgent task is woken first.  The
+		value is set on every wait as the deadline moves with each job. */
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), taskEVENT_LIST_ITEM_KEY( pxCurrentTCB ) );
+		prvListInsertByDeadline( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+	}
+	#else
+	{
+		vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+	}
+	#endif
+
+	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait )
+{
+	configASSERT( pxEventList );
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event groups implementation. */
+	configASSERT( uxSchedulerSuspended != 0 );
+
+	/* Store the item value in the event list item.  It is safe to access the
+	event list item here as interrupts won't access the event list item of a
+	task that is not in the Blocked state. */
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		pxCurrentTCB->ucEventListItemInUse = ( uint8_t ) pdTRUE;
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue );
+	}
+	#else
+	{
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+	}
+	#endif
+
+	/* Place the event list item of the TCB at the end of the appropriate event
+	list.  It is safe to access the event list here because it is part of an
+	event group implementation - and interrupts don't access event groups
+	directly (instead they access them indirectly by pending function calls to
+	the task level). */
+	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMERS == 1 )
+
+	void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely )
+	{
+		configASSERT( pxEventList );
+
+		/* This function should not be called by application code hence the
+		'Restricted' in its name.  It is not part of the public API.  It is
+		designed for use by kernel code, and has special calling requirements -
+		it should be called with the scheduler suspended. */
+
+
+		/* Place the event list item of the TCB in the appropriate event list.
+		In this case it is assume that this is the only task that is going to
+		be waiting on this event list, so the faster vListInsertEnd() function
+		can be used in place of vListInsert. */
+		vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+		/* If the task should block indefinitely then set the block time to a
+		value that will be recognised as an indefinite delay inside the
+		prvAddCurrentTaskToDelayedList() function. */
+		if( xWaitIndefinitely != pdFALSE )
+		{
+			xTicksToWait = portMAX_DELAY;
+		}
+
+		traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+		prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+	}
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+TCB_t *pxUnblockedTCB;
+BaseType_t xReturn;
+
+	/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+	called from a critical section within an ISR. */
+
+	/* The event list is sorted in priority order, or in deadline order under
+	EDF, so the first in the list can be removed as it is known to be the
+	highest priority.  Remove the TCB from
+	the delayed list, and add it to the ready list.
+
+	If an event is for a queue that is locked then this function will never
+	get called - the lock count on the queue will get modified instead.  This
+	means exclusive access to the event list is guaranteed here.
+
+	This function assumes that a check has already been made to ensure that
+	pxEventList is not empty. */
+	pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( &( pxUnblockedTCB->xEventListItem ) );
+
+	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	{
+		( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+		prvAddTaskToReadyList( pxUnblockedTCB );
+
+		#if( configUSE_TICKLESS_IDLE != 0 )
+		{
+			/* If a task is blocked on a kernel object then xNextTaskUnblockTime
+			might be set to the blocked task's time out time.  If the task is
+			unblocked for a reason other than a timeout xNextTaskUnblockTime is
+			normally left unchanged, because it is automatically reset to a new
+			value when the tick count equals xNextTaskUnblockTime.  However if
+			tickless idling is used it might be more important to enter sleep mode
+			at the earliest possible time - so reset xNextTaskUnblockTime here to
+			ensure it is updated at the earliest possible time. */
+			prvResetNextTaskUnblockTime();
+		}
+		#endif
+	}
+	else
+	{
+		/* The delayed and ready lists cannot be accessed, so hold this task
+		pending until the scheduler is resumed. */
+		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+	}
+
+	if( taskUNBLOCKED_TASK_PREEMPTS( pxUnblockedTCB ) != pdFALSE )
+	{
+		/* Return true if the task removed from the event list has a higher
+		priority, or an earlier deadline under EDF, than the calling task.  This allows the calling task to know if
+		it should force a context switch now. */
+		xReturn = pdTRUE;
+
+		/* Mark that a yield is pending in case the user is not using the
+		"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+		xYieldPending = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+{
+TCB_t *pxUnblockedTCB;
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event flags implementation. */
+	configASSERT( uxSchedulerSuspended != pdFALSE );
+
+	/* Store the new item value in the event list.  Under EDF the item is
+	still marked as in use by ucEventListItemInUse. */
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue );
+	}
+	#else
+	{
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+	}
+	#endif
+
+	/* Remove the event list form the event flag.  Interrupts do not access
+	event flags. */
+	pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( pxEventListItem );
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+	{
+		/* If a task is blocked on a kernel object then xNextTaskUnblockTime
+		might be set to the blocked task's time out time.  If the task is
+		unblocked for a reason other than a timeout xNextTaskUnblockTime is
+		normally left unchanged, because it is automatically reset to a new
+		value when the tick count equals xNextTaskUnblockTime.  However if
+		tickless idling is used it might be more important to enter sleep mode
+		at the earliest possible time - so reset xNextTaskUnblockTime here to
+		ensure it is updated at the earliest possible time. */
+		prvResetNextTaskUnblockTime();
+	}
+	#endif
+
+	/* Remove the task from the delayed list and add it to the ready list.  The
+	scheduler is suspended so interrupts will not be accessing the ready
+	lists. */
+	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+	prvAddTaskToReadyList( pxUnblockedTCB );
+
+	if( taskUNBLOCKED_TASK_PREEMPTS( pxUnblockedTCB ) != pdFALSE )
+	{
+		/* The unblocked task has a priority above that of the calling task, so
+		a context switch is required.  This function is called with the
+		scheduler suspended so xYieldPending is set so the context switch
+		occurs immediately that the scheduler is resumed (unsuspended). */
+		xYieldPending = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+	configASSERT( pxTimeOut );
+	taskENTER_CRITICAL();
+	{
+		pxTimeOut->xOverflowCount = xNumOfOverflows;
+		pxTimeOut->xTimeOnEntering = xTickCount;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+	/* For internal use only as it does not use a critical section. */
+	pxTimeOut->xOverflowCount = xNumOfOverflows;
+	pxTimeOut->xTimeOnEntering = xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const pxTicksToWait )
+{
+BaseType_t xReturn;
+
+	configASSERT( pxTimeOut );
+	configASSERT( pxTicksToWait );
+
+	taskENTER_CRITICAL();
+	{
+		/* Minor optimisation.  The tick count cannot change in this block. */
+		const TickType_t xConstTickCount = xTickCount;
+		const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+
+		#if( INCLUDE_xTaskAbortDelay == 1 )
+			if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+			{
+				/* The delay was aborted, which is not the same as a time out,
+				but has the same result. */
+				pxCurrentTCB->ucDelayAborted = pdFALSE;
+				xReturn = pdTRUE;
+			}
+			else
+		#endif
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+			if( *pxTicksToWait == portMAX_DELAY )
+			{
+				/* If INCLUDE_vTaskSuspend is set to 1 and the block time
+				specified is the maximum block time then the task should block
+				indefinitely, and therefore never time out. */
+				xReturn = pdFALSE;
+			}
+			else
+		#endif
+
+		if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+		{
+			/* The tick count is greater than the time at which
+			vTaskSetTimeout() was called, but has also overflowed since
+			vTaskSetTimeOut() was called.  It must have wrapped all the way
+			around and gone past again. This passed since vTaskSetTimeout()
+			was called. */
+			xReturn = pdTRUE;
+		}
+		else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+		{
+			/* Not a genuine timeout. Adjust parameters for time remaining. */
+			*pxTicksToWait -= xElapsedTime;
+			vTaskInternalSetTimeOutState( pxTimeOut );
+			xReturn = pdFALSE;
+		}
+		else
+		{
+			*pxTicksToWait = 0;
+			xReturn = pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskMissedYield( void )
+{
+	xYieldPending = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+	{
+	UBaseType_t uxReturn;
+	TCB_t const *pxTCB;
+
+		if( xTask != NULL )
+		{
+			pxTCB = xTask;
+			uxReturn = pxTCB->uxTaskNumber;
+		}
+		else
+		{
+			uxReturn = 0U;
+		}
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vTaskSetTaskNumber( TaskHandle_t xTask, const UBaseType_t uxHandle )
+	{
+	TCB_t * pxTCB;
+
+		if( xTask != NULL )
+		{
+			pxTCB = xTask;
+			pxTCB->uxTaskNumber = uxHandle;
+		}
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+
+/*
+ * -----------------------------------------------------------
+ * The Idle task.
+ * ----------------------------------------------------------
+ *
+ * The portTASK_FUNCTION() macro is used to allow port/compiler specific
+ * language extensions.  The equivalent prototype for this function is:
+ *
+ * void prvIdleTask( void *pvParameters );
+ *
+ */
+static portTASK_FUNCTION( prvIdleTask, pvParameters )
+{
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	/** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
+	SCHEDULER IS STARTED. **/
+
+	/* In case a task that has a secure context deletes itself, in which case
+	the idle task is responsible for deleting the task's secure context, if
+	any. */
+	
+	portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+	for( ;; )
+	{
+		/* See if any tasks have deleted themselves - if so then the idle task
+		is responsible for freeing the deleted task's TCB and stack. */
+		prvCheckTasksWaitingTermination();
+
+		
+		#if ( configUSE_PREEMPTION == 0 )
+		{
+			/* If we are not using preemption we keep forcing a task switch to
+			see if any other task has become available.  If we are using
+			preemption we don't need to do this as any task becoming available
+			will automatically get the processor anyway. */
+			taskYIELD();
+		}
+		#endif /* configUSE_PREEMPTION */
+
+		#if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+		{
+			/* When using preemption tasks of equal priority will be
+			timesliced.  If a task that is sharing the idle priority is ready
+			to run then the idle task should yield before the end of the
+			timeslice.
+
+			A critical region is not required here as we are just reading from
+			the list, and an occasional incorrect value will not matter.  If
+			the ready list at the idle priority contains more than one task
+			then a task other than the idle task is ready to execute. */
+			#if (configUSE_EDF_SCHEDULER == 0)
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			{
+				taskYIELD();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			#else
+			/* The idle task is not in the EDF ready heap, so any task in the
+			heap is ready to run in its place. */
+			if( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE )
+			{
+				taskYIELD();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			#endif
+		}
+		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+		#if ( configUSE_IDLE_HOOK == 1 )
+		{
+			extern void vApplicationIdleHook( void );
+
+			/* Call the user defined function from within the idle task.  This
+			allows the application designer to add background functionality
+			without the overhead of a separate task.
+			NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
+			CALL A FUNCTION THAT MIGHT BLOCK. */
+			vApplicationIdleHook();
+		}
+		#endif /* configUSE_IDLE_HOOK */
+
+		/* This conditional compilation should use inequality to 0, not equality
+		to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+		user defined low power mode	implementations require
+		configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+		#if ( configUSE_TICKLESS_IDLE != 0 )
+		{
+		TickType_t xExpectedIdleTime;
+
+			/* It is not desirable to suspend then resume the scheduler on
+			each iteration of the idle task.  Therefore, a preliminary
+			test of the expected idle time is performed without the
+			scheduler suspended.  The result here is not necessarily
+			valid. */
+			xExpectedIdleTime = prvGetExpectedIdleTime();
+
+			if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+			{
+				vTaskSuspendAll();
+				{
+					/* Now the scheduler is suspended, the expected idle
+					time can be sampled again, and this time its value can
+					be used. */
+					configASSERT( xNextTaskUnblockTime >= xTickCount );
+					xExpectedIdleTime = prvGetExpectedIdleTime();
+
+					/* Define the following macro to set xExpectedIdleTime to 0
+					if the application does not want
+					portSUPPRESS_TICKS_AND_SLEEP() to be called. */
+					configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+
+					if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+					{
+						traceLOW_POWER_IDLE_BEGIN();
+						portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+						traceLOW_POWER_IDLE_END();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TICKLESS_IDLE */
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE != 0 )
+
+	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+	{
+	/* The idle task exists in addition to the application tasks. */
+	const UBaseType_t uxNonApplicationTasks = 1;
+	eSleepModeStatus eReturn = eStandardSleep;
+
+		/* This function must be called from a critical section. */
+
+		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+		{
+			/* A task was made ready while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else if( xYieldPending != pdFALSE )
+		{
+			/* A yield was pended while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else
+		{
+			/* If all the tasks are in the suspended list (which might mean they
+			have an infinite block time rather than actually being suspended)
+			then it is safe to turn all clocks off and just wait for external
+			interrupts. */
+			if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+			{
+				eReturn = eNoTasksWaitingTimeout;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return eReturn;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+	void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )
+	{
+	TCB_t *pxTCB;
+
+		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+		{
+			pxTCB = prvGetTCBFromHandle( xTaskToSet );
+			configASSERT( pxTCB != NULL );
+			pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+		}
+	}
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+	void *pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery, BaseType_t xIndex )
+	{
+	void *pvReturn = NULL;
+	TCB_t *pxTCB;
+
+		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+		{
+			pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+			pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+		}
+		else
+		{
+			pvReturn = NULL;
+		}
+
+		return pvReturn;
+	}
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_MPU_WRAPPERS == 1 )
+
+	void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify, const MemoryRegion_t * const xRegions )
+	{
+	TCB_t *pxTCB;
+
+		/* If null is passed in here then we are modifying the MPU settings of
+		the calling task. */
+		pxTCB = prvGetTCBFromHandle( xTaskToModify );
+
+		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+	}
+
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseTaskLists( void )
+{
+UBaseType_t uxPriority;
+#if ( configUSE_TIMING_WHEEL == 1 )
+	UBaseType_t uxList;
+#endif
+
+	for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+	{
+		#if(configUSE_EDF_SCHEDULER == 0)
+		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+		#endif
+	}
+	
+	/* 
+	6
+	edit 1 1.2 
+	initialize all the ready tasks in the new readyList in the beginning 
+	*/
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		vListInitialise( &xReadyTasksListEDF );
+	}
+	#endif
+
+	#if ( configUSE_EDF_JOBS == 1 )
+	{
+	UBaseType_t uxServer;
+
+		for( uxServer = ( UBaseType_t ) 0U; uxServer < ( UBaseType_t ) configEDF_JOB_SERVERS; uxServer++ )
+		{
+			vListInitialise( &( xJobServers[ uxServer ].xPendingJobsList ) );
+			vListInitialise( &( xJobServers[ uxServer ].xReadyJobsList ) );
+		}
+	}
+	#endif
+
+	#if ( configUSE_TIMING_WHEEL == 1 )
+	{
+		for( uxList = ( UBaseType_t ) 0U; uxList < taskWHEEL_LISTS; uxList++ )
+		{
+			vListInitialise( &( xTimingWheel[ uxList ] ) );
+		}
+	}
+	#else
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#endif /* configUSE_TIMING_WHEEL */
+	vListInitialise( &xPendingReadyList );
+
+	#if ( INCLUDE_vTaskDelete == 1 )
+	{
+		vListInitialise( &xTasksWaitingTermination );
+	}
+	#endif /* INCLUDE_vTaskDelete */
+
+	#if ( INCLUDE_vTaskSuspend == 1 )
+	{
+		vListInitialise( &xSuspendedTaskList );
+	}
+	#endif /* INCLUDE_vTaskSuspend */
+
+	#if ( configUSE_TIMING_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+		using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif /* configUSE_TIMING_WHEEL */
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTasksWaitingTermination( void )
+{
+
+	/** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+
+	#if ( INCLUDE_vTaskDelete == 1 )
+	{
+		TCB_t *pxTCB;
+
+		/* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
+		being called too often in the idle task. */
+		while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				--uxCurrentNumberOfTasks;
+				--uxDeletedTasksWaitingCleanUp;
+			}
+			taskEXIT_CRITICAL();
+
+			prvDeleteTCB( pxTCB );
+		}
+	}
+	#endif /* INCLUDE_vTaskDelete */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRACE_FACILITY == 1 )
+
+	void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState )
+	{
+	TCB_t *pxTCB;
+
+		/* xTask is NULL then get the state of the calling task. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
+		pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName [ 0 ] );
+		pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+		pxTaskStatus->pxStackBase = pxTCB->pxStack;
+		pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+		}
+		#else
+		{
+			pxTaskStatus->uxBasePriority = 0;
+		}
+		#endif
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+		}
+		#else
+		{
+			pxTaskStatus->ulRunTimeCounter = 0;
+		}
+		#endif
+
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+		{
+			pxTaskStatus->uxDeadlineMisses = pxTCB->uxDeadlineMisses;
+			pxTaskStatus->xWorstLateness = pxTCB->xWorstLateness;
+			pxTaskStatus->xLastMissTick = pxTCB->xLastMissTick;
+		}
+		#endif
+
+		/* Obtaining the task state is a little fiddly, so is only done if the
+		value of eState passed into this function is eInvalid - otherwise the
+		state is just set to whatever is passed in. */
+		if( eState != eInvalid )
+		{
+			if( pxTCB == pxCurrentTCB )
+			{
+				pxTaskStatus->eCurrentState = eRunning;
+			}
+			else
+			{
+				pxTaskStatus->eCurrentState = eState;
+
+				#if ( INCLUDE_vTaskSuspend == 1 )
+				{
+					/* If the task is in the suspended list then there is a
+					chance it is actually just blocked indefinitely - so really
+					it should be reported as being in the Blocked state. */
+					if( eState == eSuspended )
+					{
+						vTaskSuspendAll();
+						{
+							if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+							{
+								pxTaskStatus->eCurrentState = eBlocked;
+							}
+						}
+						( void ) xTaskResumeAll();
+					}
+				}
+				#endif /* INCLUDE_vTaskSuspend */
+			}
+		}
+		else
+		{
+			pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+		}
+
+		/* Obtaining the stack space takes some time, so the xGetFreeStackSpace
+		parameter is provided to allow it to be skipped. */
+		if( xGetFreeStackSpace != pdFALSE )
+		{
+			#if ( portSTACK_GROWTH > 0 )
+			{
+				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+			}
+			#else
+			{
+				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+			}
+			#endif
+		}
+		else
+		{
+			pxTaskStatus->usStackHighWaterMark = 0;
+		}
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t *pxTaskStatusArray, List_t *pxList, eTaskState eState )
+	{
+	configLIST_VOLATILE TCB_t *pxNextTCB, *pxFirstTCB;
+	UBaseType_t uxTask = 0;
+
+		if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+			/* Populate an TaskStatus_t structure within the
+			pxTaskStatusArray array for each task that is referenced from
+			pxList.  See the definition of TaskStatus_t in task.h for the
+			meaning of each TaskStatus_t structure member. */
+			do
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+				uxTask++;
+			} while( pxNextTCB != pxFirstTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxTask;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+
+	static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+	{
+	uint32_t ulCount = 0U;
+
+		while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+		{
+			pucStackByte -= portSTACK_GROWTH;
+			ulCount++;
+		}
+
+		ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+
+		return ( configSTACK_DEPTH_TYPE ) ulCount;
+	}
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+
+	/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
+	same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
+	user to determine the return type.  It gets around the problem of the value
+	overflowing on 8-bit types without breaking backward compatibility for
+	applications that expect an 8-bit return type. */
+	configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	uint8_t *pucEndOfStack;
+	configSTACK_DEPTH_TYPE uxReturn;
+
+		/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
+		the same except for their return type.  Using configSTACK_DEPTH_TYPE
+		allows the user to determine the return type.  It gets around the
+		problem of the value overflowing on 8-bit types without breaking
+		backward compatibility for applications that expect an 8-bit return
+		type. */
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		#if portSTACK_GROWTH < 0
+		{
+			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+		}
+		#else
+		{
+			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+		}
+		#endif
+
+		uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+		return uxReturn;
+	}
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+
+	UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	uint8_t *pucEndOfStack;
+	UBaseType_t uxReturn;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		#if portSTACK_GROWTH < 0
+		{
+			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+		}
+		#else
+		{
+			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+		}
+		#endif
+
+		uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+		return uxReturn;
+	}
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+	static void prvDeleteTCB( TCB_t *pxTCB )
+	{
+		/* This call is required specifically for the TriCore port.  It must be
+		above the vPortFree() calls.  The call is also used by ports/demos that
+		want to allocate and clean RAM statically. */
+		portCLEAN_UP_TCB( pxTCB );
+
+		/* Free up the memory allocated by the scheduler for the task.  It is up
+		to the task to free any memory allocated at the application level.
+		See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+		for additional information. */
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		{
+			_reclaim_reent( &( pxTCB->xNewLib_reent ) );
+		}
+		#endif /* configUSE_NEWLIB_REENTRANT */
+
+		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+		{
+			/* The task can only have been allocated dynamically - free both
+			the stack and TCB. */
+			#if ( configUSE_EDF_CBS == 1 )
+			{
+				/* As is the job queue of a server. */
+				vPortFree( pxTCB->pxCbsJobs );
+			}
+			#endif
+			vPortFree( pxTCB->pxStack );
+			vPortFree( pxTCB );
+		}
+		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+		{
+			/* The task could have been allocated statically or dynamically, so
+			check what was statically allocated before trying to free the
+			memory. */
+			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+			{
+				/* Both the stack and TCB were allocated dynamically, so both
+				must be freed. */
+				#if ( configUSE_EDF_CBS == 1 )
+				{
+					/* A server created with xTaskCbsCreate() also has its
+					job queue allocated. */
+					vPortFree( pxTCB->pxCbsJobs );
+				}
+				#endif
+				vPortFree( pxTCB->pxStack );
+				vPortFree( pxTCB );
+			}
+			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+			{
+				/* Only the stack was statically allocated, so the TCB is the
+				only memory that must be freed. */
+				vPortFree( pxTCB );
+			}
+			else
+			{
+				/* Neither the stack nor the TCB were allocated dynamically, so
+				nothing needs to be freed. */
+				configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB	);
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+	}
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMING_WHEEL == 0 )
+
+static void prvResetNextTaskUnblockTime( void )
+{
+TCB_t *pxTCB;
+
+	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+	{
+		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+		the maximum possible value so it is	extremely unlikely that the
+		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+		there is an item in the delayed list. */
+		xNextTaskUnblockTime = portMAX_DELAY;
+	}
+	else
+	{
+		/* The new current delayed list is not empty, get the value of
+		the item at the head of the delayed list.  This is the time at
+		which the task at the head of the delayed list should be removed
+		from the Blocked state. */
+		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+	}
+}
+
+#else /* configUSE_TIMING_WHEEL */
+
+static void prvResetNextTaskUnblockTime( void )
+{
+const TickType_t xConstTickCount = xTickCount;
+TickType_t xBlock, xSlot, xTicks, xTicksToNext = portMAX_DELAY;
+UBaseType_t uxLevel;
+
+	/* Under the wheel xNextTaskUnblockTime is the next tick on which a list
+	that is not empty is processed, which is no later than the wake time of
+	any of its tasks.  A list of a level above 0 is processed on the first tick
+	it spans, and the far list each time the tick count is a multiple of the
+	range of the wheel.  The search is bounded by the size of the wheel, not by
+	the number of blocked tasks. */
+	if( listLIST_IS_EMPTY( taskWHEEL_FAR_LIST ) == pdFALSE )
+	{
+		xTicksToNext = ( ( xConstTickCount | ( taskWHEEL_RANGE - ( TickType_t ) 1U ) ) + ( TickType_t ) 1U ) - xConstTickCount;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+	{
+		/* The lists of the level after the current one, in the order they
+		come round.  The last is the current list itself, which can hold tasks
+		one full turn of the level ahead. */
+		xBlock = xConstTickCount >> taskWHEEL_SHIFT( uxLevel );
+
+		for( xSlot = ( TickType_t ) 1U; xSlot <= taskWHEEL_SLOTS; xSlot++ )
+		{
+			if( listLIST_IS_EMPTY( taskWHEEL_LIST( uxLevel, ( xBlock + xSlot ) & taskWHEEL_SLOT_MASK ) ) == pdFALSE )
+			{
+				xTicks = ( ( xBlock + xSlot ) << taskWHEEL_SHIFT( uxLevel ) ) - xConstTickCount;
+
+				if( xTicks < xTicksToNext )
+				{
+					xTicksToNext = xTicks;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	if( xTicksToNext > ( portMAX_DELAY - xConstTickCount ) )
+	{
+		/* Nothing to do before the tick count overflows.  The wheel is looked
+		at again on tick 0, see taskSWITCH_DELAYED_LISTS(). */
+		xNextTaskUnblockTime = portMAX_DELAY;
+	}
+	else
+	{
+		xNextTaskUnblockTime = xConstTickCount + xTicksToNext;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimingWheelInsert( ListItem_t * const pxListItem, const TickType_t xFirstTick )
+{
+TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxListItem );
+TickType_t xTicksToWake = xTimeToWake - xFirstTick;
+TickType_t xProcessTime;
+UBaseType_t uxLevel = ( UBaseType_t ) 0U;
+List_t *pxList;
+
+	if( xTicksToWake == portMAX_DELAY )
+	{
+		/* The task blocked for no time, so its wake time is the tick that has
+		just been processed.  It wakes on the next tick, as it would from the
+		delayed list. */
+		xTimeToWake = xFirstTick;
+		xTicksToWake = ( TickType_t ) 0U;
+		listSET_LIST_ITEM_VALUE( pxListItem, xTimeToWake );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xTicksToWake >= taskWHEEL_RANGE )
+	{
+		/* Beyond the reach of the wheel.  The far list is walked each time
+		the wheel comes full circle, and the task moves onto the wheel once it
+		is in reach. */
+		pxList = taskWHEEL_FAR_LIST;
+		xProcessTime = ( ( xFirstTick - ( TickType_t ) 1U ) | ( taskWHEEL_RANGE - ( TickType_t ) 1U ) ) + ( TickType_t ) 1U;
+	}
+	else
+	{
+		/* The lowest level that reaches the wake time.  Its list for the wake
+		time is not processed again before the first tick that list spans, as
+		the wake time is less than a full turn of the level ahead. */
+		while( xTicksToWake >= taskWHEEL_SLOT_TICKS( uxLevel + ( UBaseType_t ) 1U ) )
+		{
+			uxLevel++;
+		}
+
+		pxList = taskWHEEL_LIST( uxLevel, ( xTimeToWake >> taskWHEEL_SHIFT( uxLevel ) ) & taskWHEEL_SLOT_MASK );
+		xProcessTime = ( xTimeToWake >> taskWHEEL_SHIFT( uxLevel ) ) << taskWHEEL_SHIFT( uxLevel );
+	}
+
+	/* The order within a list does not matter, so there is no walk. */
+	vListInsertEnd( pxList, pxListItem );
+
+	/* Compared relative to the tick count, as the process time can be beyond
+	the next overflow of the tick count. */
+	if( ( TickType_t ) ( xProcessTime - xTickCount ) < ( TickType_t ) ( xNextTaskUnblockTime - xTickCount ) )
+	{
+		xNextTaskUnblockTime = xProcessTime;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static List_t * prvTimingWheelAdvance( const TickType_t xTime )
+{
+UBaseType_t uxLevel;
+List_t *pxList;
+ListItem_t *pxListItem, *pxNextListItem;
+
+	/* Each level is moved down when the level below wraps, lowest level
+	first, so no task is moved into a list that has already been processed on
+	this tick.  Each task in the list of the level moves to a lower level, as
+	they all wake within the span of the list. */
+	for( uxLevel = ( UBaseType_t ) 1U; ( uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS ) && ( ( xTime & ( taskWHEEL_SLOT_TICKS( uxLevel ) - ( TickType_t ) 1U ) ) == ( TickType_t ) 0U ); uxLevel++ )
+	{
+		pxList = taskWHEEL_LIST( uxLevel, ( xTime >> taskWHEEL_SHIFT( uxLevel ) ) & taskWHEEL_SLOT_MASK );
+
+		while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+		{
+			pxListItem = listGET_HEAD_ENTRY( pxList );
+			( void ) uxListRemove( pxListItem );
+			prvTimingWheelInsert( pxListItem, xTime );
+		}
+	}
+
+	/* The far list is only walked once each time the wheel comes full circle,
+	and only the tasks now in reach leave it. */
+	if( ( xTime & ( taskWHEEL_RANGE - ( TickType_t ) 1U ) ) == ( TickType_t ) 0U )
+	{
+		pxList = taskWHEEL_FAR_LIST;
+		pxListItem = listGET_HEAD_ENTRY( pxList );
+
+		while( pxListItem != listGET_END_MARKER( pxList ) )
+		{
+			pxNextListItem = listGET_NEXT( pxListItem );
+
+			if( ( TickType_t ) ( listGET_LIST_ITEM_VALUE( pxListItem ) - xTime ) < taskWHEEL_RANGE )
+			{
+				( void ) uxListRemove( pxListItem );
+				prvTimingWheelInsert( pxListItem, xTime );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxListItem = pxNextListItem;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return taskWHEEL_LIST( 0, xTime & taskWHEEL_SLOT_MASK );
+}
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) )
+
+	static void prvReadyHeapSiftUp( TCB_t *pxTCB, UBaseType_t uxIndex )
+	{
+	UBaseType_t uxParent;
+	const TickType_t xDeadline = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+		/* Move the hole at uxIndex up until its parent has an earlier or equal
+		deadline.  Equal deadlines do not move up so a task that is already in
+		the heap keeps the processor over a newly readied task with the same
+		deadline, as vListInsert() did. */
+		while( uxIndex > ( UBaseType_t ) 0U )
+		{
+			uxParent = ( uxIndex - ( UBaseType_t ) 1U ) >> 1;
+
+			if( taskEDF_DEADLINE_BEFORE( xDeadline, listGET_LIST_ITEM_VALUE( &( pxReadyHeapEDF[ uxParent ]->xStateListItem ) ) ) )
+			{
+				pxReadyHeapEDF[ uxIndex ] = pxReadyHeapEDF[ uxParent ];
+				pxReadyHeapEDF[ uxIndex ]->uxReadyHeapIndex = uxIndex;
+				uxIndex = uxParent;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		pxReadyHeapEDF[ uxIndex ] = pxTCB;
+		pxTCB->uxReadyHeapIndex = uxIndex;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReadyHeapSiftDown( TCB_t *pxTCB, UBaseType_t uxIndex )
+	{
+	UBaseType_t uxChild;
+	const TickType_t xDeadline = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+		/* Move the hole at uxIndex down until both children have a later or
+		equal deadline. */
+		for( ;; )
+		{
+			uxChild = ( uxIndex << 1 ) + ( UBaseType_t ) 1U;
+
+			if( uxChild >= uxReadyHeapLength )
+			{
+				break;
+			}
+
+			if( ( ( uxChild + ( UBaseType_t ) 1U ) < uxReadyHeapLength ) &&
+				( taskEDF_DEADLINE_BEFORE( listGET_LIST_ITEM_VALUE( &( pxReadyHeapEDF[ uxChild + 1U ]->xStateListItem ) ), listGET_LIST_ITEM_VALUE( &( pxReadyHeapEDF[ uxChild ]->xStateListItem ) ) ) ) )
+			{
+				uxChild++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( taskEDF_DEADLINE_BEFORE( listGET_LIST_ITEM_VALUE( &( pxReadyHeapEDF[ uxChild ]->xStateListItem ) ), xDeadline ) )
+			{
+				pxReadyHeapEDF[ uxIndex ] = pxReadyHeapEDF[ uxChild ];
+				pxReadyHeapEDF[ uxIndex ]->uxReadyHeapIndex = uxIndex;
+				uxIndex = uxChild;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		pxReadyHeapEDF[ uxIndex ] = pxTCB;
+		pxTCB->uxReadyHeapIndex = uxIndex;
+	}
+
+#endif /* ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	static void prvListInsertByDeadline( List_t * const pxList, ListItem_t * const pxNewListItem )
+	{
+	const TickType_t xDeadline = listGET_LIST_ITEM_VALUE( pxNewListItem );
+	ListItem_t *pxListItem;
+	ListItem_t * const pxOldIndex = pxList->pxIndex;
+
+		for( pxListItem = listGET_HEAD_ENTRY( pxList );
+			 pxListItem != listGET_END_MARKER( pxList );
+			 pxListItem = listGET_NEXT( pxListItem ) )
+		{
+			if( taskEDF_DEADLINE_BEFORE( xDeadline, listGET_LIST_ITEM_VALUE( pxListItem ) ) )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* vListInsertEnd() places the item just before pxIndex, so point the
+		index at the item found and restore it afterwards.  These lists are
+		only read from the head, the index is not otherwise used. */
+		pxList->pxIndex = pxListItem;
+		vListInsertEnd( pxList, pxNewListItem );
+		pxList->pxIndex = pxOldIndex;
+	}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) )
+
+	static void prvReadyHeapInsert( TCB_t *pxTCB )
+	{
+		/* configEDF_MAX_READY_TASKS must be large enough to hold every task
+		that can be in the Ready state at the same time. */
+		configASSERT( uxReadyHeapLength < configEDF_MAX_READY_TASKS );
+
+		uxReadyHeapLength++;
+		prvReadyHeapSiftUp( pxTCB, uxReadyHeapLength - ( UBaseType_t ) 1U );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReadyHeapRemove( TCB_t *pxTCB )
+	{
+	const UBaseType_t uxIndex = pxTCB->uxReadyHeapIndex;
+	TCB_t *pxLastTCB;
+
+		configASSERT( uxReadyHeapLength > ( UBaseType_t ) 0U );
+		configASSERT( pxReadyHeapEDF[ uxIndex ] == pxTCB );
+
+		uxReadyHeapLength--;
+
+		if( uxIndex != uxReadyHeapLength )
+		{
+			/* Fill the hole left by the task with the last task in the heap.
+			Depending on its deadline that task has to move up or down. */
+			pxLastTCB = pxReadyHeapEDF[ uxReadyHeapLength ];
+
+			if( ( uxIndex > ( UBaseType_t ) 0U ) &&
+				( taskEDF_DEADLINE_BEFORE( listGET_LIST_ITEM_VALUE( &( pxLastTCB->xStateListItem ) ), listGET_LIST_ITEM_VALUE( &( pxReadyHeapEDF[ ( uxIndex - ( UBaseType_t ) 1U ) >> 1 ]->xStateListItem ) ) ) ) )
+			{
+				prvReadyHeapSiftUp( pxLastTCB, uxIndex );
+			}
+			else
+			{
+				prvReadyHeapSiftDown( pxLastTCB, uxIndex );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxReadyHeapEDF[ uxReadyHeapLength ] = NULL;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReadyHeapAppend( TCB_t *pxTCB )
+	{
+		configASSERT( uxReadyHeapLength < configEDF_MAX_READY_TASKS );
+
+		pxReadyHeapEDF[ uxReadyHeapLength ] = pxTCB;
+		pxTCB->uxReadyHeapIndex = uxReadyHeapLength;
+		uxReadyHeapLength++;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReadyHeapRebuild( UBaseType_t uxFirstAppended )
+	{
+	UBaseType_t uxLow = uxFirstAppended, uxHigh = uxReadyHeapLength - ( UBaseType_t ) 1U, uxIndex;
+
+		/* Only the appended tasks and their ancestors can be out of order.
+		Sift down the parents of the range, then the parents of those, and so
+		on up to the root, each range from the highest index down so every
+		subtree below a task is in order before the task is sifted down.  The
+		ranges halve at each level, so the whole rebuild is about as long as
+		the number of tasks appended plus the height of the heap. */
+		while( uxHigh > ( UBaseType_t ) 0U )
+		{
+			uxLow = ( uxLow > ( UBaseType_t ) 0U ) ? ( ( uxLow - ( UBaseType_t ) 1U ) >> 1 ) : ( UBaseType_t ) 0U;
+			uxHigh = ( uxHigh - ( UBaseType_t ) 1U ) >> 1;
+
+			for( uxIndex = uxHigh + ( UBaseType_t ) 1U; uxIndex > uxLow; uxIndex-- )
+			{
+				prvReadyHeapSiftDown( pxReadyHeapEDF[ uxIndex - ( UBaseType_t ) 1U ], uxIndex - ( UBaseType_t ) 1U );
+			}
+
+			/* Once a range has reached the root the whole heap is in
+			order. */
+			if( uxLow == ( UBaseType_t ) 0U )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+#elif ( configUSE_EDF_SCHEDULER == 1 )
+
+	static void prvReadyHeapInsert( TCB_t *pxTCB )
+	{
+		/* Walks the ready list from the earliest deadline until a later one
+		is found, as every release did before the ready heap. */
+		prvListInsertByDeadline( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReadyHeapRemove( TCB_t *pxTCB )
+	{
+		( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+	}
+
+#endif /* configUSE_EDF_READY_HEAP */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+	#if ( configUSE_EDF_SRP == 1 )
+
+		static TCB_t *prvSrpSelectTask( void )
+		{
+		TCB_t *pxSelectedTCB = taskEDF_EARLIEST_READY_TASK();
+		TCB_t *pxTCB;
+		ListItem_t const *pxListItem;
+
+			/* The earliest deadline can run unless it is held back by the
+			system ceiling, which is only ever the case while a resource is
+			locked.  Then every ready task is looked at, as the ready heap is
+			only ordered from the root. */
+			if( taskSRP_MAY_RUN( pxSelectedTCB ) == pdFALSE )
+			{
+				pxSelectedTCB = NULL;
+
+				for( pxListItem = listGET_HEAD_ENTRY( &xReadyTasksListEDF );
+					 pxListItem != listGET_END_MARKER( &xReadyTasksListEDF );
+					 pxListItem = listGET_NEXT( pxListItem ) )
+				{
+					pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+					if( ( taskSRP_MAY_RUN( pxTCB ) != pdFALSE ) &&
+						( ( pxSelectedTCB == NULL ) || ( taskEDF_DEADLINE_BEFORE( listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ), listGET_LIST_ITEM_VALUE( &( pxSelectedTCB->xStateListItem ) ) ) ) ) )
+					{
+						pxSelectedTCB = pxTCB;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				/* The job that locked the resource has started so can always
+				run, unless it blocked while holding the resource.  SRP does not
+				allow that, but rather than stall fall back to plain EDF. */
+				if( pxSelectedTCB == NULL )
+				{
+					pxSelectedTCB = taskEDF_EARLIEST_READY_TASK();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			return pxSelectedTCB;
+		}
+
+	#endif /* configUSE_EDF_SRP */
+	/*-----------------------------------------------------------*/
+
+	static void prvCheckForDeadlineMiss( TCB_t *pxTCB, const TickType_t xTimeNow )
+	{
+	const TickType_t xDeadline = taskEDF_ABSOLUTE_DEADLINE( pxTCB );
+	TickType_t xLateness;
+
+		/* A job that completes on the tick of its deadline is on time. */
+		if( taskEDF_TIME_BEFORE( xDeadline, xTimeNow ) )
+		{
+			xLateness = xTimeNow - xDeadline;
+
+			( pxTCB->uxDeadlineMisses )++;
+			pxTCB->xLastMissTick = xTimeNow;
+
+			if( xLateness > pxTCB->xWorstLateness )
+			{
+				pxTCB->xWorstLateness = xLateness;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			traceTASK_DEADLINE_MISSED( pxTCB, xLateness );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( configUSE_EDF_OVERRUN_POLICY == 1 )
+
+		static BaseType_t prvEnforceOverrunPolicy( const TickType_t xTimeNow )
+		{
+		TCB_t * const pxTCB = pxCurrentTCB;
+		UBaseType_t uxPolicy = pxTCB->uxOverrunPolicy;
+		TickType_t xLateness, xNextRelease;
+		BaseType_t xSwitchRequired = pdFALSE;
+
+			/* The deadline of a job moved on by taskOVERRUN_SKIP_NEXT can be
+			in the future, in which case the subtraction wraps to a value above
+			half the tick range. */
+			xLateness = xTimeNow - taskEDF_ABSOLUTE_DEADLINE( pxTCB );
+
+			if( ( uxPolicy != taskOVERRUN_CONTINUE ) &&
+				( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) ) != pdFALSE ) &&
+				( xLateness != ( TickType_t ) 0U ) &&
+				( xLateness < ( portMAX_DELAY >> 1 ) ) )
+			{
+				/* Record the miss now, an abandoned job never reaches
+				vTaskDelayUntil(). */
+				prvCheckForDeadlineMiss( pxTCB, xTimeNow );
+
+				#if ( configUSE_MUTEXES == 1 )
+				{
+					/* A job that holds a mutex cannot be abandoned as the
+					mutex would never be given back. */
+					if( pxTCB->uxMutexesHeld != ( UBaseType_t ) 0U )
+					{
+						uxPolicy = taskOVERRUN_SKIP_NEXT;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_MUTEXES */
+
+				if( uxPolicy == taskOVERRUN_SKIP_NEXT )
+				{
+					/* The job runs on in place of the next job, with that
+					job's deadline, and the next call to vTaskDelayUntil() waits
+					for the release after. */
+					pxTCB->xTaskReleaseTime += pxTCB->xTaskPeriod;
+					pxTCB->xSkippedTicks += pxTCB->xTaskPeriod;
+
+					#if ( configUSE_EDF_BUDGETS == 1 )
+					{
+						/* The budget of the next job is used too. */
+						prvRefillBudget();
+					}
+					#endif
+
+					prvReadyHeapRemove( pxTCB );
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), taskEDF_READY_DEADLINE( pxTCB ) );
+					prvReadyHeapInsert( pxTCB );
+
+					/* The later deadline may let another job run first. */
+					if( taskEDF_EARLIEST_READY_TASK() != pxTCB )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* Abandon the job and block the task until the first
+					release after now. */
+					xNextRelease = pxTCB->xTaskReleaseTime +
+						( ( ( ( TickType_t ) ( xTimeNow - pxTCB->xTaskReleaseTime ) / pxTCB->xTaskPeriod ) + ( TickType_t ) 1U ) * pxTCB->xTaskPeriod );
+
+					pxTCB->xTaskReleaseTime = xNextRelease;
+					pxTCB->xSkippedTicks = ( TickType_t ) 0U;
+					pxTCB->xRestartPending = pdTRUE;
+
+					#if ( configUSE_EDF_BUDGETS == 1 )
+					{
+						prvRefillBudget();
+					}
+					#endif
+
+					if( ( uxPolicy == taskOVERRUN_DEGRADE ) && ( pxTCB->pxFallbackCode != NULL ) )
+					{
+						pxTCB->pxTaskCode = pxTCB->pxFallbackCode;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					#if ( configUSE_EDF_SRP == 1 )
+					{
+						pxTCB->xJobStarted = pdFALSE;
+					}
+					#endif
+
+					prvAddCurrentTaskToDelayedList( xNextRelease - xTimeNow, pdFALSE );
+					xSwitchRequired = pdTRUE;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			return xSwitchRequired;
+		}
+		/*-----------------------------------------------------------*/
+
+		static void prvRestartJob( TCB_t *pxTCB )
+		{
+			pxTCB->xRestartPending = pdFALSE;
+
+			/* Release whatever the port holds for the old context, as when a
+			task is deleted, then build a new context as prvInitialiseNewTask()
+			does. */
+			portCLEAN_UP_TCB( pxTCB );
+
+			#if( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+			{
+				#if( portSTACK_GROWTH < 0 )
+				{
+					pxTCB->pxTopOfStack = pxPortInitialiseStack( pxTCB->pxInitialTopOfStack, pxTCB->pxStack, pxTCB->pxTaskCode, pxTCB->pvParameters );
+				}
+				#else /* portSTACK_GROWTH */
+				{
+					pxTCB->pxTopOfStack = pxPortInitialiseStack( pxTCB->pxInitialTopOfStack, pxTCB->pxEndOfStack, pxTCB->pxTaskCode, pxTCB->pvParameters );
+				}
+				#endif /* portSTACK_GROWTH */
+			}
+			#else /* portHAS_STACK_OVERFLOW_CHECKING */
+			{
+				pxTCB->pxTopOfStack = pxPortInitialiseStack( pxTCB->pxInitialTopOfStack, pxTCB->pxTaskCode, pxTCB->pvParameters );
+			}
+			#endif /* portHAS_STACK_OVERFLOW_CHECKING */
+		}
+
+	#endif /* configUSE_EDF_OVERRUN_POLICY */
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvCalculateUtilisation( TickType_t xWCET, TickType_t xPeriod )
+	{
+	uint32_t ulUtilisation;
+
+		/* Keep xWCET below 2^16 so the fixed point product fits in 32 bits.
+		The WCET is rounded up and the period rounded down so the result is
+		never smaller than the real utilisation. */
+		while( xWCET > ( TickType_t ) 0xFFFFU )
+		{
+			xWCET = ( xWCET >> 1 ) + ( xWCET & ( TickType_t ) 1U );
+			xPeriod >>= 1;
+		}
+
+		if( xPeriod == ( TickType_t ) 0U )
+		{
+			/* The WCET is far longer than the period. */
+			ulUtilisation = 0xFFFFFFFFUL;
+		}
+		else
+		{
+			ulUtilisation = ( ( ( uint32_t ) xWCET * taskEDF_UTILISATION_ONE ) + ( ( uint32_t ) xPeriod - 1UL ) ) / ( uint32_t ) xPeriod;
+		}
+
+		return ulUtilisation;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvAdmitPeriodicTask( TCB_t *pxNewTCB )
+	{
+	const uint32_t ulBound = taskEDF_UTILISATION_BOUND;
+	const uint32_t ulUtilisation = pxNewTCB->ulUtilisation;
+	BaseType_t xReturn;
+
+		/* Utilisation test.  Written so the sum cannot overflow.  It is exact
+		when every deadline equals the period. */
+		if( ( ulUtilisation <= ulBound ) && ( ulTotalUtilisation <= ( ulBound - ulUtilisation ) ) )
+		{
+			/* Add the task to the set, then check the whole set if any
+			deadline is shorter than its period. */
+			prvInsertPeriodicTask( pxNewTCB );
+
+			if( taskEDF_DEMAND_TEST_NEEDED() != pdFALSE )
+			{
+				xReturn = prvProcessorDemandTest();
+
+				if( xReturn == pdFAIL )
+				{
+					prvRemovePeriodicTask( pxNewTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				xReturn = pdPASS;
+			}
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvInsertPeriodicTask( TCB_t *pxTCB )
+	{
+		pxTCB->pxNextPeriodicTCB = pxPeriodicTasks;
+		pxPeriodicTasks = pxTCB;
+		ulTotalUtilisation += pxTCB->ulUtilisation;
+
+		if( taskEDF_ADMITTED_DEADLINE( pxTCB ) < taskEDF_ADMITTED_PERIOD( pxTCB ) )
+		{
+			uxConstrainedDeadlineTasks++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRemovePeriodicTask( TCB_t *pxTCB )
+	{
+	TCB_t **ppxLink = &pxPeriodicTasks;
+
+		/* Deleting a task is rare, so a walk of the chain is acceptable. */
+		while( *ppxLink != NULL )
+		{
+			if( *ppxLink == pxTCB )
+			{
+				*ppxLink = pxTCB->pxNextPeriodicTCB;
+				ulTotalUtilisation -= pxTCB->ulUtilisation;
+
+				if( taskEDF_ADMITTED_DEADLINE( pxTCB ) < taskEDF_ADMITTED_PERIOD( pxTCB ) )
+				{
+					uxConstrainedDeadlineTasks--;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				break;
+			}
+
+			ppxLink = &( ( *ppxLink )->pxNextPeriodicTCB );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvChangeTaskTiming( TaskHandle_t const * const pxTasks, TickType_t const * const pxPeriods, TickType_t const * const pxDeadlines, const UBaseType_t uxCount )
+	{
+	const uint32_t ulBound = taskEDF_UTILISATION_BOUND;
+	TCB_t *pxTCB;
+	TickType_t xPeriod, xDeadline, xAdmittedPeriod;
+	UBaseType_t ux;
+	BaseType_t xReturn = pdPASS;
+
+		/* Check every change before any is made.  Only admitted periodic
+		tasks can change, and a task can only have one change pending. */
+		for( ux = ( UBaseType_t ) 0U; ux < uxCount; ux++ )
+		{
+			pxTCB = prvGetTCBFromHandle( pxTasks[ ux ] );
+			xPeriod = pxPeriods[ ux ];
+			xDeadline = ( pxDeadlines != NULL ) ? pxDeadlines[ ux ] : xPeriod;
+			xAdmittedPeriod = ( xPeriod < pxTCB->xTaskPeriod ) ? xPeriod : pxTCB->xTaskPeriod;
+
+			if( ( pxTCB->xTaskPeriod == ( TickType_t ) 0U ) ||
+				( taskEDF_IS_CBS_SERVER( pxTCB ) != pdFALSE ) ||
+				( taskEDF_IS_JOB_SERVER( pxTCB ) != pdFALSE ) ||
+				( pxTCB->xPendingPeriod != ( TickType_t ) 0U ) ||
+				( xDeadline == ( TickType_t ) 0U ) ||
+				( xDeadline > xPeriod ) )
+			{
+				xReturn = pdFAIL;
+				break;
+			}
+			else if( prvCalculateUtilisation( pxTCB->xTaskWCET, xAdmittedPeriod ) > ulBound )
+			{
+				/* Also keeps the sum of the utilisations from overflowing. */
+				xReturn = errTASK_SET_NOT_SCHEDULABLE;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( xReturn == pdPASS )
+		{
+			/* Admit every task with both its current and its new timing. */
+			for( ux = ( UBaseType_t ) 0U; ux < uxCount; ux++ )
+			{
+				pxTCB = prvGetTCBFromHandle( pxTasks[ ux ] );
+				xPeriod = pxPeriods[ ux ];
+				xDeadline = ( pxDeadlines != NULL ) ? pxDeadlines[ ux ] : xPeriod;
+
+				prvRemovePeriodicTask( pxTCB );
+
+				if( ( xPeriod != pxTCB->xTaskPeriod ) || ( xDeadline != pxTCB->xTaskRelativeDeadline ) )
+				{
+					pxTCB->xPendingPeriod = xPeriod;
+					pxTCB->xPendingDeadline = xDeadline;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-	taskENTER_CRITICAL();
-	{
-		/* Minor optimisation.  The tick count cannot change in this block. */
-		const TickType_t xConstTickCount = xTickCount;
-		const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+				pxTCB->ulUtilisation = prvCalculateUtilisation( pxTCB->xTaskWCET, taskEDF_ADMITTED_PERIOD( pxTCB ) );
+				prvInsertPeriodicTask( pxTCB );
+			}
 
-		#if( INCLUDE_xTaskAbortDelay == 1 )
-			if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+			if( ulTotalUtilisation > ulBound )
 			{
-				/* The delay was aborted, which is not the same as a time out,
-				but has the same result. */
-				pxCurrentTCB->ucDelayAborted = pdFALSE;
-				xReturn = pdTRUE;
+				xReturn = errTASK_SET_NOT_SCHEDULABLE;
+			}
+			else if( ( taskEDF_DEMAND_TEST_NEEDED() != pdFALSE ) && ( prvProcessorDemandTest() == pdFAIL ) )
+			{
+				xReturn = errTASK_SET_NOT_SCHEDULABLE;
 			}
 			else
-		#endif
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-		#if ( INCLUDE_vTaskSuspend == 1 )
-			if( *pxTicksToWait == portMAX_DELAY )
+			if( xReturn != pdPASS )
 			{
-				/* If INCLUDE_vTaskSuspend is set to 1 and the block time
-				specified is the maximum block time then the task should block
-				indefinitely, and therefore never time out. */
-				xReturn = pdFALSE;
+				/* Put every task back as it was. */
+				for( ux = ( UBaseType_t ) 0U; ux < uxCount; ux++ )
+				{
+					pxTCB = prvGetTCBFromHandle( pxTasks[ ux ] );
+
+					prvRemovePeriodicTask( pxTCB );
+					pxTCB->xPendingPeriod = ( TickType_t ) 0U;
+					pxTCB->ulUtilisation = prvCalculateUtilisation( pxTCB->xTaskWCET, pxTCB->xTaskPeriod );
+					prvInsertPeriodicTask( pxTCB );
+				}
 			}
 			else
-		#endif
-
-		if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
-		{
-			/* The tick count is greater than the time at which
-			vTaskSetTimeout() was called, but has also overflowed since
-			vTaskSetTimeOut() was called.  It must have wrapped all the way
-			around and gone past again. This passed since vTaskSetTimeout()
-			was called. */
-			xReturn = pdTRUE;
-		}
-		else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
-		{
-			/* Not a genuine timeout. Adjust parameters for time remaining. */
-			*pxTicksToWait -= xElapsedTime;
-			vTaskInternalSetTimeOutState( pxTimeOut );
-			xReturn = pdFALSE;
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
-			*pxTicksToWait = 0;
-			xReturn = pdTRUE;
+			mtCOVERAGE_TEST_MARKER();
 		}
+
+		return xReturn;
 	}
-	taskEXIT_CRITICAL();
+	/*-----------------------------------------------------------*/
 
-	return xReturn;
-}
-/*-----------------------------------------------------------*/
+	static void prvApplyPendingTiming( TCB_t *pxTCB )
+	{
+		/* The new timing needs no more than was admitted for the change, so
+		the set stays schedulable without running the test again. */
+		prvRemovePeriodicTask( pxTCB );
 
-void vTaskMissedYield( void )
-{
-	xYieldPending = pdTRUE;
-}
-/*-----------------------------------------------------------*/
+		pxTCB->xTaskPeriod = pxTCB->xPendingPeriod;
+		pxTCB->xTaskRelativeDeadline = pxTCB->xPendingDeadline;
+		pxTCB->xPendingPeriod = ( TickType_t ) 0U;
+		pxTCB->ulUtilisation = prvCalculateUtilisation( pxTCB->xTaskWCET, pxTCB->xTaskPeriod );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+		prvInsertPeriodicTask( pxTCB );
+	}
+	/*-----------------------------------------------------------*/
 
-	UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+	static TickType_t prvProcessorDemand( const TickType_t xTime )
 	{
-	UBaseType_t uxReturn;
-	TCB_t const *pxTCB;
+	TCB_t *pxTCB;
+	TickType_t xDemand = ( TickType_t ) 0U, xJobDemand;
 
-		if( xTask != NULL )
+		for( pxTCB = pxPeriodicTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextPeriodicTCB )
 		{
-			pxTCB = xTask;
-			uxReturn = pxTCB->uxTaskNumber;
+			if( ( pxTCB->xTaskWCET != ( TickType_t ) 0U ) && ( taskEDF_ADMITTED_DEADLINE( pxTCB ) <= xTime ) )
+			{
+				/* Jobs of this task released at 0, T, 2T... with a deadline
+				no later than xTime. */
+				xJobDemand = ( ( ( xTime - taskEDF_ADMITTED_DEADLINE( pxTCB ) ) / taskEDF_ADMITTED_PERIOD( pxTCB ) ) + ( TickType_t ) 1U ) * pxTCB->xTaskWCET;
+				xDemand += xJobDemand;
+
+				/* Only the comparison with xTime matters, so stop before the
+				sum can overflow. */
+				if( ( xJobDemand > xTime ) || ( xDemand > xTime ) )
+				{
+					xDemand = xTime + ( TickType_t ) 1U;
+					break;
+				}
+			}
 		}
-		else
+
+		#if ( configUSE_EDF_JOBS == 1 )
 		{
-			uxReturn = 0U;
+			Job_t *pxJob;
+
+			for( pxJob = pxPeriodicJobs; ( pxJob != NULL ) && ( xDemand <= xTime ); pxJob = pxJob->pxNextJob )
+			{
+				if( ( pxJob->xWCET != ( TickType_t ) 0U ) && ( pxJob->xRelativeDeadline <= xTime ) )
+				{
+					xJobDemand = ( ( ( xTime - pxJob->xRelativeDeadline ) / pxJob->xPeriod ) + ( TickType_t ) 1U ) * pxJob->xWCET;
+					xDemand += xJobDemand;
+
+					if( ( xJobDemand > xTime ) || ( xDemand > xTime ) )
+					{
+						xDemand = xTime + ( TickType_t ) 1U;
+					}
+				}
+			}
 		}
+		#endif /* configUSE_EDF_JOBS */
 
-		return uxReturn;
+		return xDemand;
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+	static TickType_t prvLatestDeadlineBefore( const TickType_t xTime )
+	{
+	TCB_t *pxTCB;
+	TickType_t xLatest = ( TickType_t ) 0U, xDeadline;
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+		for( pxTCB = pxPeriodicTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextPeriodicTCB )
+		{
+			if( ( pxTCB->xTaskWCET != ( TickType_t ) 0U ) && ( taskEDF_ADMITTED_DEADLINE( pxTCB ) < xTime ) )
+			{
+				xDeadline = taskEDF_ADMITTED_DEADLINE( pxTCB ) + ( ( ( xTime - taskEDF_ADMITTED_DEADLINE( pxTCB ) - ( TickType_t ) 1U ) / taskEDF_ADMITTED_PERIOD( pxTCB ) ) * taskEDF_ADMITTED_PERIOD( pxTCB ) );
 
-	void vTaskSetTaskNumber( TaskHandle_t xTask, const UBaseType_t uxHandle )
-	{
-	TCB_t * pxTCB;
+				if( xDeadline > xLatest )
+				{
+					xLatest = xDeadline;
+				}
+			}
+		}
 
-		if( xTask != NULL )
+		#if ( configUSE_EDF_JOBS == 1 )
 		{
-			pxTCB = xTask;
-			pxTCB->uxTaskNumber = uxHandle;
+			Job_t *pxJob;
+
+			for( pxJob = pxPeriodicJobs; pxJob != NULL; pxJob = pxJob->pxNextJob )
+			{
+				if( ( pxJob->xWCET != ( TickType_t ) 0U ) && ( pxJob->xRelativeDeadline < xTime ) )
+				{
+					xDeadline = pxJob->xRelativeDeadline + ( ( ( xTime - pxJob->xRelativeDeadline - ( TickType_t ) 1U ) / pxJob->xPeriod ) * pxJob->xPeriod );
+
+					if( xDeadline > xLatest )
+					{
+						xLatest = xDeadline;
+					}
+				}
+			}
 		}
+		#endif /* configUSE_EDF_JOBS */
+
+		return xLatest;
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
+	static BaseType_t prvProcessorDemandTest( void )
+	{
+	TCB_t *pxTCB;
+	#if ( configUSE_EDF_JOBS == 1 )
+		Job_t *pxJob;
+	#endif
+	TickType_t xBusyPeriod = ( TickType_t ) 0U, xNextBusyPeriod, xTime, xDemand, xMinDeadline = portMAX_DELAY;
+	BaseType_t xReturn;
 
-/*
- * -----------------------------------------------------------
- * The Idle task.
- * ----------------------------------------------------------
- *
- * The portTASK_FUNCTION() macro is used to allow port/compiler specific
- * language extensions.  The equivalent prototype for this function is:
- *
- * void prvIdleTask( void *pvParameters );
- *
- */
-static portTASK_FUNCTION( prvIdleTask, pvParameters )
-{
-	/* Stop warnings. */
-	( void ) pvParameters;
+		/* The synchronous busy period bounds the interval that has to be
+		checked.  It is the first point at which all the work released so far
+		has completed.  The utilisation test has already passed so this
+		converges, the limit only guards against a set whose hyperperiod does
+		not fit in a TickType_t. */
+		for( pxTCB = pxPeriodicTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextPeriodicTCB )
+		{
+			xBusyPeriod += pxTCB->xTaskWCET;
 
-	/** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
-	SCHEDULER IS STARTED. **/
+			if( ( pxTCB->xTaskWCET != ( TickType_t ) 0U ) && ( taskEDF_ADMITTED_DEADLINE( pxTCB ) < xMinDeadline ) )
+			{
+				xMinDeadline = taskEDF_ADMITTED_DEADLINE( pxTCB );
+			}
+		}
 
-	/* In case a task that has a secure context deletes itself, in which case
-	the idle task is responsible for deleting the task's secure context, if
-	any. */
-	
-	portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
-	for( ;; )
-	{
-		/* See if any tasks have deleted themselves - if so then the idle task
-		is responsible for freeing the deleted task's TCB and stack. */
-		prvCheckTasksWaitingTermination();
+		#if ( configUSE_EDF_JOBS == 1 )
+		{
+			for( pxJob = pxPeriodicJobs; pxJob != NULL; pxJob = pxJob->pxNextJob )
+			{
+				xBusyPeriod += pxJob->xWCET;
 
-		
-		#if ( configUSE_PREEMPTION == 0 )
+				if( ( pxJob->xWCET != ( TickType_t ) 0U ) && ( pxJob->xRelativeDeadline < xMinDeadline ) )
+				{
+					xMinDeadline = pxJob->xRelativeDeadline;
+				}
+			}
+		}
+		#endif /* configUSE_EDF_JOBS */
+
+		for( ;; )
 		{
-			/* If we are not using preemption we keep forcing a task switch to
-			see if any other task has become available.  If we are using
-			preemption we don't need to do this as any task becoming available
-			will automatically get the processor anyway. */
-			taskYIELD();
+			xNextBusyPeriod = ( TickType_t ) 0U;
+
+			for( pxTCB = pxPeriodicTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextPeriodicTCB )
+			{
+				xNextBusyPeriod += ( ( xBusyPeriod + taskEDF_ADMITTED_PERIOD( pxTCB ) - ( TickType_t ) 1U ) / taskEDF_ADMITTED_PERIOD( pxTCB ) ) * pxTCB->xTaskWCET;
+			}
+
+			#if ( configUSE_EDF_JOBS == 1 )
+			{
+				for( pxJob = pxPeriodicJobs; pxJob != NULL; pxJob = pxJob->pxNextJob )
+				{
+					xNextBusyPeriod += ( ( xBusyPeriod + pxJob->xPeriod - ( TickType_t ) 1U ) / pxJob->xPeriod ) * pxJob->xWCET;
+				}
+			}
+			#endif /* configUSE_EDF_JOBS */
+
+			if( ( xNextBusyPeriod == xBusyPeriod ) || ( xNextBusyPeriod > ( portMAX_DELAY >> 1 ) ) )
+			{
+				break;
+			}
+
+			xBusyPeriod = xNextBusyPeriod;
 		}
-		#endif /* configUSE_PREEMPTION */
 
-		#if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+		if( xNextBusyPeriod != xBusyPeriod )
 		{
-			/* When using preemption tasks of equal priority will be
-			timesliced.  If a task that is sharing the idle priority is ready
-			to run then the idle task should yield before the end of the
-			timeslice.
+			/* Could not bound the interval, so cannot admit the task. */
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			/* Walk backwards through the absolute deadlines, jumping straight
+			to h( t ) whenever it is less than t. */
+			xTime = prvLatestDeadlineBefore( xBusyPeriod );
+			xDemand = prvProcessorDemand( xTime );
 
-			A critical region is not required here as we are just reading from
-			the list, and an occasional incorrect value will not matter.  If
-			the ready list at the idle priority contains more than one task
-			then a task other than the idle task is ready to execute. */
-			#if (configUSE_EDF_SCHEDULER == 0)
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			while( ( xDemand <= xTime ) && ( xDemand > xMinDeadline ) )
 			{
-				taskYIELD();
+				if( xDemand < xTime )
+				{
+					xTime = xDemand;
+				}
+				else
+				{
+					xTime = prvLatestDeadlineBefore( xTime );
+				}
+
+				xDemand = prvProcessorDemand( xTime );
+			}
+
+			if( xDemand <= xMinDeadline )
+			{
+				xReturn = pdPASS;
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				xReturn = pdFAIL;
 			}
-			#else
-			/* edit here */
-			/* Update the Idle task deadline */
-			/* Check if there is any task otherthan the Idle task in the ready list, if so call taskYield */
-			listSET_LIST_ITEM_VALUE(&((pxCurrentTCB)->xStateListItem), (pxCurrentTCB)->xTaskPeriod + xTaskGetTickCount());
-			if( listCURRENT_LIST_LENGTH( &( xReadyTasksListEDF) ) > ( UBaseType_t ) 1 )
+		}
+
+		#if ( configUSE_EDF_JOBS == 1 )
+		{
+			if( ( xReturn == pdPASS ) && ( uxPeriodicJobs > ( UBaseType_t ) 1U ) )
 			{
-				taskYIELD();
+				xReturn = prvJobBlockingTest();
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
-			#endif
 		}
-		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+		#endif /* configUSE_EDF_JOBS */
 
-		#if ( configUSE_IDLE_HOOK == 1 )
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( configUSE_EDF_JOBS == 1 )
+
+		static BaseType_t prvJobBlockingTest( void )
 		{
-			extern void vApplicationIdleHook( void );
+		Job_t *pxJob, *pxBlocked;
+		TickType_t xLongestDeadline = ( TickType_t ) 0U, xTime, xBlocking;
+		BaseType_t xReturn = pdPASS;
 
-			/* Call the user defined function from within the idle task.  This
-			allows the application designer to add background functionality
-			without the overhead of a separate task.
-			NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
-			CALL A FUNCTION THAT MIGHT BLOCK. */
-			vApplicationIdleHook();
+			/* A job that has started delays every job of its server released
+			after it, even one with an earlier deadline, by up to its WCET.  So
+			at an absolute deadline t the demand plus the longest WCET of a job
+			with a deadline after t must still fit in t, if that job shares a
+			server with a job whose deadline is t or less.  Jobs of a server for
+			one preemption level all have the same deadline, so never delay
+			each other this way.  With that delay added the demand no longer
+			grows with t, which the walk in prvProcessorDemandTest() relies on,
+			so every deadline before the longest job deadline is checked in
+			turn. */
+			for( pxJob = pxPeriodicJobs; pxJob != NULL; pxJob = pxJob->pxNextJob )
+			{
+				if( ( pxJob->xWCET != ( TickType_t ) 0U ) && ( pxJob->xRelativeDeadline > xLongestDeadline ) )
+				{
+					xLongestDeadline = pxJob->xRelativeDeadline;
+				}
+			}
+
+			for( xTime = prvLatestDeadlineBefore( xLongestDeadline ); xTime != ( TickType_t ) 0U; xTime = prvLatestDeadlineBefore( xTime ) )
+			{
+				xBlocking = ( TickType_t ) 0U;
+
+				for( pxJob = pxPeriodicJobs; pxJob != NULL; pxJob = pxJob->pxNextJob )
+				{
+					if( ( pxJob->xRelativeDeadline > xTime ) && ( pxJob->xWCET > xBlocking ) )
+					{
+						for( pxBlocked = pxPeriodicJobs; pxBlocked != NULL; pxBlocked = pxBlocked->pxNextJob )
+						{
+							if( ( pxBlocked->pxServer == pxJob->pxServer ) && ( pxBlocked->xRelativeDeadline <= xTime ) )
+							{
+								xBlocking = pxJob->xWCET;
+								break;
+							}
+						}
+					}
+				}
+
+				/* prvProcessorDemand() returns at most xTime + 1. */
+				if( ( xBlocking > xTime ) || ( prvProcessorDemand( xTime ) > ( xTime - xBlocking ) ) )
+				{
+					xReturn = pdFAIL;
+					break;
+				}
+			}
+
+			return xReturn;
 		}
-		#endif /* configUSE_IDLE_HOOK */
 
-		/* This conditional compilation should use inequality to 0, not equality
-		to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
-		user defined low power mode	implementations require
-		configUSE_TICKLESS_IDLE to be set to a value other than 1. */
-		#if ( configUSE_TICKLESS_IDLE != 0 )
-		{
-		TickType_t xExpectedIdleTime;
+	#endif /* configUSE_EDF_JOBS */
 
-			/* It is not desirable to suspend then resume the scheduler on
-			each iteration of the idle task.  Therefore, a preliminary
-			test of the expected idle time is performed without the
-			scheduler suspended.  The result here is not necessarily
-			valid. */
-			xExpectedIdleTime = prvGetExpectedIdleTime();
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
 
-			if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+#if ( configUSE_EDF_CBS == 1 )
+
+	static portTASK_FUNCTION( prvCbsServerTask, pvParameters )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+	CbsJob_t xJob;
+	BaseType_t xHaveJob;
+
+		/* Stop warnings. */
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
 			{
-				vTaskSuspendAll();
+				if( pxTCB->uxCbsWaiting != ( UBaseType_t ) 0U )
 				{
-					/* Now the scheduler is suspended, the expected idle
-					time can be sampled again, and this time its value can
-					be used. */
-					configASSERT( xNextTaskUnblockTime >= xTickCount );
-					xExpectedIdleTime = prvGetExpectedIdleTime();
-
-					/* Define the following macro to set xExpectedIdleTime to 0
-					if the application does not want
-					portSUPPRESS_TICKS_AND_SLEEP() to be called. */
-					configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+					xJob = pxTCB->pxCbsJobs[ pxTCB->uxCbsHead ];
+					( pxTCB->uxCbsHead )++;
 
-					if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+					if( pxTCB->uxCbsHead == pxTCB->uxCbsLength )
 					{
-						traceLOW_POWER_IDLE_BEGIN();
-						portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
-						traceLOW_POWER_IDLE_END();
+						pxTCB->uxCbsHead = ( UBaseType_t ) 0U;
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
+
+					( pxTCB->uxCbsWaiting )--;
+					xHaveJob = pdTRUE;
 				}
-				( void ) xTaskResumeAll();
+				else
+				{
+					xHaveJob = pdFALSE;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xHaveJob != pdFALSE )
+			{
+				/* The job runs on the budget and deadline of the server. */
+				xJob.pxJobCode( xJob.pvParameters );
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				/* Every job that is queued also gives the notification, so a
+				job queued since the check above is not missed. */
+				( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
 			}
 		}
-		#endif /* configUSE_TICKLESS_IDLE */
 	}
-}
-/*-----------------------------------------------------------*/
+	/*-----------------------------------------------------------*/
 
-#if( configUSE_TICKLESS_IDLE != 0 )
+	static void prvInitialiseCbsServer( TCB_t *pxTCB, CbsJob_t *pxJobs, UBaseType_t uxQueueLength )
+	{
+		/* The server was admitted as a periodic task with its budget as its
+		WCET and its server period as an implicit deadline, which reserves the
+		bandwidth Q / P for it. */
+		pxTCB->pxCbsJobs = pxJobs;
+		pxTCB->uxCbsLength = uxQueueLength;
+		pxTCB->uxCbsHead = ( UBaseType_t ) 0U;
+		pxTCB->uxCbsWaiting = ( UBaseType_t ) 0U;
+	}
+	/*-----------------------------------------------------------*/
 
-	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+	static BaseType_t prvCbsQueueJob( TCB_t *pxTCB, TaskFunction_t pxJobCode, void *pvParameters )
 	{
-	/* The idle task exists in addition to the application tasks. */
-	const UBaseType_t uxNonApplicationTasks = 1;
-	eSleepModeStatus eReturn = eStandardSleep;
+	const TickType_t xTimeNow = xTickCount;
+	TickType_t xTimeLeft, xBudgetLeft;
+	UBaseType_t uxTail;
+	BaseType_t xReturn;
 
-		/* This function must be called from a critical section. */
+		configASSERT( pxTCB->pxCbsJobs != NULL );
 
-		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
-		{
-			/* A task was made ready while the scheduler was suspended. */
-			eReturn = eAbortSleep;
-		}
-		else if( xYieldPending != pdFALSE )
-		{
-			/* A yield was pended while the scheduler was suspended. */
-			eReturn = eAbortSleep;
-		}
-		else
+		if( pxTCB->uxCbsWaiting < pxTCB->uxCbsLength )
 		{
-			/* If all the tasks are in the suspended list (which might mean they
-			have an infinite block time rather than actually being suspended)
-			then it is safe to turn all clocks off and just wait for external
-			interrupts. */
-			if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+			/* A job that arrives while the server is idle, with no job queued
+			and not in the Ready state, may start a new server period.  The
+			current deadline is kept only if the budget left would not use more
+			than the server bandwidth before it, otherwise the server gets a
+			full budget and the deadline now + P.  A deadline that has passed
+			makes the subtraction wrap to above half the tick range. */
+			if( ( pxTCB->uxCbsWaiting == ( UBaseType_t ) 0U ) &&
+				( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( pxTCB->xStateListItem ) ) == pdFALSE ) )
 			{
-				eReturn = eNoTasksWaitingTimeout;
+				xTimeLeft = taskEDF_ABSOLUTE_DEADLINE( pxTCB ) - xTimeNow;
+				xBudgetLeft = ( TickType_t ) ( ( pxTCB->ulBudget - pxTCB->ulBudgetUsed ) / ( uint32_t ) configEDF_RUN_TIME_COUNTS_PER_TICK );
+
+				if( ( xTimeLeft == ( TickType_t ) 0U ) ||
+					( xTimeLeft > ( portMAX_DELAY >> 1 ) ) ||
+					( ( xBudgetLeft * pxTCB->xTaskPeriod ) >= ( xTimeLeft * pxTCB->xTaskWCET ) ) )
+				{
+					pxTCB->xTaskReleaseTime = xTimeNow;
+					pxTCB->ulBudgetUsed = 0UL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
-		}
-
-		return eReturn;
-	}
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*-----------------------------------------------------------*/
+			uxTail = pxTCB->uxCbsHead + pxTCB->uxCbsWaiting;
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+			if( uxTail >= pxTCB->uxCbsLength )
+			{
+				uxTail -= pxTCB->uxCbsLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-	void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue )
-	{
-	TCB_t *pxTCB;
+			pxTCB->pxCbsJobs[ uxTail ].pxJobCode = pxJobCode;
+			pxTCB->pxCbsJobs[ uxTail ].pvParameters = pvParameters;
+			( pxTCB->uxCbsWaiting )++;
 
-		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+			xReturn = pdPASS;
+		}
+		else
 		{
-			pxTCB = prvGetTCBFromHandle( xTaskToSet );
-			configASSERT( pxTCB != NULL );
-			pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+			xReturn = errQUEUE_FULL;
 		}
+
+		return xReturn;
 	}
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+#endif /* configUSE_EDF_CBS */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+#if ( configUSE_EDF_SPORADIC == 1 )
 
-	void *pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery, BaseType_t xIndex )
+	static BaseType_t prvSporadicRelease( TCB_t *pxTCB, BaseType_t * const pxYieldRequired )
 	{
-	void *pvReturn = NULL;
-	TCB_t *pxTCB;
+	const TickType_t xTimeNow = xTickCount;
+	TickType_t xRelease = xTimeNow, xTicksToEarliest;
+	BaseType_t xReturn = pdPASS;
 
-		if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+		configASSERT( pxTCB->uxSporadicState != taskSPORADIC_NONE );
+
+		*pxYieldRequired = pdFALSE;
+
+		if( pxTCB->uxSporadicState == taskSPORADIC_PENDING )
 		{
-			pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-			pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+			/* The next job is already waiting for the current one. */
+			( pxTCB->uxDroppedReleases )++;
+			xReturn = pdFAIL;
 		}
 		else
 		{
-			pvReturn = NULL;
-		}
-
-		return pvReturn;
-	}
+			/* xTaskReleaseTime holds the release of the current or the last
+			job, which is up to one inter-arrival time ahead of now if that job
+			was deferred itself.  The earliest the next job can be released is
+			then up to two inter-arrival times ahead.  Once that time has
+			passed the subtraction is 0 or wraps. */
+			xTicksToEarliest = ( pxTCB->xTaskReleaseTime + pxTCB->xTaskPeriod ) - xTimeNow;
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
-/*-----------------------------------------------------------*/
+			if( ( xTicksToEarliest != ( TickType_t ) 0U ) && ( xTicksToEarliest <= ( pxTCB->xTaskPeriod << 1 ) ) )
+			{
+				xRelease = pxTCB->xTaskReleaseTime + pxTCB->xTaskPeriod;
+				( pxTCB->uxEarlyReleases )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
+			if( pxTCB->uxSporadicState == taskSPORADIC_WAITING )
+			{
+				/* The delayed lists cannot be used from an interrupt, so a
+				deferred job is made ready all the same and vTaskSporadicWait()
+				delays the task until its release. */
+				pxTCB->xTaskReleaseTime = xRelease;
+				pxTCB->uxSporadicState = taskSPORADIC_RUNNING;
 
-	void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify, const MemoryRegion_t * const xRegions )
-	{
-	TCB_t *pxTCB;
+				if( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+				{
+					/* The task was resumed while it waited.  It is given the
+					deadline of the job when it next runs vTaskSporadicWait(). */
+					mtCOVERAGE_TEST_MARKER();
+				}
+				else if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxTCB );
+				}
+				else
+				{
+					/* The delayed or ready lists cannot be accessed so the task
+					is held in the pending ready list until the scheduler is
+					unsuspended. */
+					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
 
-		/* If null is passed in here then we are modifying the MPU settings of
-		the calling task. */
-		pxTCB = prvGetTCBFromHandle( xTaskToModify );
+				if( taskUNBLOCKED_TASK_PREEMPTS( pxTCB ) != pdFALSE )
+				{
+					*pxYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The current job has not completed, the next job is released
+				when it does. */
+				pxTCB->xPendingRelease = xRelease;
+				pxTCB->uxSporadicState = taskSPORADIC_PENDING;
+			}
+		}
 
-		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+		return xReturn;
 	}
 
-#endif /* portUSING_MPU_WRAPPERS */
+#endif /* configUSE_EDF_SPORADIC */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseTaskLists( void )
-{
-UBaseType_t uxPriority;
+#if ( configUSE_EDF_JOBS == 1 )
 
-	for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+	static portTASK_FUNCTION( prvJobServerTask, pvParameters )
 	{
-		#if(configUSE_EDF_SCHEDULER == 0)
-		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
-		#endif
-	}
-	
-	/* 
-	6
-	edit 1 1.2 
-	initialize all the ready tasks in the new readyList in the beginning 
-	*/
-	#if ( configUSE_EDF_SCHEDULER == 1 )
-	{
-		vListInitialise( &xReadyTasksListEDF );
-	}
-	#endif
+	TCB_t * const pxTCB = pxCurrentTCB;
+	JobServer_t * const pxServer = ( JobServer_t * ) pvParameters;
+	Job_t *pxJob;
+	TickType_t xTicksToRelease;
+	BaseType_t xAlreadyYielded;
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
-	vListInitialise( &xPendingReadyList );
+		for( ;; )
+		{
+			pxJob = NULL;
 
-	#if ( INCLUDE_vTaskDelete == 1 )
-	{
-		vListInitialise( &xTasksWaitingTermination );
-	}
-	#endif /* INCLUDE_vTaskDelete */
+			vTaskSuspendAll();
+			{
+				/* Jobs are released from the tick interrupt, so the lists are
+				read and the server blocked with interrupts masked, otherwise a
+				release in between would be lost. */
+				taskENTER_CRITICAL();
+				{
+					pxServer->xWaiting = pdFALSE;
 
-	#if ( INCLUDE_vTaskSuspend == 1 )
-	{
-		vListInitialise( &xSuspendedTaskList );
-	}
-	#endif /* INCLUDE_vTaskSuspend */
+					if( listLIST_IS_EMPTY( &( pxServer->xReadyJobsList ) ) == pdFALSE )
+					{
+						pxJob = ( Job_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxServer->xReadyJobsList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+						( void ) uxListRemove( &( pxJob->xJobListItem ) );
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
-}
-/*-----------------------------------------------------------*/
+						/* The server runs the job with the job's deadline and
+						is charged against the job's WCET. */
+						pxTCB->xTaskReleaseTime = pxJob->xReleaseTime;
+						pxTCB->xTaskRelativeDeadline = pxJob->xRelativeDeadline;
 
-static void prvCheckTasksWaitingTermination( void )
-{
+						#if ( configUSE_EDF_BUDGETS == 1 )
+						{
+							prvRefillBudget();
+							pxTCB->ulBudget = ( uint32_t ) pxJob->xWCET * ( uint32_t ) configEDF_RUN_TIME_COUNTS_PER_TICK;
+						}
+						#endif
 
-	/** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+						prvReadyHeapRemove( pxTCB );
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), taskEDF_READY_DEADLINE( pxTCB ) );
+						prvReadyHeapInsert( pxTCB );
+					}
+					else
+					{
+						/* Wait for the next release, which the tick wakes the
+						server for before the timeout can.  With no job at all
+						the server waits indefinitely. */
+						if( listLIST_IS_EMPTY( &( pxServer->xPendingJobsList ) ) == pdFALSE )
+						{
+							xTicksToRelease = pxServer->xNextRelease - xTickCount;
+						}
+						else
+						{
+							xTicksToRelease = portMAX_DELAY;
+						}
 
-	#if ( INCLUDE_vTaskDelete == 1 )
-	{
-		TCB_t *pxTCB;
+						pxServer->xWaiting = pdTRUE;
+						prvAddCurrentTaskToDelayedList( xTicksToRelease, pdTRUE );
 
-		/* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
-		being called too often in the idle task. */
-		while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
-		{
-			taskENTER_CRITICAL();
+						#if ( configUSE_EDF_SRP == 1 )
+						{
+							/* The next job has to pass the preemption test
+							before it can start. */
+							pxTCB->xJobStarted = pdFALSE;
+						}
+						#endif
+					}
+				}
+				taskEXIT_CRITICAL();
+			}
+			xAlreadyYielded = xTaskResumeAll();
+
+			/* Force a reschedule if xTaskResumeAll has not already done so,
+			the server may have blocked or have a later deadline. */
+			if( xAlreadyYielded == pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxJob != NULL )
+			{
+				pxJob->pxJobCode( pxJob->pvParameters );
+
+				taskENTER_CRITICAL();
+				{
+					/* The server may have taken the earlier deadline of a job
+					released while this one ran, so the job is checked against
+					its own deadline. */
+					pxTCB->xTaskReleaseTime = pxJob->xReleaseTime;
+					pxTCB->xTaskRelativeDeadline = pxJob->xRelativeDeadline;
+					prvCheckForDeadlineMiss( pxTCB, xTickCount );
+
+					/* The release time is what the next job is anchored to,
+					so a late completion does not make releases drift. */
+					pxJob->xReleaseTime += pxJob->xPeriod;
+					( void ) prvQueueJob( pxJob );
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
 			{
-				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				--uxCurrentNumberOfTasks;
-				--uxDeletedTasksWaitingCleanUp;
+				mtCOVERAGE_TEST_MARKER();
 			}
-			taskEXIT_CRITICAL();
-
-			prvDeleteTCB( pxTCB );
 		}
 	}
-	#endif /* INCLUDE_vTaskDelete */
-}
-/*-----------------------------------------------------------*/
-
-#if( configUSE_TRACE_FACILITY == 1 )
+	/*-----------------------------------------------------------*/
 
-	void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState )
+	static BaseType_t prvInitialiseJob( Job_t *pxNewJob, TaskFunction_t pxJobCode, void * const pvParameters, TickType_t xPeriod, TickType_t xRelativeDeadline, TickType_t xWCET )
 	{
-	TCB_t *pxTCB;
-
-		/* xTask is NULL then get the state of the calling task. */
-		pxTCB = prvGetTCBFromHandle( xTask );
+	JobServer_t *pxServer = NULL;
+	BaseType_t xReturn, xYieldRequired = pdFALSE;
 
-		pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
-		pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName [ 0 ] );
-		pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
-		pxTaskStatus->pxStackBase = pxTCB->pxStack;
-		pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+		configASSERT( pxJobCode );
 
-		#if ( configUSE_MUTEXES == 1 )
+		/* A job runs on the server for its preemption level if there is one,
+		otherwise on the server for every other level. */
+		if( xRelativeDeadline != ( TickType_t ) 0U )
 		{
-			pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+			pxServer = prvFindJobServer( xRelativeDeadline );
+
+			if( pxServer == NULL )
+			{
+				pxServer = prvFindJobServer( ( TickType_t ) 0U );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-		#else
+		else
 		{
-			pxTaskStatus->uxBasePriority = 0;
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif
 
-		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		/* Jobs need a server to run them.  Only constrained deadlines are
+		supported, a job must complete before the next one is released. */
+		if( ( pxServer == NULL ) || ( xRelativeDeadline > xPeriod ) )
 		{
-			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+			xReturn = pdFAIL;
 		}
-		#else
+		else
 		{
-			pxTaskStatus->ulRunTimeCounter = 0;
-		}
-		#endif
+			pxNewJob->pxServer = pxServer;
+			pxNewJob->pxJobCode = pxJobCode;
+			pxNewJob->pvParameters = pvParameters;
+			pxNewJob->xPeriod = xPeriod;
+			pxNewJob->xRelativeDeadline = xRelativeDeadline;
+			pxNewJob->xWCET = xWCET;
+			vListInitialiseItem( &( pxNewJob->xJobListItem ) );
+			listSET_LIST_ITEM_OWNER( &( pxNewJob->xJobListItem ), pxNewJob );
 
-		/* Obtaining the task state is a little fiddly, so is only done if the
-		value of eState passed into this function is eInvalid - otherwise the
-		state is just set to whatever is passed in. */
-		if( eState != eInvalid )
-		{
-			if( pxTCB == pxCurrentTCB )
+			vTaskSuspendAll();
 			{
-				pxTaskStatus->eCurrentState = eRunning;
+				xReturn = prvAdmitJob( pxNewJob );
 			}
-			else
+			( void ) xTaskResumeAll();
+
+			if( xReturn == pdPASS )
 			{
-				pxTaskStatus->eCurrentState = eState;
+				taskENTER_CRITICAL();
+				{
+					/* The first job is released now. */
+					pxNewJob->xReleaseTime = xTickCount;
+					xYieldRequired = prvQueueJob( pxNewJob );
+				}
+				taskEXIT_CRITICAL();
 
-				#if ( INCLUDE_vTaskSuspend == 1 )
+				if( ( xYieldRequired != pdFALSE ) && ( xSchedulerRunning != pdFALSE ) )
 				{
-					/* If the task is in the suspended list then there is a
-					chance it is actually just blocked indefinitely - so really
-					it should be reported as being in the Blocked state. */
-					if( eState == eSuspended )
-					{
-						vTaskSuspendAll();
-						{
-							if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-							{
-								pxTaskStatus->eCurrentState = eBlocked;
-							}
-						}
-						( void ) xTaskResumeAll();
-					}
+					taskYIELD_IF_USING_PREEMPTION();
 				}
-				#endif /* INCLUDE_vTaskSuspend */
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				xReturn = errTASK_SET_NOT_SCHEDULABLE;
 			}
 		}
-		else
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvAdmitJob( Job_t *pxNewJob )
+	{
+	const uint32_t ulBound = taskEDF_UTILISATION_BOUND;
+	const uint32_t ulUtilisation = prvCalculateUtilisation( pxNewJob->xWCET, pxNewJob->xPeriod );
+	BaseType_t xReturn;
+
+		/* The same tests as a periodic task, see prvAdmitPeriodicTask().  A
+		job is never deleted, so its utilisation is not kept. */
+		if( pxNewJob->xWCET == ( TickType_t ) 0U )
 		{
-			pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+			/* The execution time is not known, so the job does not take part
+			in the admission test. */
+			pxNewJob->pxNextJob = NULL;
+			xReturn = pdPASS;
 		}
-
-		/* Obtaining the stack space takes some time, so the xGetFreeStackSpace
-		parameter is provided to allow it to be skipped. */
-		if( xGetFreeStackSpace != pdFALSE )
+		else if( ( ulUtilisation <= ulBound ) && ( ulTotalUtilisation <= ( ulBound - ulUtilisation ) ) )
 		{
-			#if ( portSTACK_GROWTH > 0 )
+			pxNewJob->pxNextJob = pxPeriodicJobs;
+			pxPeriodicJobs = pxNewJob;
+			ulTotalUtilisation += ulUtilisation;
+			uxPeriodicJobs++;
+
+			if( pxNewJob->xRelativeDeadline < pxNewJob->xPeriod )
 			{
-				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+				uxConstrainedDeadlineTasks++;
 			}
-			#else
+			else
 			{
-				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+				mtCOVERAGE_TEST_MARKER();
 			}
-			#endif
-		}
-		else
-		{
-			pxTaskStatus->usStackHighWaterMark = 0;
-		}
-	}
-
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
 
-	static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t *pxTaskStatusArray, List_t *pxList, eTaskState eState )
-	{
-	configLIST_VOLATILE TCB_t *pxNextTCB, *pxFirstTCB;
-	UBaseType_t uxTask = 0;
+			if( ( taskEDF_DEMAND_TEST_NEEDED() != pdFALSE ) && ( prvProcessorDemandTest() == pdFAIL ) )
+			{
+				/* The job is still at the head of the chain. */
+				pxPeriodicJobs = pxNewJob->pxNextJob;
+				ulTotalUtilisation -= ulUtilisation;
+				uxPeriodicJobs--;
 
-		if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
-		{
-			listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				if( pxNewJob->xRelativeDeadline < pxNewJob->xPeriod )
+				{
+					uxConstrainedDeadlineTasks--;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-			/* Populate an TaskStatus_t structure within the
-			pxTaskStatusArray array for each task that is referenced from
-			pxList.  See the definition of TaskStatus_t in task.h for the
-			meaning of each TaskStatus_t structure member. */
-			do
+				xReturn = pdFAIL;
+			}
+			else
 			{
-				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-				vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
-				uxTask++;
-			} while( pxNextTCB != pxFirstTCB );
+				xReturn = pdPASS;
+			}
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			xReturn = pdFAIL;
 		}
 
-		return uxTask;
+		return xReturn;
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
-
-	static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+	static BaseType_t prvQueueJob( Job_t *pxJob )
 	{
-	uint32_t ulCount = 0U;
+	JobServer_t * const pxServer = pxJob->pxServer;
+	List_t * const pxPendingJobsList = &( pxServer->xPendingJobsList );
+	const TickType_t xRelease = pxJob->xReleaseTime;
+	ListItem_t *pxListItem;
+	ListItem_t * const pxOldIndex = pxPendingJobsList->pxIndex;
+	BaseType_t xSwitchRequired = pdFALSE;
 
-		while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+		/* Every pending release is less than a period ahead, so releases are
+		ordered by the sign of their difference like deadlines, and nothing
+		has to move when the tick count wraps. */
+		listSET_LIST_ITEM_VALUE( &( pxJob->xJobListItem ), xRelease );
+
+		for( pxListItem = listGET_HEAD_ENTRY( pxPendingJobsList );
+			 pxListItem != listGET_END_MARKER( pxPendingJobsList );
+			 pxListItem = listGET_NEXT( pxListItem ) )
 		{
-			pucStackByte -= portSTACK_GROWTH;
-			ulCount++;
+			if( taskEDF_TIME_BEFORE( xRelease, listGET_LIST_ITEM_VALUE( pxListItem ) ) )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 
-		ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+		/* Insert before the item found, see prvListInsertByDeadline(). */
+		pxPendingJobsList->pxIndex = pxListItem;
+		vListInsertEnd( pxPendingJobsList, &( pxJob->xJobListItem ) );
+		pxPendingJobsList->pxIndex = pxOldIndex;
 
-		return ( configSTACK_DEPTH_TYPE ) ulCount;
-	}
+		pxServer->xNextRelease = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxPendingJobsList );
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
-/*-----------------------------------------------------------*/
+		/* A job created now, or one that completed after its next release,
+		is released straight away rather than a tick late. */
+		if( taskEDF_TIME_BEFORE( xTickCount, pxServer->xNextRelease ) == pdFALSE )
+		{
+			xSwitchRequired = prvReleaseJobs( pxServer, xTickCount );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+		return xSwitchRequired;
+	}
+	/*-----------------------------------------------------------*/
 
-	/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
-	same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
-	user to determine the return type.  It gets around the problem of the value
-	overflowing on 8-bit types without breaking backward compatibility for
-	applications that expect an 8-bit return type. */
-	configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+	static BaseType_t prvReleaseJobs( JobServer_t * const pxServer, const TickType_t xTimeNow )
 	{
-	TCB_t *pxTCB;
-	uint8_t *pucEndOfStack;
-	configSTACK_DEPTH_TYPE uxReturn;
+	TCB_t * const pxTCB = pxServer->pxTCB;
+	Job_t *pxJob;
+	BaseType_t xSwitchRequired = pdFALSE;
 
-		/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
-		the same except for their return type.  Using configSTACK_DEPTH_TYPE
-		allows the user to determine the return type.  It gets around the
-		problem of the value overflowing on 8-bit types without breaking
-		backward compatibility for applications that expect an 8-bit return
-		type. */
+		while( listLIST_IS_EMPTY( &( pxServer->xPendingJobsList ) ) == pdFALSE )
+		{
+			pxJob = ( Job_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxServer->xPendingJobsList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-		pxTCB = prvGetTCBFromHandle( xTask );
+			if( taskEDF_TIME_BEFORE( xTimeNow, pxJob->xReleaseTime ) )
+			{
+				pxServer->xNextRelease = pxJob->xReleaseTime;
+				break;
+			}
 
-		#if portSTACK_GROWTH < 0
-		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+			( void ) uxListRemove( &( pxJob->xJobListItem ) );
+			listSET_LIST_ITEM_VALUE( &( pxJob->xJobListItem ), taskEDF_DEADLINE_KEY( pxJob->xReleaseTime + pxJob->xRelativeDeadline ) );
+			prvListInsertByDeadline( &( pxServer->xReadyJobsList ), &( pxJob->xJobListItem ) );
 		}
-		#else
-		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-		}
-		#endif
-
-		uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
 
-		return uxReturn;
-	}
+		/* The server takes the deadline of the earliest job released.  It
+		either runs that job next or, as the job cannot preempt the one the
+		server is running, finishes that one by the same deadline. */
+		pxJob = ( Job_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxServer->xReadyJobsList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
-/*-----------------------------------------------------------*/
+		/* The server can have been made ready by something other than a
+		release, in which case it is handled as a server that is running. */
+		if( ( pxServer->xWaiting != pdFALSE ) &&
+			( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( pxTCB->xStateListItem ) ) == pdFALSE ) &&
+			( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL ) )
+		{
+			pxServer->xWaiting = pdFALSE;
+			pxTCB->xTaskReleaseTime = pxJob->xReleaseTime;
+			pxTCB->xTaskRelativeDeadline = pxJob->xRelativeDeadline;
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+			{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+			}
+			else
+			{
+				/* The delayed or ready lists cannot be accessed so the server
+				is held in the pending ready list until the scheduler is
+				unsuspended. */
+				vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+			}
 
-	UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
-	{
-	TCB_t *pxTCB;
-	uint8_t *pucEndOfStack;
-	UBaseType_t uxReturn;
+			if( taskUNBLOCKED_TASK_PREEMPTS( pxTCB ) != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( taskEDF_DEADLINE_BEFORE( listGET_LIST_ITEM_VALUE( &( pxJob->xJobListItem ) ), taskEDF_DEADLINE_KEY( taskEDF_ABSOLUTE_DEADLINE( pxTCB ) ) ) )
+		{
+			pxTCB->xTaskReleaseTime = pxJob->xReleaseTime;
+			pxTCB->xTaskRelativeDeadline = pxJob->xRelativeDeadline;
 
-		pxTCB = prvGetTCBFromHandle( xTask );
+			if( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+			{
+				prvReadyHeapRemove( pxTCB );
+				listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), taskEDF_READY_DEADLINE( pxTCB ) );
+				prvReadyHeapInsert( pxTCB );
 
-		#if portSTACK_GROWTH < 0
-		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+				if( ( pxTCB != pxCurrentTCB ) && ( taskEDF_PREEMPTS_CURRENT( pxTCB ) != pdFALSE ) )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* A job blocked the server, which gets the deadline when it is
+				made ready. */
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-		#else
+		else
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif
 
-		uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
-
-		return uxReturn;
+		return xSwitchRequired;
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_vTaskDelete == 1 )
-
-	static void prvDeleteTCB( TCB_t *pxTCB )
+	static JobServer_t *prvFindJobServer( const TickType_t xRelativeDeadline )
 	{
-		/* This call is required specifically for the TriCore port.  It must be
-		above the vPortFree() calls.  The call is also used by ports/demos that
-		want to allocate and clean RAM statically. */
-		portCLEAN_UP_TCB( pxTCB );
-
-		/* Free up the memory allocated by the scheduler for the task.  It is up
-		to the task to free any memory allocated at the application level.
-		See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-		for additional information. */
-		#if ( configUSE_NEWLIB_REENTRANT == 1 )
-		{
-			_reclaim_reent( &( pxTCB->xNewLib_reent ) );
-		}
-		#endif /* configUSE_NEWLIB_REENTRANT */
+	JobServer_t *pxServer = NULL;
+	UBaseType_t uxServer;
 
-		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
-		{
-			/* The task can only have been allocated dynamically - free both
-			the stack and TCB. */
-			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
-		}
-		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+		/* There are a few servers at most, one for each preemption level that
+		has jobs of its own. */
+		for( uxServer = ( UBaseType_t ) 0U; uxServer < uxJobServers; uxServer++ )
 		{
-			/* The task could have been allocated statically or dynamically, so
-			check what was statically allocated before trying to free the
-			memory. */
-			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
-			{
-				/* Both the stack and TCB were allocated dynamically, so both
-				must be freed. */
-				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
-			}
-			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+			if( xJobServers[ uxServer ].xRelativeDeadline == xRelativeDeadline )
 			{
-				/* Only the stack was statically allocated, so the TCB is the
-				only memory that must be freed. */
-				vPortFree( pxTCB );
+				pxServer = &( xJobServers[ uxServer ] );
+				break;
 			}
 			else
 			{
-				/* Neither the stack nor the TCB were allocated dynamically, so
-				nothing needs to be freed. */
-				configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB	);
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+		return pxServer;
 	}
+	/*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_vTaskDelete */
-/*-----------------------------------------------------------*/
+	static BaseType_t prvIsJobServer( const TCB_t * const pxTCB )
+	{
+	BaseType_t xReturn = pdFALSE;
+	UBaseType_t uxServer;
 
-static void prvResetNextTaskUnblockTime( void )
-{
-TCB_t *pxTCB;
+		for( uxServer = ( UBaseType_t ) 0U; uxServer < uxJobServers; uxServer++ )
+		{
+			if( xJobServers[ uxServer ].pxTCB == pxTCB )
+			{
+				xReturn = pdTRUE;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
-		xNextTaskUnblockTime = portMAX_DELAY;
-	}
-	else
-	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
-		which the task at the head of the delayed list should be removed
-		from the Blocked state. */
-		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+		return xReturn;
 	}
-}
+
+#endif /* configUSE_EDF_JOBS */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -4241,7 +8773,79 @@ TCB_t *pxTCB;
 #endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxMutexHolderTCB = pxMutexHolder;
+	const TickType_t xWaiterDeadline = taskEDF_READY_DEADLINE( pxCurrentTCB );
+	BaseType_t xReturn = pdFALSE;
+
+		if( pxMutexHolder != NULL )
+		{
+			/* All the tasks have the same priority under EDF, so the holder of
+			the mutex inherits the deadline rather than the priority of the task
+			attempting to obtain the mutex.  Otherwise any task with a deadline
+			between the two could preempt the holder and keep the waiting task
+			blocked for as long as it runs. */
+			if( taskEDF_DEADLINE_BEFORE( xWaiterDeadline, taskEDF_READY_DEADLINE( pxMutexHolderTCB ) ) )
+			{
+				pxMutexHolderTCB->xInheritedDeadline = xWaiterDeadline;
+
+				/* Only reset the event list item value if the value is not
+				being used for anything else. */
+				if( taskEVENT_LIST_ITEM_IS_FREE( pxMutexHolderTCB ) )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), taskEVENT_LIST_ITEM_KEY( pxMutexHolderTCB ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* If the holder is ready it has to be moved up the ready heap.
+				Otherwise it is scheduled by the inherited deadline once it is
+				next made ready. */
+				if( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+				{
+					prvReadyHeapRemove( pxMutexHolderTCB );
+					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xStateListItem ), xWaiterDeadline );
+					prvReadyHeapInsert( pxMutexHolderTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+
+				/* Inheritance occurred. */
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				if( taskEDF_DEADLINE_BEFORE( xWaiterDeadline, taskEDF_JOB_DEADLINE( pxMutexHolderTCB ) ) )
+				{
+					/* The mutex holder already inherited a deadline at least as
+					early as the deadline of the task attempting to take the
+					mutex. */
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#elif ( configUSE_MUTEXES == 1 )
 
 	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
 	{
@@ -4261,7 +8865,7 @@ TCB_t *pxTCB;
 				/* Adjust the mutex holder state to account for its new
 				priority.  Only reset the event list item value if the value is
 				not being used for anything else. */
-				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				if( taskEVENT_LIST_ITEM_IS_FREE( pxMutexHolderTCB ) )
 				{
 					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 				}
@@ -4348,9 +8952,9 @@ TCB_t *pxTCB;
 			configASSERT( pxTCB->uxMutexesHeld );
 			( pxTCB->uxMutexesHeld )--;
 
-			/* Has the holder of the mutex inherited the priority of another
-			task? */
-			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			/* Has the holder of the mutex inherited the priority or the
+			deadline of another task? */
+			if( ( pxTCB->uxPriority != pxTCB->uxBasePriority ) || ( taskEDF_HAS_INHERITED_DEADLINE( pxTCB ) != pdFALSE ) )
 			{
 				/* Only disinherit if no other mutexes are held. */
 				if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
@@ -4360,6 +8964,7 @@ TCB_t *pxTCB;
 					given from an interrupt, and if a mutex is given by the
 					holding task then it must be the running state task.  Remove
 					the holding task from the ready/delayed list. */
+					taskREMOVE_FROM_READY_HEAP( pxTCB );
 					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 					{
 						taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -4374,10 +8979,17 @@ TCB_t *pxTCB;
 					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
 					pxTCB->uxPriority = pxTCB->uxBasePriority;
 
+					#if ( configUSE_EDF_SCHEDULER == 1 )
+					{
+						/* Go back to the deadline of the task's own job. */
+						pxTCB->xInheritedDeadline = taskEDF_NO_INHERITED_DEADLINE;
+					}
+					#endif
+
 					/* Reset the event list item value.  It cannot be in use for
 					any other purpose if this task is running, and it must be
 					running to give back the mutex. */
-					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), taskEVENT_LIST_ITEM_KEY( pxTCB ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 					prvAddTaskToReadyList( pxTCB );
 
 					/* Return true to indicate that a context switch is required.
@@ -4411,7 +9023,103 @@ TCB_t *pxTCB;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+	void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask )
+	{
+	TCB_t * const pxTCB = pxMutexHolder;
+	TickType_t xDeadlineToUse;
+	const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+
+		if( pxMutexHolder != NULL )
+		{
+			/* If pxMutexHolder is not NULL then the holder must hold at least
+			one mutex. */
+			configASSERT( pxTCB->uxMutexesHeld );
+
+			/* The waiting list of the mutex is in deadline order under EDF, so
+			uxHighestPriorityWaitingTask is configMAX_PRIORITIES less the key of
+			the first task still waiting, or tskIDLE_PRIORITY if none is, see
+			taskEVENT_LIST_ITEM_KEY().  The holder keeps that deadline if it is
+			earlier than the deadline of its own job, otherwise it goes back to
+			its own deadline.  The priority is never changed. */
+			if( uxHighestPriorityWaitingTask != tskIDLE_PRIORITY )
+			{
+				xDeadlineToUse = ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxHighestPriorityWaitingTask;
+
+				if( taskEDF_DEADLINE_BEFORE( xDeadlineToUse, taskEDF_JOB_DEADLINE( pxTCB ) ) == pdFALSE )
+				{
+					xDeadlineToUse = taskEDF_NO_INHERITED_DEADLINE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				xDeadlineToUse = taskEDF_NO_INHERITED_DEADLINE;
+			}
+
+			/* Does the inherited deadline need to change? */
+			if( pxTCB->xInheritedDeadline != xDeadlineToUse )
+			{
+				/* Only disinherit if no other mutexes are held, as for the
+				priority.  A deadline inherited through another mutex is kept
+				until the mutex is given back, which can only make the holder
+				run earlier than it needs to, never later. */
+				if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
+				{
+					/* If a task has timed out because it already holds the
+					mutex it was trying to obtain then it cannot of inherited
+					its own deadline. */
+					configASSERT( pxTCB != pxCurrentTCB );
+
+					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
+					pxTCB->xInheritedDeadline = xDeadlineToUse;
+
+					/* Only reset the event list item value if the value is not
+					being used for anything else. */
+					if( taskEVENT_LIST_ITEM_IS_FREE( pxTCB ) )
+					{
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), taskEVENT_LIST_ITEM_KEY( pxTCB ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* If the holder is ready it has to be moved in the ready
+					heap.  Otherwise it is scheduled by the new deadline once it
+					is next made ready. */
+					if( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					{
+						prvReadyHeapRemove( pxTCB );
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), taskEDF_READY_DEADLINE( pxTCB ) );
+						prvReadyHeapInsert( pxTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#elif ( configUSE_MUTEXES == 1 )
 
 	void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask )
 	{
@@ -4461,9 +9169,9 @@ TCB_t *pxTCB;
 
 					/* Only reset the event list item value if the value is not
 					being used for anything else. */
-					if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+					if( taskEVENT_LIST_ITEM_IS_FREE( pxTCB ) )
 					{
-						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), taskEVENT_LIST_ITEM_KEY( pxTCB ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 					}
 					else
 					{
@@ -4840,7 +9548,12 @@ TickType_t uxReturn;
 
 	/* Reset the event list item to its normal value - so it can be used with
 	queues and semaphores. */
-	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+	#if ( configUSE_EDF_SCHEDULER == 1 )
+	{
+		pxCurrentTCB->ucEventListItemInUse = ( uint8_t ) pdFALSE;
+	}
+	#endif
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), taskEVENT_LIST_ITEM_KEY( pxCurrentTCB ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 	return uxReturn;
 }
@@ -5101,7 +9814,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskUNBLOCKED_TASK_PREEMPTS( pxTCB ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5226,7 +9939,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskUNBLOCKED_TASK_PREEMPTS( pxTCB ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5314,7 +10027,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskUNBLOCKED_TASK_PREEMPTS( pxTCB ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5423,6 +10136,7 @@ const TickType_t xConstTickCount = xTickCount;
 
 	/* Remove the task from the ready list before adding it to the blocked list
 	as the same list item is used for both lists. */
+	taskREMOVE_FROM_READY_HEAP( pxCurrentTCB );
 	if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 	{
 		/* The current task must be in a ready list, so there is no need to
@@ -5453,30 +10167,39 @@ const TickType_t xConstTickCount = xTickCount;
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-			if( xTimeToWake < xConstTickCount )
+			#if ( configUSE_TIMING_WHEEL == 1 )
 			{
-				/* Wake time has overflowed.  Place this item in the overflow
-				list. */
-				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				/* The wheel has processed the current tick already. */
+				prvTimingWheelInsert( &( pxCurrentTCB->xStateListItem ), xConstTickCount + ( TickType_t ) 1U );
 			}
-			else
+			#else
 			{
-				/* The wake time has not overflowed, so the current block list
-				is used. */
-				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-				/* If the task entering the blocked state was placed at the
-				head of the list of blocked tasks then xNextTaskUnblockTime
-				needs to be updated too. */
-				if( xTimeToWake < xNextTaskUnblockTime )
+				if( xTimeToWake < xConstTickCount )
 				{
-					xNextTaskUnblockTime = xTimeToWake;
+					/* Wake time has overflowed.  Place this item in the overflow
+					list. */
+					vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 				}
 				else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* The wake time has not overflowed, so the current block list
+					is used. */
+					vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+					/* If the task entering the blocked state was placed at the
+					head of the list of blocked tasks then xNextTaskUnblockTime
+					needs to be updated too. */
+					if( xTimeToWake < xNextTaskUnblockTime )
+					{
+						xNextTaskUnblockTime = xTimeToWake;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 			}
+			#endif /* configUSE_TIMING_WHEEL */
 		}
 	}
 	#else /* INCLUDE_vTaskSuspend */
@@ -5489,28 +10212,37 @@ const TickType_t xConstTickCount = xTickCount;
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-		if( xTimeToWake < xConstTickCount )
+		#if ( configUSE_TIMING_WHEEL == 1 )
 		{
-			/* Wake time has overflowed.  Place this item in the overflow list. */
-			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			/* The wheel has processed the current tick already. */
+			prvTimingWheelInsert( &( pxCurrentTCB->xStateListItem ), xConstTickCount + ( TickType_t ) 1U );
 		}
-		else
+		#else
 		{
-			/* The wake time has not overflowed, so the current block list is used. */
-			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-			/* If the task entering the blocked state was placed at the head of the
-			list of blocked tasks then xNextTaskUnblockTime needs to be updated
-			too. */
-			if( xTimeToWake < xNextTaskUnblockTime )
+			if( xTimeToWake < xConstTickCount )
 			{
-				xNextTaskUnblockTime = xTimeToWake;
+				/* Wake time has overflowed.  Place this item in the overflow list. */
+				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				/* The wake time has not overflowed, so the current block list is used. */
+				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+				/* If the task entering the blocked state was placed at the head of the
+				list of blocked tasks then xNextTaskUnblockTime needs to be updated
+				too. */
+				if( xTimeToWake < xNextTaskUnblockTime )
+				{
+					xNextTaskUnblockTime = xTimeToWake;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
+		#endif /* configUSE_TIMING_WHEEL */
 
 		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
 		( void ) xCanBlockIndefinitely;